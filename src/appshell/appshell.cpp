@@ -208,6 +208,14 @@ int AppShell::run(int argc, char** argv)
     // Engine quit
     ui::UiEngine::instance()->quit();
 
+    if (!commandLine.layoutTraceFile().isEmpty()) {
+        LOGI() << layoutProfiler()->summary();
+        Ret ret = layoutProfiler()->writeTrace(commandLine.layoutTraceFile());
+        if (!ret) {
+            LOGE() << "failed write layout trace: " << commandLine.layoutTraceFile();
+        }
+    }
+
     // Deinit
     for (mu::framework::IModuleSetup* m : m_modules) {
         m->onDeinit();
@@ -224,7 +232,12 @@ int AppShell::processConverter(const CommandLineController::ConverterTask& task)
 {
     Ret ret;
     if (task.isBatchMode) {
-        ret = converter()->batchConvert(task.inputFile);
+        converter::IConverterController::BatchOptions options;
+        options.parallelJobs = task.parallelJobs;
+        options.summaryFile = task.summaryFile;
+        options.workerArguments = task.workerArguments;
+
+        ret = converter()->batchConvert(task.inputFile, options);
         if (!ret) {
             LOGE() << "failed batch convert, error: " << ret.toString();
         }
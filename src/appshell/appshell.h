@@ -29,6 +29,7 @@
 #include "modularity/ioc.h"
 #include "global/iapplication.h"
 #include "converter/iconvertercontroller.h"
+#include "notation/ilayoutprofiler.h"
 
 #include "commandlinecontroller.h"
 
@@ -37,6 +38,7 @@ class AppShell
 {
     INJECT(appshell, framework::IApplication, muapplication)
     INJECT(appshell, converter::IConverterController, converter)
+    INJECT(appshell, notation::ILayoutProfiler, layoutProfiler)
 
 public:
     AppShell();
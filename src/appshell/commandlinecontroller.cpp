@@ -21,6 +21,10 @@
  */
 #include "commandlinecontroller.h"
 
+#include <algorithm>
+
+#include <QHash>
+
 #include "log.h"
 
 using namespace mu::appshell;
@@ -34,14 +38,17 @@ void CommandLineController::parse(const QStringList& args)
 
     m_parser.addPositionalArgument("scorefiles", "The files to open", "[scorefile...]");
 
-    m_parser.addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
+    addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
+    addOption(QCommandLineOption("layout-trace", "Profile score layout and write a Chrome trace to 'file' on exit", "file"));
 
     // Converter mode
-    m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
-    m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
-    m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
-    m_parser.addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
-    m_parser.addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
+    addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
+    addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
+    addOption(QCommandLineOption("parallel-jobs", "Run up to N jobs of the conversion job in parallel", "N"));
+    addOption(QCommandLineOption("job-summary", "Write a json summary of the conversion job to 'file'", "file"));
+    addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    addOption(QCommandLineOption({ "F", "factory-settings" }, "Use factory settings"));
+    addOption(QCommandLineOption({ "R", "revert-settings" }, "Revert to factory settings, but keep default preferences"));
 
     m_parser.process(args);
 }
@@ -70,6 +77,11 @@ void CommandLineController::apply()
         }
     }
 
+    if (m_parser.isSet("layout-trace")) {
+        m_layoutTraceFile = m_parser.value("layout-trace");
+        layoutProfiler()->setEnabled(true);
+    }
+
     // Converter mode
     if (m_parser.isSet("r")) {
         std::optional<float> val = floatValue("r");
@@ -97,6 +109,19 @@ void CommandLineController::apply()
         application()->setRunMode(IApplication::RunMode::Converter);
         m_converterTask.isBatchMode = true;
         m_converterTask.inputFile = m_parser.value("j");
+
+        if (m_parser.isSet("parallel-jobs")) {
+            bool ok = false;
+            int val = m_parser.value("parallel-jobs").toInt(&ok);
+            if (ok && val > 0) {
+                m_converterTask.parallelJobs = val;
+            } else {
+                LOGE() << "Option: --parallel-jobs not recognized value: " << m_parser.value("parallel-jobs");
+            }
+        }
+
+        m_converterTask.summaryFile = m_parser.value("job-summary");
+        m_converterTask.workerArguments = workerArguments();
     }
 
     if (m_parser.isSet("F") || m_parser.isSet("R")) {
@@ -104,7 +129,43 @@ void CommandLineController::apply()
     }
 }
 
+void CommandLineController::addOption(const QCommandLineOption& option)
+{
+    m_parser.addOption(option);
+    m_options.append(option);
+}
+
+QStringList CommandLineController::workerArguments() const
+{
+    //! NOTE The options of the batch itself, a worker process gets a job file with its one job instead
+    static const QStringList BATCH_OPTIONS = { "j", "parallel-jobs", "job-summary", "o" };
+
+    QStringList args;
+    QHash<QString, int> valueIndexes;
+    for (const QString& name : m_parser.optionNames()) {
+        auto option = std::find_if(m_options.cbegin(), m_options.cend(), [&name](const QCommandLineOption& o) {
+            return o.names().contains(name);
+        });
+        if (option == m_options.cend() || BATCH_OPTIONS.contains(option->names().first())) {
+            continue;
+        }
+
+        args << (name.size() == 1 ? "-" : "--") + name;
+        if (!option->valueName().isEmpty()) {
+            // the values of an option in the order it was given, whichever of its names was used
+            int& valueIdx = valueIndexes[option->names().first()];
+            args << m_parser.values(name).value(valueIdx++);
+        }
+    }
+    return args;
+}
+
 CommandLineController::ConverterTask CommandLineController::converterTask() const
 {
     return m_converterTask;
 }
+
+QString CommandLineController::layoutTraceFile() const
+{
+    return m_layoutTraceFile;
+}
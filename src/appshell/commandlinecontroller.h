@@ -29,6 +29,7 @@
 #include "global/iapplication.h"
 #include "ui/iuiconfiguration.h"
 #include "importexport/imagesexport/iimagesexportconfiguration.h"
+#include "notation/ilayoutprofiler.h"
 #include "iappshellconfiguration.h"
 
 namespace mu::appshell {
@@ -38,6 +39,7 @@ class CommandLineController
     INJECT(appshell, ui::IUiConfiguration, uiConfiguration)
     INJECT(appshell, iex::imagesexport::IImagesExportConfiguration, imagesExportConfiguration)
     INJECT(appshell, IAppShellConfiguration, configuration)
+    INJECT(appshell, notation::ILayoutProfiler, layoutProfiler)
 
 public:
     CommandLineController() = default;
@@ -46,17 +48,25 @@ public:
         bool isBatchMode = false;
         QString inputFile;
         QString outputFile;
+        int parallelJobs = 1;
+        QString summaryFile;
+        QStringList workerArguments;
     };
 
     void parse(const QStringList& args);
     void apply();
 
     ConverterTask converterTask() const;
+    QString layoutTraceFile() const;
 
 private:
+    void addOption(const QCommandLineOption& option);
+    QStringList workerArguments() const;
 
     QCommandLineParser m_parser;
+    QList<QCommandLineOption> m_options;
     ConverterTask m_converterTask;
+    QString m_layoutTraceFile;
 };
 }
 
@@ -36,9 +36,13 @@ enum class Err {
     ConvertTypeUnknown = 1310,
 
     InFileFailedLoad = 1320,
+    InFileHasNoParts = 1321,
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    ConvertProcessFailed = 1340,
+    ConvertProcessCrashed = 1341,
 };
 
 inline Ret make_ret(Err e)
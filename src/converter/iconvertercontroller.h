@@ -22,6 +22,8 @@
 #ifndef MU_CONVERTER_ICONVERTERCONTROLLER_H
 #define MU_CONVERTER_ICONVERTERCONTROLLER_H
 
+#include <QStringList>
+
 #include "modularity/imoduleexport.h"
 #include "ret.h"
 #include "io/path.h"
@@ -33,8 +35,14 @@ class IConverterController : MODULE_EXPORT_INTERFACE
 public:
     virtual ~IConverterController() = default;
 
+    struct BatchOptions {
+        int parallelJobs = 1;   // more than one - the jobs are run by worker processes
+        io::path summaryFile;   // json summary of the batch, not written if empty
+        QStringList workerArguments;    // converter options of this process, passed on to the worker processes
+    };
+
     virtual Ret fileConvert(const io::path& in, const io::path& out) = 0;
-    virtual Ret batchConvert(const io::path& batchJobFile) = 0;
+    virtual Ret batchConvert(const io::path& batchJobFile, const BatchOptions& options = BatchOptions()) = 0;
 };
 }
 
@@ -21,19 +21,31 @@
  */
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <functional>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QTemporaryFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QRegularExpression>
 
 #include "log.h"
 #include "convertercodes.h"
+#include "runtime.h"
 #include "stringutils.h"
 
 using namespace mu::converter;
 
-mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
+mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const BatchOptions& options)
 {
     RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
     if (!batchJob.ret) {
@@ -41,45 +53,324 @@ mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
         return batchJob.ret;
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
+    int parallelJobs = std::max(1, options.parallelJobs);
+    BatchJob parallelBatchJob;
+    std::vector<JobResult> results;
+    if (parallelJobs > 1) {
+        parallelBatchJob = splitPartsJobs(batchJob.val, parallelJobs);
+        results = runParallel(parallelBatchJob, parallelJobs, options.workerArguments);
+    } else {
+        results = runSequential(batchJob.val);
+    }
+
+    int64_t wallTimeMs = timer.elapsed();
+
     Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out);
-        if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+    size_t failed = 0;
+    for (const JobResult& result : results) {
+        if (!result.ret) {
+            LOGE() << "failed convert, err: " << result.ret.toString() << ", in: " << result.job->in;
+            if (ret) {
+                ret = result.ret;
+            }
+            ++failed;
+        }
+    }
+
+    LOGI() << "batch done, jobs: " << results.size() << ", failed: " << failed << ", wall time: " << wallTimeMs << "ms";
+
+    if (!options.summaryFile.empty()) {
+        Ret summaryRet = writeSummary(options.summaryFile, results, parallelJobs, wallTimeMs);
+        if (!summaryRet) {
+            LOGE() << "failed write summary, err: " << summaryRet.toString() << ", path: " << options.summaryFile;
         }
     }
 
     return ret;
 }
 
+ConverterController::BatchJob ConverterController::splitPartsJobs(const BatchJob& batchJob, int parallelJobs) const
+{
+    //! NOTE The parts of a score are written by several worker processes, each one loads the score
+    //! and writes a slice of its parts. The parts can't be laid out by threads of one process:
+    //! layout pushes undo commands to the undo stack of the master score, changes elements linked
+    //! between the master score and its parts, and fills lazy caches (score fonts, text layouts)
+    //! that aren't synchronized.
+    BatchJob jobs;
+    for (const Job& job : batchJob) {
+        if (job.partsOut.empty()) {
+            jobs.push_back(job);
+            continue;
+        }
+
+        if (!job.out.empty()) {
+            Job scoreJob = job;
+            scoreJob.partsOut.clear();
+            jobs.push_back(scoreJob);
+        }
+
+        for (int slice = 0; slice < parallelJobs; ++slice) {
+            Job partsJob = job;
+            partsJob.out.clear();
+            partsJob.partsSlice = slice;
+            partsJob.partsSlices = parallelJobs;
+            jobs.push_back(partsJob);
+        }
+    }
+
+    return jobs;
+}
+
+std::vector<ConverterController::JobResult> ConverterController::runSequential(const BatchJob& batchJob)
+{
+    std::vector<JobResult> results;
+
+    for (const Job& job : batchJob) {
+        QElapsedTimer timer;
+        timer.start();
+
+        JobResult result;
+        result.job = &job;
+        result.ret = convertJob(job);
+        result.durationMs = timer.elapsed();
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+//! NOTE Worker processes can't share one layout trace, each one writes its own, e.g. trace.job3.json
+static QStringList jobWorkerArguments(const QStringList& workerArguments, size_t jobIdx)
+{
+    QStringList args = workerArguments;
+    for (int i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == "--layout-trace") {
+            QFileInfo trace(args[i + 1]);
+            QString name = trace.completeBaseName() + ".job" + QString::number(jobIdx);
+            if (!trace.suffix().isEmpty()) {
+                name += "." + trace.suffix();
+            }
+            args[i + 1] = trace.dir().filePath(name);
+        }
+    }
+    return args;
+}
+
+std::vector<ConverterController::JobResult> ConverterController::runParallel(const BatchJob& batchJob, int parallelJobs,
+                                                                             const QStringList& workerArguments)
+{
+    //! NOTE Each job is converted by a child process, which gets a job file with this one job.
+    //! libmscore keeps global state (style defaults, font caches, MScore statics), so scores can't be
+    //! loaded and laid out by threads of one process, and a crash of one job doesn't stop the others.
+    std::vector<JobResult> results(batchJob.size());
+
+    std::vector<const Job*> jobs;
+    for (const Job& job : batchJob) {
+        jobs.push_back(&job);
+    }
+
+    QString program = QCoreApplication::applicationFilePath();
+    QEventLoop loop;
+    size_t nextJob = 0;
+    size_t runningJobs = 0;
+
+    std::function<void()> startJobs;
+
+    auto finishJob = [&](QProcess* process, size_t idx, const QElapsedTimer& timer, Ret ret) {
+        results[idx].durationMs = timer.elapsed();
+        results[idx].ret = ret;
+        LOGI() << "finished: " << jobs[idx]->in << ", " << results[idx].durationMs << "ms";
+
+        process->deleteLater();
+        --runningJobs;
+
+        startJobs();
+        if (runningJobs == 0) {
+            loop.quit();
+        }
+    };
+
+    startJobs = [&]() {
+        while (runningJobs < static_cast<size_t>(parallelJobs) && nextJob < jobs.size()) {
+            size_t idx = nextJob++;
+            results[idx].job = jobs[idx];
+
+            QTemporaryFile* jobFile = new QTemporaryFile();
+            if (!jobFile->open()) {
+                delete jobFile;
+                results[idx].ret = make_ret(Err::BatchJobFileFailedOpen);
+                continue;
+            }
+            jobFile->write(QJsonDocument(QJsonArray { jobToJson(*jobs[idx]) }).toJson());
+            jobFile->close();
+
+            QProcess* process = new QProcess();
+            jobFile->setParent(process);
+            process->setProcessChannelMode(QProcess::ForwardedChannels);
+
+            auto timer = std::make_shared<QElapsedTimer>();
+            timer->start();
+
+            QObject::connect(process, qOverload<int, QProcess::ExitStatus>(&QProcess::finished),
+                             [&, process, idx, timer](int exitCode, QProcess::ExitStatus exitStatus) {
+                Ret ret = make_ret(Ret::Code::Ok);
+                if (exitStatus != QProcess::NormalExit) {
+                    ret = make_ret(Err::ConvertProcessCrashed);
+                } else if (exitCode != 0) {
+                    ret = make_ret(Err::ConvertProcessFailed, "exit code: " + std::to_string(exitCode));
+                }
+                finishJob(process, idx, *timer, ret);
+            });
+
+            QObject::connect(process, &QProcess::errorOccurred, [&, process, idx, timer](QProcess::ProcessError error) {
+                if (error == QProcess::FailedToStart) {
+                    finishJob(process, idx, *timer, make_ret(Err::ConvertProcessFailed, "failed to start"));
+                }
+            });
+
+            ++runningJobs;
+            process->start(program, jobWorkerArguments(workerArguments, idx) << "-j" << jobFile->fileName());
+        }
+    };
+
+    startJobs();
+    if (runningJobs > 0) {
+        loop.exec();
+    }
+
+    return results;
+}
+
+mu::Ret ConverterController::writeSummary(const io::path& summaryFile, const std::vector<JobResult>& results, int parallelJobs,
+                                          int64_t wallTimeMs) const
+{
+    QJsonArray jobs;
+    int failed = 0;
+    for (const JobResult& result : results) {
+        QJsonObject obj = jobToJson(*result.job);
+        obj["ok"] = result.ret.success();
+        obj["durationMs"] = static_cast<qint64>(result.durationMs);
+        if (!result.ret) {
+            obj["error"] = QString::fromStdString(result.ret.toString());
+            ++failed;
+        }
+        jobs.append(obj);
+    }
+
+    QJsonObject summary;
+    summary["parallelJobs"] = parallelJobs;
+    summary["wallTimeMs"] = static_cast<qint64>(wallTimeMs);
+    summary["peakRssKb"] = static_cast<qint64>(runtime::peakRssKb(true));
+    summary["succeeded"] = static_cast<int>(results.size()) - failed;
+    summary["failed"] = failed;
+    summary["jobs"] = jobs;
+
+    QFile file(summaryFile.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::OutFileFailedOpen);
+    }
+
+    file.write(QJsonDocument(summary).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out)
+{
+    Job job;
+    job.in = in;
+    job.out.push_back(out);
+
+    return convertJob(job);
+}
+
+mu::Ret ConverterController::convertJob(const Job& job)
 {
     TRACEFUNC;
-    LOGI() << "in: " << in << ", out: " << out;
+    LOGI() << "in: " << job.in << ", outputs: " << job.out.size() << ", parts outputs: " << job.partsOut.size();
+
+    //! NOTE Check the output types before the score is loaded
+    std::vector<io::path> outs = job.out;
+    for (const PartsOut& partsOut : job.partsOut) {
+        outs.push_back(partsOut.prefix + "part" + partsOut.suffix);
+    }
+    for (const io::path& out : outs) {
+        std::string suffix = io::syffix(out);
+        if (!writers()->writer(suffix)) {
+            LOGE() << "unknown convert type: " << suffix << ", path: " << out;
+            return make_ret(Err::ConvertTypeUnknown);
+        }
+    }
+
     auto masterNotation = notationCreator()->newMasterNotation();
     IF_ASSERT_FAILED(masterNotation) {
         return make_ret(Err::UnknownError);
     }
 
+    Ret ret = masterNotation->load(job.in);
+    if (!ret) {
+        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << job.in;
+        return make_ret(Err::InFileFailedLoad);
+    }
+
+    //! NOTE A failed output doesn't stop the others, the first error is returned
+    Ret result = make_ret(Ret::Code::Ok);
+    auto write = [this, &result](notation::INotationPtr notation, const io::path& out) {
+        Ret ret = writeNotation(notation, out);
+        if (!ret && result) {
+            result = ret;
+        }
+    };
+
+    for (const io::path& out : job.out) {
+        write(masterNotation->notation(), out);
+    }
+
+    if (!job.partsOut.empty()) {
+        const notation::ExcerptNotationList excerpts = masterNotation->excerpts().val;
+        if (excerpts.empty() && result) {
+            LOGE() << "no parts to convert, path: " << job.in;
+            result = make_ret(Err::InFileHasNoParts);
+        }
+
+        for (size_t i = 0; i < excerpts.size(); ++i) {
+            if (static_cast<int>(i % job.partsSlices) != job.partsSlice) {
+                continue;
+            }
+
+            const notation::IExcerptNotationPtr& excerpt = excerpts[i];
+            QString partName = excerpt->metaInfo().title;
+            partName.replace(QRegularExpression("[\\\\/:*?\"<>|]"), "_");
+
+            for (const PartsOut& partsOut : job.partsOut) {
+                write(excerpt->notation(), partsOut.prefix + partName + partsOut.suffix);
+            }
+        }
+    }
+
+    return result;
+}
+
+mu::Ret ConverterController::writeNotation(notation::INotationPtr notation, const io::path& out)
+{
+    TRACEFUNC;
+    LOGI() << "out: " << out;
+
     std::string suffix = io::syffix(out);
     auto writer = writers()->writer(suffix);
     if (!writer) {
+        LOGE() << "unknown convert type: " << suffix << ", path: " << out;
         return make_ret(Err::ConvertTypeUnknown);
     }
 
-    Ret ret = masterNotation->load(in);
-    if (!ret) {
-        LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
-        return make_ret(Err::InFileFailedLoad);
-    }
-
     QFile file(out.toQString());
     if (!file.open(QFile::WriteOnly)) {
         return make_ret(Err::OutFileFailedOpen);
     }
 
-    ret = writer->write(masterNotation->notation(), file);
+    Ret ret = writer->write(notation, file);
     if (!ret) {
         LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
         return make_ret(Err::OutFileFailedWrite);
@@ -114,9 +405,29 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
 
         Job job;
         job.in = obj["in"].toString();
-        job.out = obj["out"].toString();
 
-        if (!job.in.empty() && !job.out.empty()) {
+        QJsonValue outVal = obj["out"];
+        QJsonArray outArr = outVal.isArray() ? outVal.toArray() : QJsonArray { outVal };
+        for (const QJsonValue out : outArr) {
+            if (out.isArray()) {
+                QJsonArray pair = out.toArray();
+                if (pair.size() == 2) {
+                    job.partsOut.push_back({ pair.at(0).toString(), pair.at(1).toString() });
+                } else {
+                    LOGW() << "parts output must be [prefix, suffix], in: " << job.in;
+                }
+            } else if (!out.toString().isEmpty()) {
+                job.out.push_back(out.toString());
+            }
+        }
+
+        QJsonArray slice = obj["partsSlice"].toArray();
+        if (slice.size() == 2 && slice.at(1).toInt() > 0) {
+            job.partsSlices = slice.at(1).toInt();
+            job.partsSlice = slice.at(0).toInt() % job.partsSlices;
+        }
+
+        if (!job.in.empty() && (!job.out.empty() || !job.partsOut.empty())) {
             rv.val.push_back(std::move(job));
         }
     }
@@ -124,3 +435,23 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     rv.ret = make_ret(Ret::Code::Ok);
     return rv;
 }
+
+QJsonObject ConverterController::jobToJson(const Job& job) const
+{
+    QJsonArray out;
+    for (const io::path& path : job.out) {
+        out.append(path.toQString());
+    }
+
+    for (const PartsOut& partsOut : job.partsOut) {
+        out.append(QJsonArray { partsOut.prefix.toQString(), partsOut.suffix.toQString() });
+    }
+
+    QJsonObject obj;
+    obj["in"] = job.in.toQString();
+    obj["out"] = out;
+    if (job.partsSlices > 1) {
+        obj["partsSlice"] = QJsonArray { job.partsSlice, job.partsSlices };
+    }
+    return obj;
+}
@@ -23,6 +23,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -32,6 +33,8 @@
 
 #include "retval.h"
 
+class QJsonObject;
+
 namespace mu::converter {
 class ConverterController : public IConverterController
 {
@@ -42,18 +45,49 @@ public:
     ConverterController() = default;
 
     Ret fileConvert(const io::path& in, const io::path& out) override;
-    Ret batchConvert(const io::path& batchJobFile) override;
+    Ret batchConvert(const io::path& batchJobFile, const BatchOptions& options = BatchOptions()) override;
 
 private:
 
+    //! NOTE Job format:
+    //! { "in": "score.mscz", "out": "score.pdf" }
+    //! { "in": "score.mscz", "out": [ "score.pdf", "score.mid", [ "score-", ".pdf" ] ] }
+    //! a pair of strings is the prefix and the suffix of the files of the parts (excerpts)
+    //! { "in": "score.mscz", "out": [ [ "score-", ".pdf" ] ], "partsSlice": [ 1, 4 ] }
+    //! the job writes only the parts whose index modulo 4 is 1
+    struct PartsOut {
+        io::path prefix;
+        io::path suffix;
+    };
+
     struct Job {
         io::path in;
-        io::path out;
+        std::vector<io::path> out;
+        std::vector<PartsOut> partsOut;
+        int partsSlice = 0;
+        int partsSlices = 1;
     };
 
     using BatchJob = std::list<Job>;
 
+    struct JobResult {
+        const Job* job = nullptr;
+        Ret ret;
+        int64_t durationMs = 0;
+    };
+
     RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile) const;
+    QJsonObject jobToJson(const Job& job) const;
+
+    //! loads and lays out the score once, then writes all the outputs of the job
+    Ret convertJob(const Job& job);
+    Ret writeNotation(notation::INotationPtr notation, const io::path& out);
+
+    BatchJob splitPartsJobs(const BatchJob& batchJob, int parallelJobs) const;
+    std::vector<JobResult> runSequential(const BatchJob& batchJob);
+    std::vector<JobResult> runParallel(const BatchJob& batchJob, int parallelJobs, const QStringList& workerArguments);
+
+    Ret writeSummary(const io::path& summaryFile, const std::vector<JobResult>& results, int parallelJobs, int64_t wallTimeMs) const;
 };
 }
 
@@ -38,6 +38,7 @@ enum class Err {
     EngineInvalidParameter = 310,
 
     AudioStreamNotPresent = 320,
+    AudioStreamDataNotReceived = 321,
 
     // synth
     SynthNotInited = 331,
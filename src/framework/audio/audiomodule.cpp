@@ -38,6 +38,7 @@
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
 #include "internal/audiobuffer.h"
+#include "internal/offlinerenderer.h"
 
 // synthesizers
 #include "internal/synthesizers/fluidsynth/fluidsynth.h"
@@ -111,6 +112,8 @@ void AudioModule::registerExports()
     ioc()->registerExport<synth::ISynthesizersRegister>(moduleName(), sreg);
     ioc()->registerExport<synth::ISoundFontsProvider>(moduleName(), new synth::SoundFontsProvider());
 
+    ioc()->registerExport<IOfflineRenderer>(moduleName(), new OfflineRenderer());
+
     //! TODO maybe need remove
     ioc()->registerExport<rpc::IRpcChannel>(moduleName(), s_audioWorker->channel());
 }
@@ -167,12 +170,14 @@ void AudioModule::onInit(const framework::IApplication::RunMode&)
     s_rpcSequencer->setup();
     s_audioWorker->channel()->setupMainThread();
     s_audioWorker->setAudioBuffer(s_audioBuffer);
-    s_audioWorker->run([]() {
+    unsigned int mixerRenderThreadCount = s_audioConfiguration->mixerRenderThreadCount();
+    s_audioWorker->run([mixerRenderThreadCount]() {
         AudioSanitizer::setupWorkerThread();
         ONLY_AUDIO_WORKER_THREAD;
 
         AudioEngine::instance()->setAudioBuffer(s_audioBuffer);
         AudioEngine::instance()->init();
+        AudioEngine::instance()->mixer()->setRenderThreadCount(mixerRenderThreadCount);
 
         s_rpcControllers->reg(std::make_shared<rpc::RpcAudioEngineController>());
         s_rpcControllers->reg(std::make_shared<rpc::RpcSequencerController>());
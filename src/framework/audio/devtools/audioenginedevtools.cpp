@@ -253,6 +253,6 @@ void AudioEngineDevTools::makeArpeggio()
         Chunk chunk;
         makeChunk(chunk, tick, pitch);
 
-        m_midiStream->stream.send(chunk);
+        m_midiStream->sendChunk(chunk);
     });
 }
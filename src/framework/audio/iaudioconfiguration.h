@@ -41,6 +41,8 @@ public:
     virtual void setCurrentAudioApi(const std::string& name) = 0;
 
     virtual unsigned int driverBufferSize() const = 0; // samples
+    virtual unsigned int mixerRenderThreadCount() const = 0; // 0 - render mixer channels in the worker thread only
+    virtual unsigned int zerberusSamplePreload() const = 0; // ms of each sample loaded, the rest is streamed; 0 - load whole samples
 
     virtual bool isShowControlsInMixer() const = 0;
     virtual void setIsShowControlsInMixer(bool show) = 0;
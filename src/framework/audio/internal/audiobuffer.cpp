@@ -20,97 +20,106 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "audiobuffer.h"
+#include <algorithm>
 #include <cstring>
 #include "log.h"
 
 using namespace mu::audio;
 
+static unsigned int roundUpToPowerOfTwo(unsigned int value)
+{
+    unsigned int result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
 AudioBuffer::AudioBuffer(unsigned int streamsPerSample, unsigned int size)
     : m_streamsPerSample(streamsPerSample)
 {
-    m_data.resize(size * m_streamsPerSample, 0.f);
+    m_capacity = roundUpToPowerOfTwo(std::max(size, 4 * (FILL_SAMPLES + FILL_OVER)));
+    m_mask = m_capacity - 1;
+    m_data.resize(m_capacity * m_streamsPerSample, 0.f);
+    m_lastBlock.resize(FILL_SAMPLES * m_streamsPerSample, 0.f);
 }
 
 void AudioBuffer::setSource(std::shared_ptr<IAudioSource> source)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     m_source = source;
 }
 
 void AudioBuffer::forward()
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     fillup();
 }
 
 void AudioBuffer::push(const float* source, int sampleCount)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-
-    unsigned int from = m_writeIndex;
-    auto memStep = sizeof(float);
-    auto to = m_writeIndex + sampleCount * m_streamsPerSample;
-    if (to > m_data.size()) {
-        to = m_data.size() - 1;
-    }
-    auto count = to - from;
-    std::memcpy(m_data.data() + m_writeIndex, source, count * memStep);
-    m_writeIndex += count;
-
-    int left = sampleCount * m_streamsPerSample - count;
-    if (left > 0) {
-        std::memcpy(m_data.data(), source + count, left * memStep);
-        m_writeIndex = left;
+    if (sampleCount <= 0) {
+        return;
     }
 
-    if (m_writeIndex >= m_data.size()) {
-        m_writeIndex -= m_data.size();
+    uint64_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    uint64_t readIndex = m_readIndex.load(std::memory_order_acquire);
+
+    unsigned int freeSamples = m_capacity - static_cast<unsigned int>(writeIndex - readIndex);
+    unsigned int count = std::min(static_cast<unsigned int>(sampleCount), freeSamples);
+    if (count < static_cast<unsigned int>(sampleCount)) {
+        m_overrunCount.fetch_add(1, std::memory_order_relaxed);
     }
+
+    copyIn(writeIndex, source, count);
+    m_writeIndex.store(writeIndex + count, std::memory_order_release);
 }
 
 void AudioBuffer::pop(float* dest, unsigned int sampleCount)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    uint64_t readIndex = m_readIndex.load(std::memory_order_relaxed);
+    uint64_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
 
-    //catch up if we are fall behind
-    if (sampleCount > sampleLag()) {
-        //! TODO We have to decide to wait or skip.
-        //! We cannot make a direct call, this is a thread-unsafe.
-        //fillup();
-    }
+    unsigned int available = static_cast<unsigned int>(writeIndex - readIndex);
+    unsigned int count = std::min(sampleCount, available);
 
-    unsigned int from = m_readIndex;
-    auto memStep = sizeof(float);
-    auto to = m_readIndex + sampleCount * m_streamsPerSample;
-    if (to > m_data.size()) {
-        to = m_data.size();
-    }
-    auto count = to - from;
-    std::memcpy(dest, m_data.data() + from, count * memStep);
-    m_readIndex += count;
-
-    int left = sampleCount * m_streamsPerSample - count;
-    if (left > 0) {
-        std::memcpy(dest + count, m_data.data(), left * memStep);
-        m_readIndex = left;
+    copyOut(readIndex, dest, count);
+    m_readIndex.store(readIndex + count, std::memory_order_release);
+
+    bool repeatLastBlock = m_underrunPolicy.load(std::memory_order_relaxed) == UnderrunPolicy::RepeatLastBlock;
+    if (repeatLastBlock && count > 0) {
+        rememberLastBlock(dest, count);
     }
 
-    if (m_readIndex >= m_data.size()) {
-        m_readIndex -= m_data.size();
+    if (count < sampleCount) {
+        //! NOTE We never wait for the worker here and never call fillup() from the driver thread,
+        //! the missing part is produced according to the underrun policy
+        m_underrunCount.fetch_add(1, std::memory_order_relaxed);
+        fillMissing(dest + count * m_streamsPerSample, sampleCount - count);
     }
 }
 
 void AudioBuffer::setMinSampleLag(unsigned int lag)
 {
-    std::lock_guard<std::recursive_mutex> lock(m_mutex);
-
-    IF_ASSERT_FAILED(lag < m_data.size()) {
-        lag = m_data.size();
+    //! NOTE The storage is never resized, the consumer may be reading it right now
+    const unsigned int maxLag = m_capacity - FILL_SAMPLES - FILL_OVER;
+    IF_ASSERT_FAILED(lag <= maxLag) {
+        lag = maxLag;
     }
     m_minSampleLag = lag;
-    if (m_data.size() < 2 * m_minSampleLag * m_streamsPerSample) {
-        m_data.resize(2 * m_minSampleLag * m_streamsPerSample, 0.f);
-    }
+}
+
+void AudioBuffer::setUnderrunPolicy(UnderrunPolicy policy)
+{
+    m_underrunPolicy.store(policy, std::memory_order_relaxed);
+}
+
+uint64_t AudioBuffer::underrunCount() const
+{
+    return m_underrunCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AudioBuffer::overrunCount() const
+{
+    return m_overrunCount.load(std::memory_order_relaxed);
 }
 
 void AudioBuffer::fillup()
@@ -128,12 +137,59 @@ void AudioBuffer::fillup()
 
 unsigned int AudioBuffer::sampleLag() const
 {
-    unsigned int lag = 0;
-    if (m_readIndex <= m_writeIndex) {
-        lag = m_writeIndex - m_readIndex;
-    } else {
-        lag = m_writeIndex + m_data.size() - m_readIndex;
+    uint64_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    uint64_t readIndex = m_readIndex.load(std::memory_order_acquire);
+
+    return static_cast<unsigned int>(writeIndex - readIndex);
+}
+
+void AudioBuffer::copyIn(uint64_t toSample, const float* source, unsigned int sampleCount)
+{
+    unsigned int position = static_cast<unsigned int>(toSample & m_mask);
+    unsigned int first = std::min(sampleCount, m_capacity - position);
+
+    std::memcpy(m_data.data() + position * m_streamsPerSample, source, first * m_streamsPerSample * sizeof(float));
+    if (first < sampleCount) {
+        std::memcpy(m_data.data(), source + first * m_streamsPerSample, (sampleCount - first) * m_streamsPerSample * sizeof(float));
+    }
+}
+
+void AudioBuffer::copyOut(uint64_t fromSample, float* dest, unsigned int sampleCount) const
+{
+    unsigned int position = static_cast<unsigned int>(fromSample & m_mask);
+    unsigned int first = std::min(sampleCount, m_capacity - position);
+
+    std::memcpy(dest, m_data.data() + position * m_streamsPerSample, first * m_streamsPerSample * sizeof(float));
+    if (first < sampleCount) {
+        std::memcpy(dest + first * m_streamsPerSample, m_data.data(), (sampleCount - first) * m_streamsPerSample * sizeof(float));
+    }
+}
+
+void AudioBuffer::rememberLastBlock(const float* block, unsigned int sampleCount)
+{
+    unsigned int maxSamples = static_cast<unsigned int>(m_lastBlock.size()) / m_streamsPerSample;
+    unsigned int count = std::min(sampleCount, maxSamples);
+    const float* tail = block + (sampleCount - count) * m_streamsPerSample;
+
+    std::memcpy(m_lastBlock.data(), tail, count * m_streamsPerSample * sizeof(float));
+    m_lastBlockSamples = count;
+    m_lastBlockPosition = 0;
+}
+
+void AudioBuffer::fillMissing(float* dest, unsigned int sampleCount)
+{
+    bool repeatLastBlock = m_underrunPolicy.load(std::memory_order_relaxed) == UnderrunPolicy::RepeatLastBlock;
+    if (!repeatLastBlock || m_lastBlockSamples == 0) {
+        std::fill(dest, dest + sampleCount * m_streamsPerSample, 0.f);
+        return;
     }
 
-    return lag / m_streamsPerSample;
+    while (sampleCount > 0) {
+        unsigned int count = std::min(sampleCount, m_lastBlockSamples - m_lastBlockPosition);
+        std::memcpy(dest, m_lastBlock.data() + m_lastBlockPosition * m_streamsPerSample, count * m_streamsPerSample * sizeof(float));
+
+        dest += count * m_streamsPerSample;
+        sampleCount -= count;
+        m_lastBlockPosition = (m_lastBlockPosition + count) % m_lastBlockSamples;
+    }
 }
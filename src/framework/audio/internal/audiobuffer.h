@@ -28,11 +28,16 @@
 #include "iaudiobuffer.h"
 
 namespace mu::audio {
+//! Wait-free single-producer/single-consumer ring buffer.
+//! The producer side (setSource, forward, push, setMinSampleLag, setUnderrunPolicy) must be
+//! driven from one thread (the audio worker), pop() from one other thread (the driver callback).
+//! No locks are taken and no memory is allocated after construction.
 class AudioBuffer : public IAudioBuffer
 {
     const static unsigned int DEFAULT_SIZE = 16384;
     const static unsigned int FILL_SAMPLES = 1024;
     const static unsigned int FILL_OVER    = 1024;
+    const static unsigned int CACHE_LINE_SIZE = 64;
 
 public:
     AudioBuffer(unsigned int streamsPerSample = 2, unsigned int size = DEFAULT_SIZE);
@@ -44,18 +49,40 @@ public:
     void pop(float* dest, unsigned int sampleCount) override;
     void setMinSampleLag(unsigned int lag) override;
 
+    void setUnderrunPolicy(UnderrunPolicy policy) override;
+    uint64_t underrunCount() const override;
+    uint64_t overrunCount() const override;
+
 private:
 
     unsigned int sampleLag() const;
     void fillup();
 
-    std::recursive_mutex m_mutex; //! TODO get rid *recursive*
+    void copyIn(uint64_t toSample, const float* source, unsigned int sampleCount);
+    void copyOut(uint64_t fromSample, float* dest, unsigned int sampleCount) const;
+    void fillMissing(float* dest, unsigned int sampleCount);
+    void rememberLastBlock(const float* block, unsigned int sampleCount);
+
+    // read and written indexes are sample (frame) counters that only grow,
+    // the position inside m_data is (index & m_mask) * m_streamsPerSample
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_writeIndex = { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_readIndex = { 0 };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_underrunCount = { 0 };
+    std::atomic<uint64_t> m_overrunCount = { 0 };
+    std::atomic<UnderrunPolicy> m_underrunPolicy = { UnderrunPolicy::FillSilence };
+
     unsigned int m_streamsPerSample = 0;
+    unsigned int m_capacity = 0;
+    uint64_t m_mask = 0;
     unsigned int m_minSampleLag = FILL_SAMPLES;
-    unsigned int m_writeIndex = 0;
-    unsigned int m_readIndex = 0;
     std::vector<float> m_data = {};
     std::shared_ptr<IAudioSource> m_source = nullptr;
+
+    //! consumer only: the tail of the last delivered block, used by UnderrunPolicy::RepeatLastBlock
+    std::vector<float> m_lastBlock = {};
+    unsigned int m_lastBlockSamples = 0;
+    unsigned int m_lastBlockPosition = 0;
 };
 }
 
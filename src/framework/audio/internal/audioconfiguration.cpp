@@ -39,6 +39,8 @@ using namespace mu::audio::synth;
 //TODO: add other setting: audio device etc
 static const Settings::Key AUDIO_API_KEY("audio", "io/audioApi");
 static const Settings::Key AUDIO_BUFFER_SIZE("audio", "driver_buffer");
+static const Settings::Key AUDIO_MIXER_RENDER_THREADS("audio", "mixer/renderThreads");
+static const Settings::Key ZERBERUS_SAMPLE_PRELOAD("audio", "zerberus/samplePreload");
 
 static const Settings::Key USER_SOUNDFONTS_PATH("midi", "application/paths/mySoundfonts");
 
@@ -57,6 +59,8 @@ void AudioConfiguration::init()
     defaultBufferSize = 1024;
 #endif
     settings()->setDefaultValue(AUDIO_BUFFER_SIZE, Val(defaultBufferSize));
+    settings()->setDefaultValue(AUDIO_MIXER_RENDER_THREADS, Val(0));
+    settings()->setDefaultValue(ZERBERUS_SAMPLE_PRELOAD, Val(0));
 
     settings()->setDefaultValue(SHOW_CONTROLS_IN_MIXER, Val(true));
     settings()->setDefaultValue(AUDIO_API_KEY, Val("Core Audio"));
@@ -89,6 +93,16 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+unsigned int AudioConfiguration::mixerRenderThreadCount() const
+{
+    return settings()->value(AUDIO_MIXER_RENDER_THREADS).toInt();
+}
+
+unsigned int AudioConfiguration::zerberusSamplePreload() const
+{
+    return settings()->value(ZERBERUS_SAMPLE_PRELOAD).toInt();
+}
+
 std::vector<io::path> AudioConfiguration::soundFontPaths() const
 {
     std::string pathsStr = settings()->value(USER_SOUNDFONTS_PATH).toString();
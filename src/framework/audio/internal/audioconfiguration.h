@@ -41,6 +41,8 @@ public:
     void setCurrentAudioApi(const std::string& name) override;
 
     unsigned int driverBufferSize() const override;
+    unsigned int mixerRenderThreadCount() const override;
+    unsigned int zerberusSamplePreload() const override;
 
     std::vector<io::path> soundFontPaths() const override;
 
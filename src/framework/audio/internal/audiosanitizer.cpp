@@ -27,6 +27,7 @@ using namespace mu::audio;
 
 static std::thread::id s_as_mainThreadID;
 static std::thread::id s_as_workerThreadID;
+static thread_local bool s_as_isWorkerPoolThread = false;
 
 void AudioSanitizer::setupMainThread()
 {
@@ -50,5 +51,15 @@ std::thread::id AudioSanitizer::workerThread()
 
 bool AudioSanitizer::isWorkerThread()
 {
-    return std::this_thread::get_id() == s_as_workerThreadID;
+    return std::this_thread::get_id() == s_as_workerThreadID || s_as_isWorkerPoolThread;
+}
+
+void AudioSanitizer::setupWorkerPoolThread()
+{
+    s_as_isWorkerPoolThread = true;
+}
+
+void AudioSanitizer::resetWorkerPoolThread()
+{
+    s_as_isWorkerPoolThread = false;
 }
@@ -38,6 +38,11 @@ public:
     static void setupWorkerThread();
     static std::thread::id workerThread();
     static bool isWorkerThread();
+
+    //! threads of the pool that helps the worker, they are treated as the worker
+    static void setupWorkerPoolThread();
+    //! the offline render does the worker's job only for the duration of the render
+    static void resetWorkerPoolThread();
 };
 }
 
@@ -23,6 +23,7 @@
 #define MU_AUDIO_IAUDIOBUFFER_H
 
 #include <memory>
+#include <cstdint>
 #include "iaudiosource.h"
 
 namespace mu::audio {
@@ -31,12 +32,25 @@ class IAudioBuffer
 public:
     virtual ~IAudioBuffer() = default;
 
+    //! What the consumer gets when it asks for more samples than are buffered
+    enum class UnderrunPolicy {
+        FillSilence = 0,
+        RepeatLastBlock
+    };
+
     virtual void setSource(std::shared_ptr<IAudioSource> source) = 0;
     virtual void forward() = 0;
 
     virtual void push(const float* source, int sampleCount) = 0;
     virtual void pop(float* dest, unsigned int sampleCount) = 0;
     virtual void setMinSampleLag(unsigned int lag) = 0;
+
+    virtual void setUnderrunPolicy(UnderrunPolicy policy) = 0;
+
+    //! number of pop() calls that could not be fully served from the buffer
+    virtual uint64_t underrunCount() const = 0;
+    //! number of push() calls that did not fit into the free space of the buffer
+    virtual uint64_t overrunCount() const = 0;
 };
 
 using IAudioBufferPtr = std::shared_ptr<IAudioBuffer>;
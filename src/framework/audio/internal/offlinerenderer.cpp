@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "offlinerenderer.h"
+
+#include <chrono>
+#include <thread>
+
+#include "log.h"
+#include "async/processevents.h"
+#include "audioerrors.h"
+#include "midi/imidiportdatasender.h"
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/midiplayer.h"
+#include "internal/worker/mixer.h"
+#include "internal/synthesizers/synthesizersregister.h"
+#include "internal/synthesizers/fluidsynth/fluidsynth.h"
+#include "internal/synthesizers/zerberus/zerberussynth.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+
+namespace {
+//! How long the render waits for a requested chunk before it gives up
+constexpr int DATA_WAIT_LIMIT_MSEC = 1000;
+
+//! The offline render must not send anything to the midi ports
+class NoMidiPortDataSender : public midi::IMidiPortDataSender
+{
+public:
+    void setMidiStream(std::shared_ptr<midi::MidiStream>) override {}
+    bool sendEvents(midi::tick_t, midi::tick_t) override { return true; }
+    bool sendSingleEvent(const midi::Event&) override { return true; }
+};
+
+//! The render thread does the worker's job for the duration of the render
+struct AuxiliaryWorkerScope {
+    AuxiliaryWorkerScope() { AudioSanitizer::setupWorkerPoolThread(); }
+    ~AuxiliaryWorkerScope() { AudioSanitizer::resetWorkerPoolThread(); }
+};
+}
+
+OfflineRenderer::OfflineRenderer(synth::ISynthesizersRegisterPtr synthesizers)
+    : m_synthesizersRegister(synthesizers), m_isOwnSynthesizers(synthesizers == nullptr)
+{
+}
+
+RetVal<IOfflineRenderer::Stats> OfflineRenderer::render(const std::shared_ptr<midi::MidiStream>& stream, const Options& options,
+                                                        const BlockHandler& onBlock)
+{
+    TRACEFUNC;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    IF_ASSERT_FAILED(onBlock && options.sampleRate > 0 && options.blockSize > 0) {
+        return make_ret(Err::EngineInvalidParameter);
+    }
+
+    if (!stream || !stream->isValid()) {
+        return make_ret(Err::AudioStreamNotPresent);
+    }
+
+    AuxiliaryWorkerScope workerScope;
+
+    initSynthesizers(options.sampleRate);
+
+    //! NOTE If the stream has to be requested, the chunks come in this thread
+    std::shared_ptr<MIDIPlayer> player = std::make_shared<MIDIPlayer>();
+    player->setsynthesizersRegister(m_synthesizersRegister);
+    player->setmidiPortDataSender(std::make_shared<NoMidiPortDataSender>());
+    player->loadMIDI(stream);
+    player->run();
+
+    std::shared_ptr<Mixer> mixer = std::make_shared<Mixer>();
+    mixer->setSampleRate(options.sampleRate);
+    mixer->setBufferSize(options.blockSize);
+    for (const ISynthesizerPtr& synth : m_synthesizersRegister->synthesizers()) {
+        mixer->addChannel(synth);
+    }
+
+    const uint64_t tailSamples = static_cast<uint64_t>(options.tailMsec) * options.sampleRate / 1000;
+    uint64_t tailRendered = 0;
+
+    Stats stats;
+    auto startTime = std::chrono::steady_clock::now();
+    int waitedMSec = 0;
+
+    while (true) {
+        if (player->isRunning()) {
+            //! NOTE The events of the next block are scheduled at their offsets inside it
+            player->forwardSamples(stats.samples + options.blockSize, options.sampleRate);
+
+            //! NOTE The player doesn't move without the requested chunk, the same block is forwarded
+            //! again when the chunk comes, so its events keep their offsets
+            if (player->isWaitingForData()) {
+                if (waitedMSec >= DATA_WAIT_LIMIT_MSEC) {
+                    LOGE() << "the requested chunk is not received in " << DATA_WAIT_LIMIT_MSEC << " ms";
+                    player->stop();
+                    return make_ret(Err::AudioStreamDataNotReceived);
+                }
+
+                async::processEvents();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++waitedMSec;
+                continue;
+            }
+
+            waitedMSec = 0;
+        } else if (tailRendered >= tailSamples) {
+            break;
+        } else {
+            tailRendered += options.blockSize;
+        }
+
+        mixer->forward(options.blockSize);
+        stats.samples += options.blockSize;
+
+        if (!onBlock(mixer->data(), options.blockSize)) {
+            player->stop();
+            return make_ret(Ret::Code::Cancel);
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    stats.audioSeconds = static_cast<double>(stats.samples) / options.sampleRate;
+    stats.renderSeconds = elapsed.count();
+
+    return RetVal<Stats>::make_ok(stats);
+}
+
+void OfflineRenderer::initSynthesizers(unsigned int sampleRate)
+{
+    if (m_synthesizersRegister && (m_sampleRate == sampleRate || !m_isOwnSynthesizers)) {
+        for (const ISynthesizerPtr& synth : m_synthesizersRegister->synthesizers()) {
+            if (m_sampleRate != sampleRate) {
+                synth->setSampleRate(sampleRate);
+            }
+            synth->clearScheduledEvents();
+            synth->allSoundsOff();
+        }
+        m_sampleRate = sampleRate;
+        return;
+    }
+
+    TRACEFUNC;
+
+    m_sampleRate = sampleRate;
+    m_synthesizersRegister = std::make_shared<SynthesizersRegister>();
+    m_synthesizersRegister->registerSynthesizer("Zerberus", std::make_shared<ZerberusSynth>());
+    m_synthesizersRegister->registerSynthesizer("Fluid", std::make_shared<FluidSynth>());
+    m_synthesizersRegister->setDefaultSynthesizer("Fluid");
+
+    for (const ISynthesizerPtr& synth : m_synthesizersRegister->synthesizers()) {
+        //! NOTE The sample rate must be known before init, the synth is created with it
+        synth->setSampleRate(sampleRate);
+        synth->init();
+        synth->addSoundFonts(soundFontsProvider()->soundFontPathsForSynth(synth->name()));
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_OFFLINERENDERER_H
+#define MU_AUDIO_OFFLINERENDERER_H
+
+#include <mutex>
+
+#include "iofflinerenderer.h"
+#include "modularity/ioc.h"
+#include "isoundfontsprovider.h"
+#include "isynthesizersregister.h"
+
+namespace mu::audio {
+class OfflineRenderer : public IOfflineRenderer
+{
+    INJECT(audio, synth::ISoundFontsProvider, soundFontsProvider)
+
+public:
+    //! the synthesizers are made on the first render, if they are not given
+    explicit OfflineRenderer(synth::ISynthesizersRegisterPtr synthesizers = nullptr);
+
+    RetVal<Stats> render(const std::shared_ptr<midi::MidiStream>& stream, const Options& options,
+                         const BlockHandler& onBlock) override;
+
+private:
+    void initSynthesizers(unsigned int sampleRate);
+
+    std::mutex m_mutex;
+
+    //! NOTE Own instances, created on the first render and reused by the next ones,
+    //! loading of sound fonts is too expensive to do it for every file
+    synth::ISynthesizersRegisterPtr m_synthesizersRegister = nullptr;
+    unsigned int m_sampleRate = 0;
+    bool m_isOwnSynthesizers = true;
+};
+}
+
+#endif // MU_AUDIO_OFFLINERENDERER_H
@@ -367,6 +367,18 @@ void FluidSynth::setIsActive(bool arg)
     m_isActive = arg;
 }
 
+void FluidSynth::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    if (!m_scheduledEvents.schedule(e, sampleOffset)) {
+        handleEvent(e);
+    }
+}
+
+void FluidSynth::clearScheduledEvents()
+{
+    m_scheduledEvents.clear();
+}
+
 void FluidSynth::writeBuf(float* stream, unsigned int samples)
 {
     IF_ASSERT_FAILED(samples > 0) {
@@ -385,7 +397,16 @@ unsigned int FluidSynth::streamCount() const
 
 void FluidSynth::forward(unsigned int sampleCount)
 {
-    writeBuf(m_buffer.data(), sampleCount);
+    if (m_scheduledEvents.empty()) {
+        writeBuf(m_buffer.data(), sampleCount);
+        return;
+    }
+
+    m_scheduledEvents.render(sampleCount, [this](const midi::Event& e) {
+        handleEvent(e);
+    }, [this](unsigned int offset, unsigned int count) {
+        writeBuf(m_buffer.data() + offset * streamCount(), count);
+    });
 }
 
 async::Channel<unsigned int> FluidSynth::streamsCountChanged() const
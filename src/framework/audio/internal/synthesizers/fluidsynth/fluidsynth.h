@@ -29,6 +29,7 @@
 #include <functional>
 
 #include "isynthesizer.h"
+#include "scheduledevents.h"
 
 namespace mu::audio::synth {
 struct Fluid;
@@ -52,6 +53,8 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
+    void clearScheduledEvents() override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override; // all channels
@@ -93,6 +96,7 @@ private:
 
     unsigned int m_sampleRate = 0;
     std::vector<float> m_buffer = {};
+    ScheduledEvents m_scheduledEvents;
     async::Channel<unsigned int> m_streamsCountChanged;
 };
 }
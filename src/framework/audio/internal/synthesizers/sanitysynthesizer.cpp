@@ -90,6 +90,18 @@ bool SanitySynthesizer::handleEvent(const midi::Event& e)
     return m_synth->handleEvent(e);
 }
 
+void SanitySynthesizer::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_synth->scheduleEvent(e, sampleOffset);
+}
+
+void SanitySynthesizer::clearScheduledEvents()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    m_synth->clearScheduledEvents();
+}
+
 void SanitySynthesizer::writeBuf(float* stream, unsigned int samples)
 {
     ONLY_AUDIO_WORKER_THREAD;
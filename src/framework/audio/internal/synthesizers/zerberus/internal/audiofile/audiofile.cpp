@@ -22,6 +22,8 @@
 
 #include "audiofile.h"
 
+#include <QFile>
+
 #include <vector>
 #include <math.h>
 #include <climits>
@@ -85,11 +87,41 @@ bool AudioFile::open(const QByteArray& b)
     buf = b;
     idx = 0;
     sf  = sf_open_virtual(&sfio, SFM_READ, &info, this);
+    return readInfo();
+}
+
+//---------------------------------------------------------
+//   open
+//    read from the file, for streaming it without
+//    holding all of it in memory
+//---------------------------------------------------------
+
+bool AudioFile::open(const QString& path)
+{
+    sf = sf_open(QFile::encodeName(path).constData(), SFM_READ, &info);
+    return readInfo();
+}
+
+//---------------------------------------------------------
+//   readInfo
+//---------------------------------------------------------
+
+bool AudioFile::readInfo()
+{
     hasInstrument = sf_command(sf, SFC_GET_INSTRUMENT, &inst, sizeof(inst)) == SF_TRUE;
     _type = info.format & SF_FORMAT_OGG ? fltp : s16p;
     return sf != 0;
 }
 
+//---------------------------------------------------------
+//   seekFrame
+//---------------------------------------------------------
+
+bool AudioFile::seekFrame(sf_count_t frame)
+{
+    return sf_seek(sf, frame, SEEK_SET) == frame;
+}
+
 //---------------------------------------------------------
 //   error
 //---------------------------------------------------------
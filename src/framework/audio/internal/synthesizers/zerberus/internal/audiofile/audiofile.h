@@ -24,6 +24,7 @@
 #define __AUDIOFILE_H__
 
 #include <QByteArray>
+#include <QString>
 
 #include <sndfile.h>
 
@@ -46,11 +47,15 @@ class AudioFile
     int idx { 0 };
     FormatType _type { fltp };
 
+    bool readInfo();
+
 public:
     AudioFile();
     ~AudioFile();
 
     bool open(const QByteArray&);
+    bool open(const QString& path);
+    bool seekFrame(sf_count_t frame);
     const char* error() const;
     sf_count_t readData(short* data, sf_count_t frames);
 
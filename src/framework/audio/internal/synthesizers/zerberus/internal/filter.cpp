@@ -30,6 +30,7 @@
 #endif
 #include <cmath>
 
+#include <algorithm>
 #include <functional>
 
 #include "zerberus.h"
@@ -307,3 +308,83 @@ float ZFilter::interpolate(unsigned phase, short prevVal, short currVal, short n
            + interpValTable[2] * nextVal
            + interpValTable[3] * nextNextVal;
 }
+
+//---------------------------------------------------------
+//   interpolateBlock
+//    interpolates frames values of a channel with the
+//    stride of the interleaved data, advancing phase by
+//    phaseIncr after each; every tap has to be inside data
+//---------------------------------------------------------
+
+void ZFilter::interpolateBlock(const short* data, long long phase, long long phaseIncr, int stride, int frames,
+                               float* values) const
+{
+    for (int i = 0; i < frames; ++i) {
+        const long long idx = (phase >> 8) * stride;
+        const auto& interpValTable = interpCoeff[phase & 0xff];
+        values[i] = interpValTable[0] * data[idx - stride]
+                    + interpValTable[1] * data[idx]
+                    + interpValTable[2] * data[idx + stride]
+                    + interpValTable[3] * data[idx + 2 * stride];
+        phase += phaseIncr;
+    }
+}
+
+//---------------------------------------------------------
+//   applyBlock
+//    filters values in place, with the coefficients
+//    held in registers for the whole block
+//---------------------------------------------------------
+
+void ZFilter::applyBlock(float* values, int frames, bool leftChannel)
+{
+    FilterData& d = leftChannel ? monoL : monoR;
+    float histX1 = d.histX1;
+    float histX2 = d.histX2;
+    float histY1 = d.histY1;
+    float histY2 = d.histY2;
+
+    switch (sampleZone->fil_type) {
+    case FilterType::hpf_2p:
+    case FilterType::lpf_2p:
+    case FilterType::bpf_2p:
+    case FilterType::brf_2p: {
+        for (int i = 0; i < frames; ++i) {
+            const float inputValue = values[i];
+            const float value = b0 * inputValue + b1 * histX1 + b2 * histX2 + a1 * histY1 + a2 * histY2;
+            histX2 = histX1;
+            histX1 = inputValue;
+            histY2 = histY1;
+            histY1 = value;
+            values[i] = value;
+        }
+        break;
+    }
+    case FilterType::hpf_1p: {
+        for (int i = 0; i < frames; ++i) {
+            const float inputValue = values[i];
+            const float value = b0 * inputValue + b1 * histX1 - a1 * histY1;
+            histX1 = inputValue;
+            histY1 = value;
+            values[i] = value;
+        }
+        break;
+    }
+    case FilterType::lpf_1p: {
+        for (int i = 0; i < frames; ++i) {
+            const float value = b0 * values[i] - a1 * histY1;
+            histY1 = value;
+            values[i] = value;
+        }
+        break;
+    }
+    default:
+        qWarning() << "this equation is not implemented" << (int)sampleZone->fil_type;
+        std::fill(values, values + frames, 0.f);
+    }
+
+    d.histX1 = histX1;
+    d.histX2 = histX2;
+    d.histY1 = histY1;
+    d.histY2 = histY2;
+}
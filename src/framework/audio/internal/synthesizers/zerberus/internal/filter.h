@@ -43,6 +43,12 @@ public:
     float apply(float inputValue, bool leftChannel);
     float interpolate(unsigned phase, short prevVal, short currVal, short nextVal, short nextNextVal) const;   //pure function
 
+    // block variants of apply and interpolate, the filter must be settled
+    bool isSettled() const { return filter_coeff_incr_count == 0; }
+    void applyBlock(float* values, int frames, bool leftChannel);
+    void interpolateBlock(const short* data, long long phase, long long phaseIncr, int stride, int frames,
+                          float* values) const;
+
 private:
     const Zerberus* zerberus;
     const Zone* sampleZone;
@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <algorithm>
 #include <QFile>
 #include <QFileInfo>
 #include <QStringList>
@@ -31,6 +32,8 @@
 #include "thirdparty/qzip/qzipreader_p.h"
 
 #include "instrument.h"
+#include "samplestreamer.h"
+#include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
 
@@ -53,56 +56,104 @@ Sample::~Sample()
 
 //---------------------------------------------------------
 //   readSample
+//    with a sample preload set, only the first part of a
+//    sample file is read, at least residentFrames and its
+//    loop, the rest is streamed while the sample plays
 //---------------------------------------------------------
 
-Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
+Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz, long long residentFrames)
 {
-    if (uz) {
-        QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
-
-        buf = uz->fileData(s);
-        if (buf.isEmpty()) {
-            printf("Sample::read: cannot read sample data <%s>\n", qPrintable(s));
+    AudioFile a;
+    const bool streaming = !uz && zerberus->samplePreload() > 0;
+    if (streaming) {
+        if (!a.open(s)) {
+            printf("open <%s> failed: %s\n", qPrintable(s), a.error());
             return 0;
         }
     } else {
-        QFile f(s);
-        if (!f.open(QIODevice::ReadOnly)) {
-            printf("Sample::read: open <%s> failed\n", qPrintable(s));
-            return 0;
+        if (uz) {
+            QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
+
+            buf = uz->fileData(s);
+            if (buf.isEmpty()) {
+                printf("Sample::read: cannot read sample data <%s>\n", qPrintable(s));
+                return 0;
+            }
+        } else {
+            QFile f(s);
+            if (!f.open(QIODevice::ReadOnly)) {
+                printf("Sample::read: open <%s> failed\n", qPrintable(s));
+                return 0;
+            }
+            buf = f.readAll();
         }
-        buf = f.readAll();
-    }
 
-    AudioFile a;
-    if (!a.open(buf)) {
-        printf("open <%s> failed: %s\n", qPrintable(s), a.error());
-        return 0;
+        if (!a.open(buf)) {
+            printf("open <%s> failed: %s\n", qPrintable(s), a.error());
+            return 0;
+        }
     }
 
     int channel = a.channels();
     sf_count_t frames  = a.frames();
     int sr      = a.samplerate();
 
-    short* data = new short[(frames + 3) * channel];
+    sf_count_t resident = frames;
+    if (streaming) {
+        // streaming a short tail isn't worth a stream
+        static const sf_count_t MIN_STREAMED_FRAMES = 64;
+
+        sf_count_t preload = std::max<sf_count_t>(residentFrames, sf_count_t(zerberus->samplePreload()) * sr / 1000);
+        if (a.loopEnd() < frames) {
+            preload = std::max<sf_count_t>(preload, a.loopEnd() + 4);
+        }
+        if (preload + MIN_STREAMED_FRAMES < frames) {
+            resident = preload;
+        }
+    }
+
+    short* data = new short[(resident + 3) * channel]();
     Sample* sa  = new Sample(channel, data, frames, sr);
     sa->setLoopStart(a.loopStart());
     sa->setLoopEnd(a.loopEnd());
     sa->setLoopMode(a.loopMode());
+    if (resident < frames) {
+        sa->setStreamed(s, resident);
+        // start the streamer now and not with the first voice on the audio thread
+        SampleStreamer::instance();
+    }
 
-    if (frames != a.readData(data + channel, frames)) {
+    if (resident != a.readData(data + channel, resident)) {
         qDebug("Sample read failed: %s\n", a.error());
         delete sa;
-        sa = 0;
+        return 0;
     }
     for (int i = 0; i < channel; ++i) {
-        data[i]                        = data[channel + i];
-        data[(frames - 1) * channel + i] = data[(frames - 3) * channel + i];
-        data[(frames - 2) * channel + i] = data[(frames - 3) * channel + i];
+        data[i] = data[channel + i];
+        if (resident == frames) {
+            data[(frames - 1) * channel + i] = data[(frames - 3) * channel + i];
+            data[(frames - 2) * channel + i] = data[(frames - 3) * channel + i];
+        }
     }
     return sa;
 }
 
+//---------------------------------------------------------
+//   sampleMemory
+//---------------------------------------------------------
+
+SampleMemory ZInstrument::sampleMemory() const
+{
+    SampleMemory memory;
+    for (const Zone* z : _zones) {
+        if (z->sample) {
+            memory.resident += z->sample->residentBytes();
+            memory.total += z->sample->bytes();
+        }
+    }
+    return memory;
+}
+
 //---------------------------------------------------------
 //   ZInstrument
 //---------------------------------------------------------
@@ -138,14 +189,18 @@ bool ZInstrument::load(const QString& path)
     instrumentPath = path;
     QFileInfo fi(path);
     _name = fi.completeBaseName();
+    bool loaded = false;
     if (fi.isFile()) {
-        return loadFromFile(path);
+        loaded = loadFromFile(path);
+    } else if (fi.isDir()) {
+        loaded = loadFromDir(path);
+    } else {
+        qDebug("not file nor dir %s", qPrintable(path));
     }
-    if (fi.isDir()) {
-        return loadFromDir(path);
+    if (loaded) {
+        buildZoneIndex();
     }
-    qDebug("not file nor dir %s", qPrintable(path));
-    return false;
+    return loaded;
 }
 
 //---------------------------------------------------------
@@ -26,6 +26,8 @@
 #include <list>
 #include <QString>
 
+#include "zoneindex.h"
+
 class MQZipReader;
 
 namespace mu::zerberus {
@@ -34,6 +36,16 @@ struct Zone;
 struct SfzRegion;
 class Sample;
 
+//---------------------------------------------------------
+//   SampleMemory
+//    bytes of sample data in memory and of all sample data
+//---------------------------------------------------------
+
+struct SampleMemory {
+    long long resident = 0;
+    long long total = 0;
+};
+
 //---------------------------------------------------------
 //   ZInstrument
 //---------------------------------------------------------
@@ -46,6 +58,7 @@ class ZInstrument
     int _program;
     QString instrumentPath;
     std::list<Zone*> _zones;
+    ZoneIndex _zoneIndex;
     int _setcc[128];
 
     bool loadFromFile(const QString&);
@@ -65,8 +78,11 @@ public:
     QString path() const { return instrumentPath; }
     const std::list<Zone*>& zones() const { return _zones; }
     std::list<Zone*>& zones() { return _zones; }
-    Sample* readSample(const QString& s, MQZipReader* uz);
+    Sample* readSample(const QString& s, MQZipReader* uz, long long residentFrames = 0);
+    SampleMemory sampleMemory() const;
     void addZone(Zone* z) { _zones.push_back(z); }
+    void buildZoneIndex() { _zoneIndex.build(_zones); }
+    const ZoneIndex& zoneIndex() const { return _zoneIndex; }
     void addRegion(SfzRegion&);
     int getSetCC(int v) { return _setcc[v]; }
 
@@ -39,10 +39,12 @@ class Sample
     long long _loopStart { 0 };
     long long _loopEnd   { 0 };
     int _loopMode     { 0 };
+    long long _residentFrames { 0 };
+    QString _path;
 
 public:
     Sample(int ch, short* val, int f, int sr)
-        : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+        : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _residentFrames(f) {}
     ~Sample();
     bool read(const QString&);
     long long frames() const { return _frames; }
@@ -56,6 +58,15 @@ public:
     long long loopStart() { return _loopStart; }
     long long loopEnd() { return _loopEnd; }
     int loopMode() { return _loopMode; }
+
+    // a streamed sample holds its first residentFrames in data(),
+    // the SampleStreamer reads the rest from the file at path
+    void setStreamed(const QString& path, long long residentFrames) { _path = path; _residentFrames = residentFrames; }
+    bool isStreamed() const { return _residentFrames < _frames; }
+    long long residentFrames() const { return _residentFrames; }
+    const QString& path() const { return _path; }
+    long long residentBytes() const { return (_residentFrames + 3) * _channel * sizeof(short); }
+    long long bytes() const { return (_frames + 3) * _channel * sizeof(short); }
 };
 }
 
@@ -0,0 +1,248 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "samplestreamer.h"
+
+#include <algorithm>
+
+#include "log.h"
+
+#include "audiofile/audiofile.h"
+#include "sample.h"
+
+using namespace mu::zerberus;
+
+//---------------------------------------------------------
+//   SampleStream
+//---------------------------------------------------------
+
+SampleStream::SampleStream()
+    : _ring(RING_SIZE, 0)
+{
+}
+
+SampleStream::~SampleStream()
+{
+}
+
+//---------------------------------------------------------
+//   SampleStreamer
+//---------------------------------------------------------
+
+SampleStreamer::SampleStreamer()
+{
+    for (int i = 0; i < STREAMS; ++i) {
+        _streams.push_back(std::make_unique<SampleStream>());
+    }
+    _thread = std::thread([this]() { run(); });
+}
+
+SampleStreamer::~SampleStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _wakeUp.notify_all();
+    _thread.join();
+}
+
+//---------------------------------------------------------
+//   instance
+//    started by the first instrument that streams samples
+//---------------------------------------------------------
+
+SampleStreamer* SampleStreamer::instance()
+{
+    static SampleStreamer streamer;
+    return &streamer;
+}
+
+//---------------------------------------------------------
+//   open
+//    the stream begins at firstFrame, it is filled once
+//    the thread opened the file
+//---------------------------------------------------------
+
+SampleStream* SampleStreamer::open(const Sample* sample, long long firstFrame)
+{
+    for (const std::unique_ptr<SampleStream>& stream : _streams) {
+        SampleStream::State state = SampleStream::State::FREE;
+        if (!stream->_state.compare_exchange_strong(state, SampleStream::State::CLAIMED, std::memory_order_acquire)) {
+            continue;
+        }
+
+        stream->_channels = sample->channel();
+        stream->_capacity = SampleStream::RING_SIZE / stream->_channels;
+        stream->_frames = sample->frames();
+        stream->_first = firstFrame;
+        stream->_written.store(firstFrame, std::memory_order_relaxed);
+        stream->_consumed.store(firstFrame, std::memory_order_relaxed);
+        stream->_path = sample->path();
+        stream->_state.store(SampleStream::State::OPENING, std::memory_order_release);
+
+        // called on the audio thread, the streamer picks the stream up with its next poll
+        _openStreams.fetch_add(1, std::memory_order_relaxed);
+        return stream.get();
+    }
+
+    return nullptr;
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void SampleStreamer::run()
+{
+    while (_running) {
+        bool busy = false;
+        for (const std::unique_ptr<SampleStream>& stream : _streams) {
+            switch (stream->_state.load(std::memory_order_acquire)) {
+            case SampleStream::State::OPENING:
+                openFile(stream.get());
+                busy = true;
+                break;
+            case SampleStream::State::STREAMING:
+                busy |= fill(stream.get());
+                break;
+            case SampleStream::State::CLOSING: {
+                stream->_file.reset();
+                stream->_path = QString();
+                stream->_state.store(SampleStream::State::FREE, std::memory_order_release);
+                _openStreams.fetch_sub(1, std::memory_order_relaxed);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        reportUnderruns();
+
+        if (busy) {
+            continue;
+        }
+
+        // the voices free room in their rings as they play
+        const int pollMs = _openStreams.load(std::memory_order_relaxed) > 0 ? POLL_MS : IDLE_POLL_MS;
+        std::unique_lock<std::mutex> lock(_mutex);
+        _wakeUp.wait_for(lock, std::chrono::milliseconds(pollMs), [this]() { return !_running; });
+    }
+}
+
+//---------------------------------------------------------
+//   openFile
+//---------------------------------------------------------
+
+void SampleStreamer::openFile(SampleStream* stream)
+{
+    stream->_file = std::make_unique<AudioFile>();
+    bool ok = stream->_file->open(stream->_path);
+    if (ok && stream->_first < stream->_frames) {
+        ok = stream->_file->seekFrame(stream->_first);
+    }
+    if (!ok) {
+        LOGW() << "cannot stream " << stream->_path;
+        stream->_file.reset();
+    }
+
+    // the voice may have closed the stream already
+    SampleStream::State state = SampleStream::State::OPENING;
+    stream->_state.compare_exchange_strong(state, SampleStream::State::STREAMING, std::memory_order_acq_rel);
+}
+
+//---------------------------------------------------------
+//   fill
+//    decode the next chunk of frames into the ring, as
+//    soon as the voice has read the frames it replaces;
+//    return true if a chunk was decoded
+//---------------------------------------------------------
+
+bool SampleStreamer::fill(SampleStream* stream)
+{
+    if (!stream->_file) {
+        return false;
+    }
+
+    const long long frames = stream->_frames;
+    const long long capacity = stream->_capacity;
+    const int channels = stream->_channels;
+
+    // the frames after the end read as silence, like the padding after Sample::data()
+    const long long end = frames + 2;
+    long long written = stream->_written.load(std::memory_order_relaxed);
+    const long long consumed = stream->_consumed.load(std::memory_order_acquire);
+
+    // after an underrun continue where the voice is
+    if (consumed > written && consumed < frames && stream->_file->seekFrame(consumed)) {
+        written = consumed;
+    }
+
+    const long long count = std::min<long long>(CHUNK_FRAMES, end - written);
+    if (count <= 0 || written + count > std::max(consumed, stream->_first) + capacity) {
+        return false;
+    }
+
+    _chunk.resize(size_t(CHUNK_FRAMES) * channels);
+    long long decoded = 0;
+    if (written < frames) {
+        decoded = std::max<long long>(stream->_file->readData(_chunk.data(), std::min(count, frames - written)), 0);
+    }
+    std::fill(_chunk.begin() + decoded * channels, _chunk.begin() + count * channels, short(0));
+
+    for (long long i = 0; i < count; ++i) {
+        const long long frame = written + i;
+        const short* src = &_chunk[i * channels];
+        // as in ZInstrument::readSample the two frames before the last one repeat the frame before them,
+        // readSample counts them from the padding frame in front of data(), frames - 1 and frames - 2 there
+        if ((frame == frames - 3 || frame == frames - 2) && frames - 4 >= stream->_first) {
+            src = &stream->_ring[((frames - 4) % capacity) * channels];
+        }
+        std::copy(src, src + channels, &stream->_ring[(frame % capacity) * channels]);
+    }
+
+    stream->_written.store(written + count, std::memory_order_release);
+    return true;
+}
+
+//---------------------------------------------------------
+//   reportUnderruns
+//    at most once a second
+//---------------------------------------------------------
+
+void SampleStreamer::reportUnderruns()
+{
+    const long long underruns = _underruns.load(std::memory_order_relaxed);
+    if (underruns == _reportedUnderruns) {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _lastReport < std::chrono::seconds(1)) {
+        return;
+    }
+
+    LOGW() << underruns << " stream underruns, " << underruns - _reportedUnderruns << " new";
+    _reportedUnderruns = underruns;
+    _lastReport = now;
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ZERBERUS_SAMPLESTREAMER_H
+#define MU_ZERBERUS_SAMPLESTREAMER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QString>
+
+class AudioFile;
+
+namespace mu::zerberus {
+class Sample;
+
+//---------------------------------------------------------
+//   SampleStream
+//    ring buffer of the frames of a streamed sample that
+//    follow its resident part, the SampleStreamer thread
+//    fills it ahead of the voice reading it
+//
+//    frames are numbered like Sample::data(), frame k is
+//    frame k of the file; the padding frame in front of
+//    data() isn't part of that numbering
+//---------------------------------------------------------
+
+class SampleStream
+{
+    friend class SampleStreamer;
+
+    enum class State : char {
+        FREE,
+        CLAIMED,
+        OPENING,
+        STREAMING,
+        CLOSING
+    };
+
+    std::atomic<State> _state { State::FREE };
+    std::vector<short> _ring;
+    int _channels = 1;
+    long long _capacity = 0;         // frames in _ring
+    long long _frames = 0;           // frames of the sample
+    long long _first = 0;            // first frame in the ring
+    std::atomic<long long> _written { 0 };    // frames before it are in the ring
+    std::atomic<long long> _consumed { 0 };   // frames before it are not read anymore
+    QString _path;
+    std::unique_ptr<AudioFile> _file;
+
+public:
+    static const int RING_SIZE = 16384;   // shorts
+
+    SampleStream();
+    ~SampleStream();
+
+    // pos is an index in the interleaved Sample::data(), false if that frame isn't streamed yet
+    bool read(long long pos, short& value) const
+    {
+        const long long frame = pos / _channels;
+        if (frame < _first || frame >= _written.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = _ring[(frame % _capacity) * _channels + pos % _channels];
+        return true;
+    }
+
+    const short* ring() const { return _ring.data(); }
+    long long capacity() const { return _capacity; }
+    long long firstFrame() const { return _first; }
+    long long writtenFrames() const { return _written.load(std::memory_order_acquire); }
+
+    void setConsumed(long long frame) { _consumed.store(frame, std::memory_order_release); }
+    void close() { _state.store(State::CLOSING, std::memory_order_release); }
+};
+
+//---------------------------------------------------------
+//   SampleStreamer
+//    background thread reading streamed samples from disk
+//    into the streams of the voices playing them, shared
+//    by all Zerberus instances like their instruments;
+//    it polls the streams, so the audio thread opening
+//    one never locks or wakes it
+//---------------------------------------------------------
+
+class SampleStreamer
+{
+    static const int STREAMS      = 512;
+    static const int CHUNK_FRAMES = 1024;
+    static const int POLL_MS      = 1;    // while streams are open
+    static const int IDLE_POLL_MS = 5;    // the resident part of a sample covers the delay
+
+    std::vector<std::unique_ptr<SampleStream> > _streams;
+    std::vector<short> _chunk;
+    std::atomic<bool> _running { true };
+    std::mutex _mutex;
+    std::condition_variable _wakeUp;      // only to stop the thread
+    std::atomic<int> _openStreams { 0 };
+    std::atomic<long long> _underruns { 0 };
+    long long _reportedUnderruns = 0;
+    std::chrono::steady_clock::time_point _lastReport;
+    std::thread _thread;
+
+    SampleStreamer();
+
+    void run();
+    void openFile(SampleStream* stream);
+    bool fill(SampleStream* stream);
+    void reportUnderruns();
+
+public:
+    ~SampleStreamer();
+
+    static SampleStreamer* instance();
+
+    // called by the voices, firstFrame is numbered like Sample::data(),
+    // nullptr if all streams are in use
+    SampleStream* open(const Sample* sample, long long firstFrame);
+
+    void countUnderrun() { _underruns.fetch_add(1, std::memory_order_relaxed); }
+    long long underruns() const { return _underruns.load(std::memory_order_relaxed); }
+};
+}
+
+#endif //MU_ZERBERUS_SAMPLESTREAMER_H
@@ -229,6 +229,9 @@ void SfzRegion::setZone(Zone* z) const
         z->onHicc[i] = on_hicc[i];
         z->locc[i]   = locc[i];
         z->hicc[i]   = hicc[i];
+        if (locc[i] != 0 || hicc[i] != 127) {
+            z->ccConditions.push_back(i);
+        }
     }
     z->useCC        = use_cc;
     z->offMode      = off_mode;
@@ -316,7 +319,9 @@ void ZInstrument::addRegion(SfzRegion& r)
         }
     }
     Zone* z = new Zone;
-    z->sample = readSample(r.sample, 0);
+    // a looped region keeps its loop in memory when the sample is streamed
+    const bool looped = r.loop_mode == LoopMode::CONTINUOUS || r.loop_mode == LoopMode::SUSTAIN;
+    z->sample = readSample(r.sample, 0, looped && r.loopEnd > 0 ? r.loopEnd + 4 : 0);
     if (z->sample) {
         //qDebug("Sample Loop - start %ll, end %ll, mode %d", z->sample->loopStart(), z->sample->loopEnd(), z->sample->loopMode());
         // if there is no opcode defining loop ranges, use sample definitions as fallback (according to spec)
@@ -21,6 +21,8 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
+#include <limits>
 
 #include "voice.h"
 #include "instrument.h"
@@ -28,6 +30,7 @@
 #include "zerberus.h"
 #include "zone.h"
 #include "sample.h"
+#include "samplestreamer.h"
 
 //#include "midi/msynthesizer.h"
 
@@ -63,6 +66,21 @@ Voice::Voice(Zerberus* z)
     _zerberus = z;
 }
 
+Voice::~Voice()
+{
+    closeStream();
+}
+
+//---------------------------------------------------------
+//   off
+//---------------------------------------------------------
+
+void Voice::off()
+{
+    _state = VoiceState::OFF;
+    closeStream();
+}
+
 //---------------------------------------------------------
 //   stop
 //---------------------------------------------------------
@@ -113,6 +131,15 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
     data      = s->data() + z->offset * audioChan;
     //avoid processing sample if offset is bigger than sample length
     eidx      = std::max((s->frames() - z->offset - 1) * audioChan, 0ll);
+    closeStream();
+    if (s->isStreamed()) {
+        // data and the stream both count frames from s->data(), so they line up without a shift;
+        // the stream starts a frame early for the interpolation taps before a late offset
+        residentIdx = (s->residentFrames() - z->offset) * audioChan;
+        _stream = SampleStreamer::instance()->open(s, std::max(s->residentFrames(), z->offset - 1));
+    } else {
+        residentIdx = std::numeric_limits<long long>::max();
+    }
     _loopMode = z->loopMode;
     _loopStart = z->loopStart;
     _loopEnd   = z->loopEnd;
@@ -236,85 +263,295 @@ void Voice::updateEnvelopes()
     }
 }
 
+//---------------------------------------------------------
+//   channelVolumes
+//---------------------------------------------------------
+
+void Voice::channelVolumes(float& left, float& right) const
+{
+    const float opcodePanLeftGain = 1.f - fmax(0.0f, z->pan / 100.0);   //[0, 1]
+    const float opcodePanRightGain = 1.f + fmin(0.0f, z->pan / 100.0);   //[0, 1]
+    left = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
+    right = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
+}
+
 //---------------------------------------------------------
 //   process
+//    renders the spans between loop, envelope and filter
+//    boundaries as blocks, the frames at the boundaries
+//    one by one
 //---------------------------------------------------------
 
 void Voice::process(int frames, float* p)
 {
+    static const int MIN_BLOCK_FRAMES = 8;
+
     filter.update();
 
-    const float opcodePanLeftGain = 1.f - fmax(0.0f, z->pan / 100.0);   //[0, 1]
-    const float opcodePanRightGain = 1.f + fmin(0.0f, z->pan / 100.0);   //[0, 1]
-    const float leftChannelVol = gain * z->ccGain * _channel->panLeftGain() * opcodePanLeftGain;
-    const float rightChannelVol = gain * z->ccGain * _channel->panRightGain() * opcodePanRightGain;
-    if (audioChan == 1) {
-        while (frames--) {
-            updateLoop();
+    float leftChannelVol = 0.f;
+    float rightChannelVol = 0.f;
+    channelVolumes(leftChannelVol, rightChannelVol);
+
+    while (frames > 0) {
+        updateLoop();
+
+        const short* blockData = nullptr;
+        long long blockStart = 0;
+        const int blockSize = blockFrames(frames, blockData, blockStart);
+        if (blockSize >= MIN_BLOCK_FRAMES) {
+            processBlock(blockSize, p, leftChannelVol, rightChannelVol, blockData, blockStart);
+            p += blockSize * 2;
+            frames -= blockSize;
+            continue;
+        }
 
-            long long idx = phase.index();
+        if (!processFrame(p, leftChannelVol, rightChannelVol)) {
+            break;
+        }
+        --frames;
+    }
 
-            if (idx >= eidx) {
-                off();
-                break;
-            }
+    updateStream();
+}
 
-            float interpVal = filter.interpolate(phase.fract(),
-                                                 getData(idx - 1), getData(idx), getData(idx + 1), getData(idx + 2));
-            float v = filter.apply(interpVal, true);
+//---------------------------------------------------------
+//   processPerSample
+//    renders every frame on its own, the reference for
+//    the block rendering of process()
+//---------------------------------------------------------
 
-            updateEnvelopes();
-            if (_state == VoiceState::OFF) {
-                break;
-            }
+void Voice::processPerSample(int frames, float* p)
+{
+    filter.update();
 
-            *p++ = v * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = v * envelopes[currentEnvelope].val * rightChannelVol;
+    float leftChannelVol = 0.f;
+    float rightChannelVol = 0.f;
+    channelVolumes(leftChannelVol, rightChannelVol);
 
-            if (V1Envelopes::DELAY != currentEnvelope) {
-                phase += phaseIncr;
-            }
+    while (frames--) {
+        updateLoop();
 
-            _samplesSinceStart++;
+        if (!processFrame(p, leftChannelVol, rightChannelVol)) {
+            break;
         }
+    }
+
+    updateStream();
+}
+
+//---------------------------------------------------------
+//   processFrame
+//    returns false when the voice went off
+//---------------------------------------------------------
+
+bool Voice::processFrame(float*& p, float leftChannelVol, float rightChannelVol)
+{
+    if (audioChan == 1) {
+        long long idx = phase.index();
+
+        if (idx >= eidx) {
+            off();
+            return false;
+        }
+
+        float interpVal = filter.interpolate(phase.fract(),
+                                             getData(idx - 1), getData(idx), getData(idx + 1), getData(idx + 2));
+        float v = filter.apply(interpVal, true);
+
+        updateEnvelopes();
+        if (_state == VoiceState::OFF) {
+            return false;
+        }
+
+        *p++ = v * envelopes[currentEnvelope].val * leftChannelVol;
+        *p++ = v * envelopes[currentEnvelope].val * rightChannelVol;
     } else {
         //
         // handle interleaved stereo samples
         //
-        while (frames--) {
-            updateLoop();
+        long long idx = phase.index() * 2;
+        if (idx >= eidx) {
+            off();
+            return false;
+        }
 
-            long long idx = phase.index() * 2;
-            if (idx >= eidx) {
-                off();
+        float interpValL = filter.interpolate(phase.fract(),
+                                              getData(idx - 2), getData(idx), getData(idx + 2), getData(idx + 4));
+        float interpValR = filter.interpolate(phase.fract(),
+                                              getData(idx - 1), getData(idx + 1), getData(idx + 3),
+                                              getData(idx + 5));
+        float valueL = filter.apply(interpValL, true);
+        float valueR = filter.apply(interpValR, false);
+
+        //apply volume
+        updateEnvelopes();
+        if (_state == VoiceState::OFF) {
+            return false;
+        }
 
-                break;
-            }
+        *p++ = valueL * envelopes[currentEnvelope].val * leftChannelVol;
+        *p++ = valueR * envelopes[currentEnvelope].val * rightChannelVol;
+    }
 
-            float interpValL = filter.interpolate(phase.fract(),
-                                                  getData(idx - 2), getData(idx), getData(idx + 2), getData(idx + 4));
-            float interpValR = filter.interpolate(phase.fract(),
-                                                  getData(idx - 1), getData(idx + 1), getData(idx + 3),
-                                                  getData(idx + 5));
-            float valueL = filter.apply(interpValL, true);
-            float valueR = filter.apply(interpValR, false);
-
-            //apply volume
-            updateEnvelopes();
-            if (_state == VoiceState::OFF) {
-                break;
-            }
+    if (V1Envelopes::DELAY != currentEnvelope) {
+        phase += phaseIncr;
+    }
 
-            *p++ = valueL * envelopes[currentEnvelope].val * leftChannelVol;
-            *p++ = valueR * envelopes[currentEnvelope].val * rightChannelVol;
+    _samplesSinceStart++;
+    return true;
+}
+
+//---------------------------------------------------------
+//   blockFrames
+//    number of the next frames, at most frames, that the
+//    block rendering can process: the envelope stays in
+//    its stage, the filter is settled and no interpolation
+//    tap needs getData() to wrap around the loop or the
+//    sample bounds. The taps are read from blockData,
+//    which begins at frame blockStart: the data or, past
+//    the resident part of a streamed sample, one lap of
+//    the ring of the stream. updateLoop() must be called
+//    before.
+//---------------------------------------------------------
 
-            if (V1Envelopes::DELAY != currentEnvelope) {
-                phase += phaseIncr;
+int Voice::blockFrames(int frames, const short*& blockData, long long& blockStart) const
+{
+    if (!filter.isSettled()) {
+        return 0;
+    }
+
+    long long blockSize = std::min(frames, VOICE_BLOCK_FRAMES);
+
+    switch (_state) {
+    case VoiceState::PLAYING:
+    case VoiceState::SUSTAINED:
+        break;
+    case VoiceState::ATTACK: {
+        const int lastStage = trigger == Trigger::RELEASE ? V1Envelopes::RELEASE : V1Envelopes::SUSTAIN;
+        if (currentEnvelope >= lastStage) {
+            return 0;
+        }
+        blockSize = std::min<long long>(blockSize, envelopes[currentEnvelope].count);
+        break;
+    }
+    case VoiceState::STOP:
+        if (currentEnvelope != V1Envelopes::RELEASE) {
+            return 0;
+        }
+        blockSize = std::min<long long>(blockSize, envelopes[currentEnvelope].count);
+        break;
+    default:
+        return 0;
+    }
+
+    // index range whose taps idx - 1 .. idx + 2 are read from data directly
+    if (eidx < 3 * audioChan) {
+        return 0;
+    }
+    long long firstIdx = 1;
+    long long lastIdx = (eidx - 3 * audioChan) / audioChan;
+
+    if (loopEnabled()) {
+        if (_looping) {
+            firstIdx = std::max(firstIdx, _loopStart + 1);
+            lastIdx = std::min(lastIdx, _loopEnd - 2);
+        } else {
+            lastIdx = std::min(lastIdx, _loopEnd - (audioChan * 3 - 1));
+        }
+    }
+
+    const long long idx = phase.index();
+    blockData = data;
+    blockStart = 0;
+
+    if (residentIdx != std::numeric_limits<long long>::max()) {
+        const long long lastResidentIdx = residentIdx / audioChan - 3;
+        if (idx <= lastResidentIdx) {
+            lastIdx = std::min(lastIdx, lastResidentIdx);
+        } else {
+            if (!_stream) {
+                return 0;
+            }
+            // the taps have to be streamed already, in one lap of the ring
+            const long long firstTap = idx - 1 + z->offset;
+            if (firstTap < _stream->firstFrame()) {
+                return 0;
             }
+            const long long lapStart = firstTap - firstTap % _stream->capacity();
+            const long long lastTap = std::min(lapStart + _stream->capacity(), _stream->writtenFrames()) - 1;
+            lastIdx = std::min(lastIdx, lastTap - 2 - z->offset);
 
-            _samplesSinceStart++;
+            blockData = _stream->ring();
+            blockStart = lapStart - z->offset;
         }
     }
+
+    if (idx < firstIdx || idx > lastIdx) {
+        return 0;
+    }
+
+    const long long incr = V1Envelopes::DELAY != currentEnvelope ? phaseIncr.data : 0;
+    if (incr > 0) {
+        blockSize = std::min(blockSize, (lastIdx * 256 + 255 - phase.data) / incr + 1);
+    }
+
+    return int(blockSize);
+}
+
+//---------------------------------------------------------
+//   processBlock
+//    renders frames given by blockFrames(): the filter
+//    runs over the interpolated block, envelope and gain
+//    over the filtered one
+//---------------------------------------------------------
+
+void Voice::processBlock(int frames, float* p, float leftChannelVol, float rightChannelVol,
+                         const short* blockData, long long blockStart)
+{
+    float valuesL[VOICE_BLOCK_FRAMES];
+    float valuesR[VOICE_BLOCK_FRAMES];
+    float envelope[VOICE_BLOCK_FRAMES];
+
+    const long long incr = V1Envelopes::DELAY != currentEnvelope ? phaseIncr.data : 0;
+
+    const long long blockPhase = phase.data - blockStart * 256;
+
+    filter.interpolateBlock(blockData, blockPhase, incr, audioChan, frames, valuesL);
+    filter.applyBlock(valuesL, frames, true);
+
+    const float* valuesRight = valuesL;
+    if (audioChan != 1) {
+        filter.interpolateBlock(blockData + 1, blockPhase, incr, audioChan, frames, valuesR);
+        filter.applyBlock(valuesR, frames, false);
+        valuesRight = valuesR;
+    }
+
+    Envelope& env = envelopes[currentEnvelope];
+    if (_state == VoiceState::ATTACK || _state == VoiceState::STOP) {
+        env.stepBlock(envelope, frames);
+    } else {
+        std::fill(envelope, envelope + frames, env.val);
+    }
+
+    for (int i = 0; i < frames; ++i) {
+        p[2 * i] = valuesL[i] * envelope[i] * leftChannelVol;
+        p[2 * i + 1] = valuesRight[i] * envelope[i] * rightChannelVol;
+    }
+
+    phase.data += incr * frames;
+    _samplesSinceStart += frames;
+}
+
+//---------------------------------------------------------
+//   loopEnabled
+//---------------------------------------------------------
+
+bool Voice::loopEnabled() const
+{
+    bool validLoop = _loopEnd > 0 && _loopStart >= 0 && (_loopEnd <= (eidx / audioChan));
+    bool shallLoop = loopMode() == LoopMode::CONTINUOUS
+                     || (loopMode() == LoopMode::SUSTAIN && (_state < VoiceState::STOP));
+    return validLoop && shallLoop;
 }
 
 //---------------------------------------------------------
@@ -325,11 +562,8 @@ void Voice::updateLoop()
 {
     long long idx = phase.index();
     int loopOffset = (audioChan * 3) - 1;   // offset due to interpolation
-    bool validLoop = _loopEnd > 0 && _loopStart >= 0 && (_loopEnd <= (eidx / audioChan));
-    bool shallLoop = loopMode() == LoopMode::CONTINUOUS
-                     || (loopMode() == LoopMode::SUSTAIN && (_state < VoiceState::STOP));
 
-    if (!(validLoop && shallLoop)) {
+    if (!loopEnabled()) {
         _looping = false;
         return;
     }
@@ -348,19 +582,62 @@ short Voice::getData(long long pos)
         return 0;
     }
 
-    if (!_looping) {
-        return data[pos];
+    if (_looping) {
+        long long loopEnd = _loopEnd * audioChan;
+        long long loopStart = _loopStart * audioChan;
+
+        if (pos < loopStart) {
+            pos = loopEnd + (pos - loopStart) + audioChan;
+        } else if (pos > (loopEnd + audioChan - 1)) {
+            pos = loopStart + (pos - loopEnd) - audioChan;
+        }
     }
 
-    long long loopEnd = _loopEnd * audioChan;
-    long long loopStart = _loopStart * audioChan;
+    if (pos >= residentIdx) {
+        return streamData(pos);
+    }
+    return data[pos];
+}
 
-    if (pos < loopStart) {
-        return data[loopEnd + (pos - loopStart) + audioChan];
-    } else if (pos > (loopEnd + audioChan - 1)) {
-        return data[loopStart + (pos - loopEnd) - audioChan];
-    } else {
-        return data[pos];
+//---------------------------------------------------------
+//   streamData
+//    silence if the stream is behind, an underrun
+//---------------------------------------------------------
+
+short Voice::streamData(long long pos)
+{
+    short value = 0;
+    if (!_stream || !_stream->read(pos + z->offset * audioChan, value)) {
+        _underrun = true;
+    }
+    return value;
+}
+
+//---------------------------------------------------------
+//   updateStream
+//    let the stream reuse the frames before the voice
+//---------------------------------------------------------
+
+void Voice::updateStream()
+{
+    if (_stream) {
+        _stream->setConsumed(phase.index() - 1 + z->offset);
+    }
+    if (_underrun) {
+        _underrun = false;
+        SampleStreamer::instance()->countUnderrun();
+    }
+}
+
+//---------------------------------------------------------
+//   closeStream
+//---------------------------------------------------------
+
+void Voice::closeStream()
+{
+    if (_stream) {
+        _stream->close();
+        _stream = nullptr;
     }
 }
 
@@ -36,6 +36,7 @@ namespace mu::zerberus {
 class Channel;
 struct Zone;
 class Sample;
+class SampleStream;
 class Zerberus;
 
 enum class LoopMode : char;
@@ -43,6 +44,7 @@ enum class OffMode : char;
 enum class Trigger : char;
 
 static const int EG_SIZE    = 256;
+static const int VOICE_BLOCK_FRAMES = 128;
 
 //---------------------------------------------------------
 //   Envelope
@@ -73,6 +75,18 @@ struct Envelope {
         }
     }
 
+    // steps frames times inside the stage (frames <= count) and stores each value
+    void stepBlock(float* values, int frames)
+    {
+        for (int i = 0; i < frames; ++i) {
+            --count;
+            if (!constant) {
+                val = table[EG_SIZE * count / steps] * (max - offset) + offset;
+            }
+            values[i] = val;
+        }
+    }
+
     void setTime(float ms, int sampleRate);
     void setConstant(float v) { constant = true; val = v; }
     void setVariable() { constant = false; }
@@ -144,6 +158,9 @@ class Voice
 
     short* data;
     long long eidx;
+    long long residentIdx;    // data ends here for a streamed sample, the rest is read from _stream
+    SampleStream* _stream = nullptr;
+    bool _underrun = false;
     LoopMode _loopMode;
     OffMode _offMode;
     int _offBy;
@@ -165,14 +182,25 @@ class Voice
 
     const Zone* z;
 
+    void channelVolumes(float& left, float& right) const;
+    bool loopEnabled() const;
+    int blockFrames(int frames, const short*& blockData, long long& blockStart) const;
+    void processBlock(int frames, float* p, float leftVol, float rightVol, const short* blockData, long long blockStart);
+    bool processFrame(float*& p, float leftVol, float rightVol);
+    short streamData(long long pos);
+    void updateStream();
+    void closeStream();
+
 public:
     Voice(Zerberus*);
+    ~Voice();
     Voice* next() const { return _next; }
     void setNext(Voice* v) { _next = v; }
 
     void start(Channel* channel, int key, int velo, const Zone*, double durSinceNoteOn);
     void updateEnvelopes();
     void process(int frames, float*);
+    void processPerSample(int frames, float*);
     void updateLoop();
     short getData(long long pos);
 
@@ -194,7 +222,7 @@ public:
 
     void stop(float time);
     void sustained() { _state = VoiceState::SUSTAINED; }
-    void off() { _state = VoiceState::OFF; }
+    void off();
     const char* state() const;
     LoopMode loopMode() const { return _loopMode; }
     int getSamplesSinceStart() { return _samplesSinceStart; }
@@ -9,6 +9,8 @@ set(ZERBERUS_SRC
     ${CMAKE_CURRENT_LIST_DIR}/instrument.cpp
     ${CMAKE_CURRENT_LIST_DIR}/instrument.h
     ${CMAKE_CURRENT_LIST_DIR}/sample.h
+    ${CMAKE_CURRENT_LIST_DIR}/samplestreamer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/samplestreamer.h
     ${CMAKE_CURRENT_LIST_DIR}/sfz.cpp
     ${CMAKE_CURRENT_LIST_DIR}/voice.cpp
     ${CMAKE_CURRENT_LIST_DIR}/voice.h
@@ -16,5 +18,7 @@ set(ZERBERUS_SRC
     ${CMAKE_CURRENT_LIST_DIR}/zerberus.h
     ${CMAKE_CURRENT_LIST_DIR}/zone.cpp
     ${CMAKE_CURRENT_LIST_DIR}/zone.h
+    ${CMAKE_CURRENT_LIST_DIR}/zoneindex.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/zoneindex.h
     ${CMAKE_CURRENT_LIST_DIR}/controllers.h
     )
@@ -29,6 +29,7 @@
 #include "voice.h"
 #include "channel.h"
 #include "instrument.h"
+#include "samplestreamer.h"
 #include "zone.h"
 
 using namespace mu::zerberus;
@@ -92,7 +93,7 @@ void Zerberus::trigger(Channel* channel, int key, int velo, Trigger trigger, int
 {
     ZInstrument* i = channel->instrument();
     double random = (double)rand() / (double)RAND_MAX;
-    for (Zone* z : i->zones()) {
+    for (Zone* z : i->zoneIndex().zones(trigger, key, velo)) {
         if (z->match(channel, key, velo, trigger, random, cc, ccVal)) {
             //
             // handle offBy voices
@@ -278,6 +279,31 @@ QStringList Zerberus::soundFonts() const
     return sl;
 }
 
+//---------------------------------------------------------
+//   sampleMemory
+//---------------------------------------------------------
+
+SampleMemory Zerberus::sampleMemory() const
+{
+    SampleMemory memory;
+    for (const ZInstrument* i : instruments) {
+        SampleMemory m = i->sampleMemory();
+        memory.resident += m.resident;
+        memory.total += m.total;
+    }
+    return memory;
+}
+
+//---------------------------------------------------------
+//   streamUnderruns
+//    of all Zerberus instances, they share the streamer
+//---------------------------------------------------------
+
+long long Zerberus::streamUnderruns() const
+{
+    return _samplePreload > 0 ? SampleStreamer::instance()->underruns() : 0;
+}
+
 //---------------------------------------------------------
 //   addSoundFont
 //---------------------------------------------------------
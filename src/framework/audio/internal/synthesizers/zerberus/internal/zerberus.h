@@ -35,6 +35,7 @@
 namespace mu::zerberus {
 class Channel;
 class ZInstrument;
+struct SampleMemory;
 enum class Trigger : char;
 
 static const int MAX_VOICES   = 512;
@@ -101,6 +102,7 @@ class Zerberus //: public Ms::Synthesizer
     bool _loadWasCanceled = false;
 
     float _sampleRate = 0.0f;
+    int _samplePreload = 0;   // ms of each sample read on load, the rest is streamed; 0 - read whole samples
 
     bool loadInstrument(const QString& path);
 
@@ -114,10 +116,14 @@ public:
 
     float sampleRate() const { return _sampleRate; }
     void setSampleRate(float sr) { _sampleRate = sr; }
+    int samplePreload() const { return _samplePreload; }
+    void setSamplePreload(int ms) { _samplePreload = ms; }
 
     bool addSoundFont(const QString& path);
     bool removeSoundFont(const QString& path);
     QStringList soundFonts() const;
+    SampleMemory sampleMemory() const;
+    long long streamUnderruns() const;
 
     bool noteOn(int channel, int key, int velo);
     bool noteOff(int channel, int key);
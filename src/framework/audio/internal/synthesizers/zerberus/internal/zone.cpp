@@ -68,10 +68,7 @@ bool Zone::match(Channel* c, int k, int v, Trigger et, double rand, int cc, int
 //printf("   Zone match %d %d %d -- %d %d  %d %d  center %d trigger %d\n",
 //         k, v, et, keyLo, keyHi, veloLo, veloHi, keyBase, trigger);
         if (useCC) {
-            for (int i = 0; i < 128; i++) {
-                if (locc[i] == 0 && hicc[i] == 127) {
-                    continue;
-                }
+            for (int i : ccConditions) {
                 if (locc[i] > c->getCtrl(i) || hicc[i] < c->getCtrl(i)) {
                     return false;
                 }
@@ -24,6 +24,7 @@
 #define MU_ZERBERUS_ZONE_H
 
 #include <map>
+#include <vector>
 
 namespace mu::zerberus {
 class Sample;
@@ -127,6 +128,7 @@ struct Zone {
     int onHicc[128];
     int locc[128];
     int hicc[128];
+    std::vector<int> ccConditions;    // controllers where locc - hicc is not the full range
     bool useCC = false;
 
     Zone();
@@ -0,0 +1,154 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "zoneindex.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "zone.h"
+
+using namespace mu::zerberus;
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void ZoneIndex::clear()
+{
+    for (int t = 0; t < TRIGGERS; ++t) {
+        for (int k = 0; k < KEYS; ++k) {
+            _layers[t][k].clear();
+        }
+    }
+    _lists.clear();
+    _ccZones.clear();
+}
+
+//---------------------------------------------------------
+//   build
+//    a zone is listed under the keys and velocities it
+//    covers, the lists keep the order of the zones, so
+//    the round robin and the offBy groups behave like
+//    a scan of all zones
+//---------------------------------------------------------
+
+void ZoneIndex::build(const std::list<Zone*>& zones)
+{
+    clear();
+
+    std::map<std::vector<Zone*>, uint32_t> listIds;
+    _lists.push_back(std::vector<Zone*>());
+    listIds[_lists.front()] = 0;
+
+    for (int t = 0; t < TRIGGERS; ++t) {
+        Trigger trigger = static_cast<Trigger>(t);
+
+        if (trigger == Trigger::CC) {
+            for (Zone* z : zones) {
+                if (z->trigger == trigger) {
+                    _ccZones.push_back(z);
+                }
+            }
+            continue;
+        }
+
+        std::vector<Zone*> keyZones[KEYS];
+        for (Zone* z : zones) {
+            if (z->trigger != trigger || z->veloLo > z->veloHi) {
+                continue;
+            }
+            int lo = std::max(0, int(z->keyLo));
+            int hi = std::min(KEYS - 1, int(z->keyHi));
+            for (int k = lo; k <= hi; ++k) {
+                keyZones[k].push_back(z);
+            }
+        }
+
+        for (int k = 0; k < KEYS; ++k) {
+            const std::vector<Zone*>& bucket = keyZones[k];
+
+            // the velocities where the set of zones changes
+            std::set<int> starts { 0 };
+            for (const Zone* z : bucket) {
+                starts.insert(std::max(0, int(z->veloLo)));
+                if (z->veloHi < 127) {
+                    starts.insert(z->veloHi + 1);
+                }
+            }
+
+            std::vector<Layer>& layers = _layers[t][k];
+            for (auto i = starts.begin(); i != starts.end(); ++i) {
+                int veloLo = *i;
+                auto next = std::next(i);
+                int veloHi = next == starts.end() ? 127 : *next - 1;
+
+                std::vector<Zone*> list;
+                for (Zone* z : bucket) {
+                    if (z->veloLo <= veloLo && z->veloHi >= veloHi) {
+                        list.push_back(z);
+                    }
+                }
+
+                auto id = listIds.find(list);
+                if (id == listIds.end()) {
+                    id = listIds.insert({ list, uint32_t(_lists.size()) }).first;
+                    _lists.push_back(list);
+                }
+
+                if (!layers.empty() && layers.back().list == id->second) {
+                    layers.back().veloHi = veloHi;
+                } else {
+                    layers.push_back({ veloHi, id->second });
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   zones
+//    the zones that can match the note, Zone::match
+//    still decides on the random range, the controllers
+//    and the round robin
+//---------------------------------------------------------
+
+const std::vector<Zone*>& ZoneIndex::zones(Trigger trigger, int key, int velo) const
+{
+    static const std::vector<Zone*> noZones;
+
+    if (trigger == Trigger::CC) {
+        return _ccZones;
+    }
+
+    int t = static_cast<int>(trigger);
+    if (t < 0 || t >= TRIGGERS || key < 0 || key >= KEYS || velo < 0) {
+        return noZones;
+    }
+
+    for (const Layer& layer : _layers[t][key]) {
+        if (velo <= layer.veloHi) {
+            return _lists[layer.list];
+        }
+    }
+    return noZones;
+}
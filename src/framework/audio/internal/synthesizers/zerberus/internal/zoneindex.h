@@ -0,0 +1,65 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_ZERBERUS_ZONEINDEX_H
+#define MU_ZERBERUS_ZONEINDEX_H
+
+#include <cstdint>
+#include <list>
+#include <vector>
+
+namespace mu::zerberus {
+struct Zone;
+enum class Trigger : char;
+
+//---------------------------------------------------------
+//   ZoneIndex
+//    the zones of an instrument by trigger, key and
+//    velocity, built once the instrument is loaded
+//---------------------------------------------------------
+
+class ZoneIndex
+{
+    static const int TRIGGERS = 5;
+    static const int KEYS     = 128;
+
+    struct Layer {
+        int veloHi;           // last velocity of the layer
+        uint32_t list;        // index in _lists
+    };
+
+    // for every trigger and key the velocity layers, they cover 0 - 127
+    std::vector<Layer> _layers[TRIGGERS][KEYS];
+    // zone lists in the order of the instrument, _lists[0] is empty
+    std::vector<std::vector<Zone*> > _lists;
+    // CC triggered zones don't depend on key and velocity
+    std::vector<Zone*> _ccZones;
+
+public:
+    void build(const std::list<Zone*>& zones);
+    void clear();
+
+    const std::vector<Zone*>& zones(Trigger trigger, int key, int velo) const;
+};
+}
+
+#endif //MU_ZERBERUS_ZONEINDEX_H
@@ -21,10 +21,12 @@
  */
 #include "zerberussynth.h"
 #include <algorithm>
+#include <chrono>
 
 #include "log.h"
 #include "io/path.h"
 #include "internal/zerberus.h"
+#include "internal/instrument.h"
 #include "internal/controllers.h"
 #include "midi/miditypes.h"
 #include "midi/midierrors.h"
@@ -84,17 +86,25 @@ Ret ZerberusSynth::addSoundFonts(const std::vector<io::path>& sfonts)
         return make_ret(Err::SynthNotInited);
     }
 
+    m_zerb->setSamplePreload(configuration()->zerberusSamplePreload());
+
     bool ok = true;
     for (const io::path& sfont : sfonts) {
+        auto startTime = std::chrono::steady_clock::now();
         bool sok = m_zerb->addSoundFont(sfont.toQString());
         if (!sok) {
             LOGE() << "failed load soundfont: " << sfont;
             ok = false;
         } else {
-            LOGI() << "success load soundfont: " << sfont;
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+            LOGI() << "success load soundfont: " << sfont << ", " << elapsed.count() << " ms";
         }
     }
 
+    zerberus::SampleMemory memory = m_zerb->sampleMemory();
+    LOGI() << "samples in memory: " << memory.resident / (1024 * 1024) << " of " << memory.total / (1024 * 1024) << " MB"
+           << ", stream underruns: " << m_zerb->streamUnderruns();
+
     return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedLoad);
 }
 
@@ -250,6 +260,18 @@ bool ZerberusSynth::isActive() const
     return m_isActive;
 }
 
+void ZerberusSynth::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    if (!m_scheduledEvents.schedule(e, sampleOffset)) {
+        handleEvent(e);
+    }
+}
+
+void ZerberusSynth::clearScheduledEvents()
+{
+    m_scheduledEvents.clear();
+}
+
 void ZerberusSynth::writeBuf(float* stream, unsigned int samples)
 {
     IF_ASSERT_FAILED(m_zerb) {
@@ -274,7 +296,16 @@ unsigned int ZerberusSynth::streamCount() const
 
 void ZerberusSynth::forward(unsigned int sampleCount)
 {
-    writeBuf(m_buffer.data(), sampleCount);
+    if (m_scheduledEvents.empty()) {
+        writeBuf(m_buffer.data(), sampleCount);
+        return;
+    }
+
+    m_scheduledEvents.render(sampleCount, [this](const midi::Event& e) {
+        handleEvent(e);
+    }, [this](unsigned int offset, unsigned int count) {
+        writeBuf(m_buffer.data() + offset * streamCount(), count);
+    });
 }
 
 async::Channel<unsigned int> ZerberusSynth::streamsCountChanged() const
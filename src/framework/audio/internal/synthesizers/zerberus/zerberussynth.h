@@ -23,6 +23,10 @@
 #define MU_AUDIO_ZERBERUSSYNTH_H
 
 #include "isynthesizer.h"
+#include "scheduledevents.h"
+
+#include "modularity/ioc.h"
+#include "iaudioconfiguration.h"
 
 namespace mu::zerberus {
 class Zerberus;
@@ -31,6 +35,8 @@ class Zerberus;
 namespace mu::audio::synth {
 class ZerberusSynth : public ISynthesizer
 {
+    INJECT(audio, IAudioConfiguration, configuration)
+
 public:
 
     ZerberusSynth();
@@ -51,6 +57,8 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
+    void clearScheduledEvents() override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override; // all channels
@@ -76,6 +84,7 @@ private:
 
     unsigned int m_sampleRate = 1;
     std::vector<float> m_buffer = {};
+    ScheduledEvents m_scheduledEvents;
     async::Channel<unsigned int> m_streamsCountChanged;
 };
 }
@@ -117,6 +117,11 @@ void AudioPlayer::forwardTime(unsigned long milliseconds)
     //here can be placed methods for preparing automatization
 }
 
+void AudioPlayer::forwardSamples(uint64_t samplePosition, unsigned int sampleRate)
+{
+    forwardTime(samplePosition * 1000 / sampleRate);
+}
+
 unsigned int AudioPlayer::streamCount() const
 {
     if (m_stream) {
@@ -44,6 +44,7 @@ public:
 
     unsigned long milliseconds() const override;
     void forwardTime(unsigned long) override;
+    void forwardSamples(uint64_t samplePosition, unsigned int sampleRate) override;
 
     // IAudioPlayer
     void unload() override;
@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioworkerpool.h"
+
+#include <string>
+
+#include "runtime.h"
+#include "internal/audiosanitizer.h"
+
+using namespace mu::audio;
+
+//! How many times the caller checks the pool threads before it sleeps on the join
+static constexpr int JOIN_SPIN_COUNT = 1000;
+
+AudioWorkerPool::AudioWorkerPool(size_t threadCount)
+{
+    m_threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        m_threads.emplace_back([this, i]() {
+            threadLoop(i);
+        });
+    }
+}
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+size_t AudioWorkerPool::threadCount() const
+{
+    return m_threads.size();
+}
+
+void AudioWorkerPool::run(size_t jobCount, const Job& job)
+{
+    if (m_threads.empty() || jobCount < 2) {
+        for (size_t i = 0; i < jobCount; ++i) {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_jobCount = jobCount;
+        m_nextJob.store(0);
+        m_pendingThreads.store(m_threads.size());
+        ++m_generation;
+    }
+    m_wakeUp.notify_all();
+
+    runJobs(&job, jobCount);
+
+    //! NOTE Every thread takes part in every run, so when we return
+    //! no thread can still be looking at this job or its counters.
+    //! The join waits for the longest job a pool thread has taken (one channel of one block)
+    //! and for the pool threads to wake up. Usually they are done by the time the caller is,
+    //! so it spins shortly before it sleeps on the mutex.
+    for (int i = 0; i < JOIN_SPIN_COUNT; ++i) {
+        if (m_pendingThreads.load() == 0) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this]() {
+        return m_pendingThreads.load() == 0;
+    });
+}
+
+void AudioWorkerPool::threadLoop(size_t number)
+{
+    mu::runtime::setThreadName("audio_worker_pool_" + std::to_string(number));
+    AudioSanitizer::setupWorkerPoolThread();
+
+    uint64_t generation = 0;
+    while (true) {
+        const Job* job = nullptr;
+        size_t jobCount = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this, generation]() {
+                return m_stop || m_generation != generation;
+            });
+
+            if (m_stop) {
+                return;
+            }
+
+            generation = m_generation;
+            job = m_job;
+            jobCount = m_jobCount;
+        }
+
+        runJobs(job, jobCount);
+
+        if (m_pendingThreads.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_finished.notify_one();
+        }
+    }
+}
+
+void AudioWorkerPool::runJobs(const Job* job, size_t jobCount)
+{
+    for (size_t i = m_nextJob.fetch_add(1); i < jobCount; i = m_nextJob.fetch_add(1)) {
+        (*job)(i);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOWORKERPOOL_H
+#define MU_AUDIO_AUDIOWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mu::audio {
+//! Fixed set of threads that helps the audio worker to process independent jobs of one block.
+//! run() is a fork-join: the calling thread takes jobs too and returns when all of them are done.
+//! Nothing is allocated per run, the job is owned by the caller.
+class AudioWorkerPool
+{
+public:
+    using Job = std::function<void (size_t index)>;
+
+    explicit AudioWorkerPool(size_t threadCount);
+    ~AudioWorkerPool();
+
+    size_t threadCount() const;
+
+    void run(size_t jobCount, const Job& job);
+
+private:
+    void threadLoop(size_t number);
+    void runJobs(const Job* job, size_t jobCount);
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_finished;
+    uint64_t m_generation = 0;
+    bool m_stop = false;
+
+    const Job* m_job = nullptr;
+    size_t m_jobCount = 0;
+    std::atomic<size_t> m_nextJob = { 0 };
+    std::atomic<size_t> m_pendingThreads = { 0 };
+};
+}
+
+#endif // MU_AUDIO_AUDIOWORKERPOOL_H
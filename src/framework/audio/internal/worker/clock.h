@@ -53,6 +53,7 @@ public:
     //! return current position in milliseconds
     time_t timeInMiliSeconds() const;
 
+    unsigned int sampleRate() const;
     void setSampleRate(unsigned int sampleRate);
     void forward(time_t samples);
 
@@ -68,6 +68,10 @@ public:
     virtual void setActive(ChannelID channelId, bool active) = 0;
     virtual void setLevel(ChannelID channelId, unsigned int streamId, float level) = 0;
     virtual void setBalance(ChannelID channelId, unsigned int streamId, std::complex<float> balance) = 0;
+
+    //! render channel sources on several threads, 0 or 1 - in the worker thread only
+    //! channels are still summed in the ChannelID order, so the mix doesn't depend on it
+    virtual void setRenderThreadCount(unsigned int count) = 0;
 };
 
 using IMixerPtr = std::shared_ptr<IMixer>;
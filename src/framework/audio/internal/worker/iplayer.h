@@ -22,6 +22,8 @@
 #ifndef MU_AUDIO_IPLAYER_H
 #define MU_AUDIO_IPLAYER_H
 
+#include <cstdint>
+
 #include "async/channel.h"
 
 namespace mu::audio {
@@ -49,6 +51,9 @@ public:
 
     virtual unsigned long milliseconds() const = 0;
     virtual void forwardTime(unsigned long milliseconds) = 0;
+
+    //! The clock moved to samplePosition, the block ending there is rendered next
+    virtual void forwardSamples(uint64_t samplePosition, unsigned int sampleRate) = 0;
 };
 }
 #endif // MU_AUDIO_IPLAYER_H
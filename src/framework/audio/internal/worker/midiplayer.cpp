@@ -24,6 +24,7 @@
 
 #include <limits>
 #include <cstring>
+#include <cmath>
 
 #include "log.h"
 #include "realfn.h"
@@ -46,6 +47,10 @@ MIDIPlayer::~MIDIPlayer()
     if (isRunning()) {
         stop();
     }
+
+    if (m_midiStream) {
+        m_midiStream->timeline.release();
+    }
 }
 
 IPlayer::Status MIDIPlayer::status() const
@@ -79,16 +84,26 @@ bool MIDIPlayer::isRunning() const
 void MIDIPlayer::loadMIDI(const std::shared_ptr<MidiStream>& stream)
 {
     ONLY_AUDIO_WORKER_THREAD;
+    if (m_midiStream) {
+        m_midiStream->timeline.release();
+    }
     m_midiStream = stream;
     m_streamState.reset();
 
     m_midiData = stream->initData;
 
+    //! NOTE The streams made in place don't publish their initial chunks themselves
+    if (m_midiStream->timeline.revision() == 0) {
+        m_midiStream->timeline.reset(m_midiData.chunks);
+    }
+    m_timeline = nullptr;
+    updateTimeline();
+
     if (m_midiStream->isStreamingAllowed) {
         m_midiStream->stream.onReceive(this, [this](const Chunk& chunk) { onChunkReceived(chunk); });
     }
 
-    if (m_midiStream->isStreamingAllowed && validChunkTick(0, m_midiData.chunks, REQUEST_BUFFER_SIZE) == 0) {
+    if (m_midiStream->isStreamingAllowed && validChunkTick(0, REQUEST_BUFFER_SIZE) == 0) {
         //! NOTE If there is no data, then we will immediately request them from 0 tick,
         //! so that there is something to play.
         requestData(0);
@@ -122,8 +137,16 @@ void MIDIPlayer::setupChannels()
         st.channels.insert(ch);
     }
 
+    ISynthesizer* defaultSynth = m_synthStates.empty() ? nullptr : m_synthStates.front().synth.get();
+    for (ChanState& chState : m_chanStates) {
+        chState.synth = defaultSynth;
+    }
+
     for (const SynthState& st : m_synthStates) {
         st.synth->setupChannels(m_midiData.initEventsForChannels(st.channels));
+        for (channel_t ch : st.channels) {
+            m_chanStates[ch].synth = st.synth.get();
+        }
     }
 }
 
@@ -141,31 +164,71 @@ void MIDIPlayer::requestData(tick_t tick)
     m_midiStream->request.send(tick);
 }
 
-void MIDIPlayer::onChunkReceived(const Chunk& chunk)
+bool MIDIPlayer::isWaitingForData() const
+{
+    return m_streamState.requested;
+}
+
+void MIDIPlayer::onChunkReceived(const Chunk&)
 {
-    std::lock_guard<std::mutex> lock(m_dataMutex);
-    m_midiData.chunks.insert({ chunk.beginTick, chunk });
+    //! NOTE The chunk is already in the timeline, see MidiStream::sendChunk
     m_streamState.requested = false;
 }
 
+void MIDIPlayer::updateTimeline()
+{
+    uint64_t revision = m_midiStream->timeline.revision();
+    if (m_timeline && revision == m_timelineRevision) {
+        return;
+    }
+
+    m_timeline = m_midiStream->timeline.acquire();
+    m_timelineRevision = revision;
+}
+
 void MIDIPlayer::forwardTime(unsigned long milliseconds)
 {
     ONLY_AUDIO_WORKER_THREAD;
-    if (!isRunning()) {
+    m_isPrevSampleSet = false;
+    forward(static_cast<double>(milliseconds), 0);
+}
+
+void MIDIPlayer::forwardSamples(uint64_t samplePosition, unsigned int sampleRate)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    IF_ASSERT_FAILED(sampleRate > 0) {
         return;
     }
 
-    msec_t msec = static_cast<msec_t>(milliseconds);
-    msec_t delta = msec - m_prevMSec;
+    if (!m_isPrevSampleSet || samplePosition < m_prevSample) {
+        //! NOTE The same rounding as in Clock::seekMiliseconds
+        m_prevSample = static_cast<uint64_t>(m_prevMSec) * sampleRate / 1000;
+        m_isPrevSampleSet = true;
+    }
 
-    if (delta < 1) {
-        return;
+    double milliseconds = m_prevMSec + (samplePosition - m_prevSample) * 1000.0 / sampleRate;
+    if (forward(milliseconds, sampleRate)) {
+        m_prevSample = samplePosition;
     }
+}
+
+bool MIDIPlayer::forward(double milliseconds, unsigned int sampleRate)
+{
+    if (!isRunning()) {
+        return false;
+    }
+
+    double delta = milliseconds - m_prevMSec;
+    if (delta <= 0) {
+        return false;
+    }
+
+    updateTimeline();
 
-    msec_t curMSec = m_curMSec + (delta * m_playSpeed);
+    double curMSec = m_curMSec + (delta * m_playSpeed);
     tick_t curTick = tick(curMSec);
-    tick_t prevTicks = tick(m_prevMSec);
-    tick_t maxValidTick = validChunkTick(curTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
+    tick_t prevTicks = tick(m_curMSec);
+    tick_t maxValidTick = validChunkTick(curTick, REQUEST_BUFFER_SIZE);
 
     if (m_midiStream->isStreamingAllowed) {
         tick_t bufSize = maxValidTick - curTick;
@@ -188,10 +251,12 @@ void MIDIPlayer::forwardTime(unsigned long milliseconds)
     //}
 
     if (m_streamState.requested) {
-        return;
+        return false;
     }
     //! -----
 
+    m_sampleRate = sampleRate;
+    m_blockStartMSec = m_curMSec;
     m_curMSec = curMSec;
 
     sendEvents(prevTicks, toTick);
@@ -201,8 +266,9 @@ void MIDIPlayer::forwardTime(unsigned long milliseconds)
         m_onTickPlayed.send(m_playTick);
     }
 
-    m_prevMSec = m_curMSec;
+    m_prevMSec = milliseconds;
     checkPosition();
+    return true;
 }
 
 void MIDIPlayer::checkPosition()
@@ -216,13 +282,35 @@ void MIDIPlayer::checkPosition()
         return;
     }
 
-    tick_t prev = tick(m_prevMSec);
+    tick_t prev = tick(m_curMSec);
     if (prev >= m_midiStream->lastTick) {
-        stop();
+        finish();
         return;
     }
 }
 
+void MIDIPlayer::finish()
+{
+    if (status() != Status::Error) {
+        setStatus(Status::Stoped);
+    }
+
+    //! NOTE Unlike stop, the events of the last block stay scheduled, they are played to the end,
+    //! and the notes that still sound are released at the end of the stream
+    for (Event& event : m_noteCache) {
+        if (event) {
+            ISynthesizer* s = synth(event.channel()).get();
+            if (m_sampleRate > 0) {
+                s->scheduleEvent(event, sampleOffset(m_midiStream->lastTick));
+            } else {
+                s->handleEvent(event);
+            }
+            midiPortDataSender()->sendSingleEvent(event);
+        }
+        event = Event::NOOP();
+    }
+}
+
 std::shared_ptr<ISynthesizer> MIDIPlayer::determineSynthesizer(channel_t ch, const std::map<channel_t, std::string>& synthmap) const
 {
     auto it = synthmap.find(ch);
@@ -262,63 +350,59 @@ std::shared_ptr<ISynthesizer> MIDIPlayer::synth(channel_t ch) const
 
 bool MIDIPlayer::sendEvents(tick_t fromTick, tick_t toTick)
 {
-    std::lock_guard<std::mutex> lock(m_dataMutex);
-
     m_isPlayTickSet = false;
 
-    if (m_midiData.chunks.empty()) {
+    if (!m_timeline || m_timeline->chunks.empty()) {
         return false;
     }
 
-    auto chunkIt = m_midiData.chunks.upper_bound(fromTick);
-    --chunkIt;
-
-    const Chunk& chunk = chunkIt->second;
-    auto pos = chunk.events.lower_bound(fromTick);
+    const std::vector<ChunkTimelinePtr>& chunks = m_timeline->chunks;
+    for (size_t c = m_timeline->chunkIndex(fromTick); c < chunks.size(); ++c) {
+        const ChunkTimeline& chunk = *chunks[c];
+        if (chunk.beginTick >= toTick) {
+            break;
+        }
 
-    while (1) {
-        const Chunk& curChunk = chunkIt->second;
-        if (pos == curChunk.events.end()) {
-            ++chunkIt;
-            if (chunkIt == m_midiData.chunks.end()) {
+        size_t i = chunk.lowerBound(fromTick);
+        for (; i < chunk.size(); ++i) {
+            tick_t tick = chunk.ticks[i];
+            if (tick >= toTick) {
                 break;
             }
 
-            const Chunk& nextChunk = chunkIt->second;
-            if (nextChunk.events.empty()) {
-                break;
+            if (!m_isPlayTickSet) {
+                m_playTick = tick;
+                m_isPlayTickSet = true;
             }
 
-            pos = nextChunk.events.begin();
-        }
-
-        if (pos->first >= toTick) {
-            break;
-        }
-
-        const Event& event = pos->second;
-
-        if (!m_isPlayTickSet) {
-            m_playTick = pos->first;
-            m_isPlayTickSet = true;
-        }
+            ChunkTimeline::Kind kind = chunk.kinds[i];
+            const ChanState& chState = m_chanStates[chunk.channels[i]];
+            if (kind == ChunkTimeline::Kind::Noop || chState.muted) {
+                continue;
+            }
 
-        ChanState& chState = m_chanStates[event.channel()];
-        if (event && !chState.muted) {
-            auto s = synth(event.channel());
-            s->handleEvent(event);
+            const Event& event = chunk.events[i];
+            ISynthesizer* s = chState.synth;
+            if (m_sampleRate > 0) {
+                s->scheduleEvent(event, sampleOffset(tick));
+            } else {
+                s->handleEvent(event);
+            }
             s->setIsActive(true);
 
-            if (event.isChannelVoice() && event.opcode() == midi::Event::Opcode::NoteOn) {
+            if (kind == ChunkTimeline::Kind::NoteOn) {
                 auto noteOff = event;
                 noteOff.setOpcode(midi::Event::Opcode::NoteOff);
                 m_noteCache[event.note()] = noteOff;
-            } else if (event.isChannelVoice() && event.opcode() == midi::Event::Opcode::NoteOff) {
-                m_noteCache[event.note()] = Event::NOOP();
+            } else if (kind == ChunkTimeline::Kind::NoteOff) {
+                //! NOTE A scheduled note off may be dropped by sendClear before it is handled
+                m_noteCache[event.note()] = m_sampleRate > 0 ? event : Event::NOOP();
             }
         }
 
-        ++pos;
+        if (i < chunk.size()) {
+            break;
+        }
     }
 
     midiPortDataSender()->sendEvents(fromTick, toTick);
@@ -327,15 +411,18 @@ bool MIDIPlayer::sendEvents(tick_t fromTick, tick_t toTick)
 
 void MIDIPlayer::sendClear()
 {
-    for (auto& cache: m_noteCache) {
-        auto event = cache.second;
+    for (const SynthState& st : m_synthStates) {
+        st.synth->clearScheduledEvents();
+    }
+
+    for (Event& event : m_noteCache) {
         if (event) {
             auto s = synth(event.channel());
             s->handleEvent(event);
             midiPortDataSender()->sendSingleEvent(event);
         }
+        event = Event::NOOP();
     }
-    m_noteCache.clear();
 }
 
 void MIDIPlayer::run()
@@ -367,7 +454,7 @@ void MIDIPlayer::pause()
 unsigned long MIDIPlayer::milliseconds() const
 {
     ONLY_AUDIO_WORKER_THREAD;
-    return m_curMSec;
+    return static_cast<unsigned long>(m_curMSec);
 }
 
 mu::async::Channel<tick_t> MIDIPlayer::tickPlayed() const
@@ -381,10 +468,13 @@ void MIDIPlayer::seek(unsigned long milliseconds)
     ONLY_AUDIO_WORKER_THREAD;
     m_curMSec = milliseconds;
     m_prevMSec = milliseconds;
+    m_isPrevSampleSet = false;
 
     if (m_midiStream && m_midiStream->isStreamingAllowed) {
+        updateTimeline();
+
         tick_t curTick = tick(m_curMSec);
-        tick_t maxValidTick = validChunkTick(curTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
+        tick_t maxValidTick = validChunkTick(curTick, REQUEST_BUFFER_SIZE);
         tick_t bufSize = maxValidTick - curTick;
         if (bufSize < REQUEST_BUFFER_SIZE) {
             requestData(maxValidTick);
@@ -392,34 +482,13 @@ void MIDIPlayer::seek(unsigned long milliseconds)
     }
 }
 
-tick_t MIDIPlayer::validChunkTick(tick_t fromTick, const Chunks& chunks, tick_t maxDistanceTick) const
+tick_t MIDIPlayer::validChunkTick(tick_t fromTick, tick_t maxDistanceTick) const
 {
-    if (chunks.empty()) {
+    if (!m_timeline) {
         return 0;
     }
 
-    auto it = chunks.upper_bound(fromTick);
-    --it;
-    for (; it != chunks.end(); ++it) {
-        const Chunk& chunk = it->second;
-
-        if ((chunk.endTick - fromTick) > maxDistanceTick) {
-            return chunk.endTick;
-        }
-
-        auto nextIt = it;
-        ++nextIt;
-        if (nextIt == chunks.end()) {
-            return chunk.endTick;
-        }
-
-        const Chunk& nextChunk = nextIt->second;
-        if (chunk.endTick != nextChunk.beginTick) {
-            return chunk.endTick;
-        }
-    }
-
-    return chunks.rbegin()->second.endTick;
+    return m_timeline->validTick(fromTick, maxDistanceTick);
 }
 
 void MIDIPlayer::buildTempoMap()
@@ -436,7 +505,7 @@ void MIDIPlayer::buildTempoMap()
         tempos.push_back({ 0, 500000 });
     }
 
-    uint64_t msec{ 0 };
+    double msec = 0.0;
     for (size_t i = 0; i < tempos.size(); ++i) {
         TempoItem t;
 
@@ -448,21 +517,38 @@ void MIDIPlayer::buildTempoMap()
         uint32_t end_ticks = ((i + 1) < tempos.size()) ? tempos.at(i + 1).first : std::numeric_limits<uint32_t>::max();
 
         uint32_t delta_ticks = end_ticks - t.startTicks;
-        msec += static_cast<uint64_t>(delta_ticks * t.onetickMsec);
+        msec += delta_ticks * t.onetickMsec;
 
         m_tempoMap.insert({ msec, std::move(t) });
     }
 }
 
-tick_t MIDIPlayer::tick(uint64_t msec) const
+tick_t MIDIPlayer::tick(double msec) const
 {
     auto it = m_tempoMap.lower_bound(msec);
 
     const TempoItem& t = it->second;
 
-    uint64_t delta = msec - t.startMsec;
-    tick_t ticks = static_cast<tick_t>(delta / t.onetickMsec);
-    return t.startTicks + ticks;
+    //! NOTE The first tick that is played at msec or later,
+    //! so the ranges [tick(from), tick(to)) of consecutive blocks join exactly
+    double ticks = (msec - t.startMsec) / t.onetickMsec;
+    return t.startTicks + static_cast<tick_t>(std::ceil(ticks));
+}
+
+unsigned int MIDIPlayer::sampleOffset(tick_t tick) const
+{
+    auto it = m_tempoMap.lower_bound(m_blockStartMSec);
+    for (auto next = std::next(it); next != m_tempoMap.end() && next->second.startTicks <= tick; ++next) {
+        it = next;
+    }
+
+    const TempoItem& t = it->second;
+    double msec = t.startMsec + (tick - t.startTicks) * t.onetickMsec;
+    double offset = (msec - m_blockStartMSec) / m_playSpeed * m_sampleRate / 1000.0;
+    if (offset <= 0) {
+        return 0;
+    }
+    return static_cast<unsigned int>(std::lround(offset));
 }
 
 float MIDIPlayer::playbackSpeed() const
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include <functional>
 #include <mutex>
+#include <array>
 
 #include "imidiplayer.h"
 #include "modularity/ioc.h"
@@ -59,6 +60,7 @@ public:
 
     unsigned long milliseconds() const override;
     void forwardTime(unsigned long milliseconds) override;
+    void forwardSamples(uint64_t samplePosition, unsigned int sampleRate) override;
 
     // IMIDIPlayer
     void loadMIDI(const std::shared_ptr<midi::MidiStream>& stream) override;
@@ -71,13 +73,21 @@ public:
     void setTrackVolume(midi::track_t trackIndex, float volume) override;
     void setTrackBalance(midi::track_t trackIndex, float balance) override;
 
+    //! a chunk is requested from the stream and not received yet,
+    //! the player doesn't move until it comes
+    bool isWaitingForData() const;
+
 private:
 
     void setStatus(const Status& status);
 
+    bool forward(double milliseconds, unsigned int sampleRate);
+
     void checkPosition();
+    void finish();
 
-    midi::tick_t validChunkTick(midi::tick_t fromTick, const midi::Chunks& chunks, midi::tick_t maxDistanceTick) const;
+    void updateTimeline();
+    midi::tick_t validChunkTick(midi::tick_t fromTick, midi::tick_t maxDistanceTick) const;
     bool sendEvents(midi::tick_t fromTick, midi::tick_t toTick);
     void sendClear();
 
@@ -87,8 +97,8 @@ private:
     void buildTempoMap();
     void setupChannels();
 
-    void setCurrentMSec(uint64_t msec);
-    midi::tick_t tick(uint64_t msec) const;
+    midi::tick_t tick(double msec) const;
+    unsigned int sampleOffset(midi::tick_t tick) const;
 
     bool hasTrack(midi::track_t num) const;
 
@@ -98,15 +108,25 @@ private:
     Status m_status = Status::Stoped;
     async::Channel<Status> m_statusChanged;
 
-    std::mutex m_dataMutex;
     midi::MidiData m_midiData;
     std::shared_ptr<midi::MidiStream> m_midiStream = nullptr;
-    std::map<uint8_t, midi::Event> m_noteCache = {};
+
+    //! NOTE The events are read from the snapshot of the stream timeline, it is acquired again
+    //! only when the revision changes. The timeline owns and frees the snapshots.
+    const midi::TimelineSnapshot* m_timeline = nullptr;
+    uint64_t m_timelineRevision = 0;
+    std::array<midi::Event, 128> m_noteCache = {};   //! NOTE The note offs of the sounding notes
 
     float m_playSpeed = 1.f;
 
-    midi::msec_t m_prevMSec = 0;
-    midi::msec_t m_curMSec = 0;
+    double m_prevMSec = 0.0;    //! NOTE Clock time of the last forwarding
+    double m_curMSec = 0.0;     //! NOTE Score time, runs at the playback speed
+
+    //! NOTE Set while events are scheduled at their offsets inside the forwarded block
+    unsigned int m_sampleRate = 0;
+    double m_blockStartMSec = 0.0;
+    uint64_t m_prevSample = 0;
+    bool m_isPrevSampleSet = false;
 
     bool m_isPlayTickSet = false;
     midi::tick_t m_playTick = 0;    //! NOTE First event tick
@@ -114,10 +134,10 @@ private:
     struct TempoItem {
         midi::tempo_t tempo = 500000;
         midi::tick_t startTicks = 0;
-        uint64_t startMsec = 0;
+        double startMsec = 0.0;
         double onetickMsec = 0.0;
     };
-    std::map<uint64_t /*msec*/, TempoItem> m_tempoMap = {};
+    std::map<double /*end msec*/, TempoItem> m_tempoMap = {};
 
     struct StreamState {
         std::atomic<bool> requested{ false };
@@ -127,8 +147,9 @@ private:
 
     struct ChanState {
         bool muted = false;
+        synth::ISynthesizer* synth = nullptr;
     };
-    std::map<midi::channel_t, ChanState> m_chanStates;
+    std::array<ChanState, 256> m_chanStates = {};
 
     struct SynthState {
         std::set<midi::channel_t> channels;
@@ -28,6 +28,10 @@ using namespace mu::audio;
 Mixer::Mixer()
 {
     ONLY_AUDIO_WORKER_THREAD;
+
+    m_renderJob = [this](size_t index) {
+        m_renderChannels[index]->forward(m_renderSampleCount);
+    };
 }
 
 Mixer::~Mixer()
@@ -147,6 +151,20 @@ void Mixer::setBalance(ChannelID channelId, unsigned int streamId, std::complex<
     m_inputList[channelId]->setBalance(streamId, balance);
 }
 
+void Mixer::setRenderThreadCount(unsigned int count)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+    if (count <= 1) {
+        m_renderPool = nullptr;
+        return;
+    }
+
+    //! NOTE The worker thread takes jobs too
+    if (!m_renderPool || m_renderPool->threadCount() != count - 1) {
+        m_renderPool = std::make_unique<AudioWorkerPool>(count - 1);
+    }
+}
+
 std::shared_ptr<IMixerChannel> Mixer::channel(unsigned int number) const
 {
     ONLY_AUDIO_WORKER_THREAD;
@@ -174,8 +192,9 @@ void Mixer::forward(unsigned int sampleCount)
         m_clock->forward(sampleCount);
     }
 
+    forwardChannels(sampleCount);
+
     for (auto& input : m_inputList) {
-        input.second->forward(sampleCount);
         mixinChannel(input.second, sampleCount);
     }
 
@@ -184,8 +203,27 @@ void Mixer::forward(unsigned int sampleCount)
             insert.second->process(m_buffer.data(), m_buffer.data(), sampleCount);
         }
     }
-    std::transform(m_buffer.begin(), m_buffer.end(), m_buffer.begin(),
-                   [this](float sample) -> float { return sample * m_masterLevel; });
+    m_kernels.gain(m_buffer.data(), m_buffer.size(), m_masterLevel);
+}
+
+void Mixer::forwardChannels(unsigned int sampleCount)
+{
+    if (!m_renderPool || m_inputList.size() < 2) {
+        for (auto& input : m_inputList) {
+            input.second->forward(sampleCount);
+        }
+        return;
+    }
+
+    //! NOTE Channel sources are independent, so they render in parallel,
+    //! the capacity of m_renderChannels only grows, no allocations on each block
+    m_renderChannels.clear();
+    for (auto& input : m_inputList) {
+        m_renderChannels.push_back(input.second.get());
+    }
+    m_renderSampleCount = sampleCount;
+
+    m_renderPool->run(m_renderChannels.size(), m_renderJob);
 }
 
 void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount)
@@ -197,6 +235,10 @@ void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int sam
     switch (m_mode) {
     case MONO:
     case STEREO:
+        if (streamCount() == 2 && channel->streamCount() == 2) {
+            mixinStereoChannel(channel, samplesCount);
+            break;
+        }
         for (unsigned int i = 0; i < channel->streamCount(); ++i) {
             mixinChannelStream(channel, i, samplesCount);
         }
@@ -204,25 +246,60 @@ void Mixer::mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int sam
     }
 }
 
-void Mixer::mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount)
+float Mixer::streamGain(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int outStreamId) const
 {
     auto balance = channel->balance(streamId).real();
-    auto level = channel->level(streamId);
-    for (unsigned int i = 0; i < samplesCount; ++i) {
-        for (unsigned int j = 0; j < streamCount(); ++j) {
-            //linear cross
-            float gain = 0.5f * balance * ((j * 2.f) - 1) + 0.5f;
-            if (gain < 0) {
-                gain = 0;
-            }
-            if (gain > 1) {
-                gain = 1;
-            }
-
-            auto channelBuffer = channel->data();
-            if (channelBuffer) {
-                m_buffer[i * streamCount() + j] += gain * level * channelBuffer[i * channel->streamCount() + streamId];
-            }
+
+    //linear cross
+    float gain = 0.5f * balance * ((outStreamId * 2.f) - 1) + 0.5f;
+    if (gain < 0) {
+        gain = 0;
+    }
+    if (gain > 1) {
+        gain = 1;
+    }
+
+    return gain * channel->level(streamId);
+}
+
+void Mixer::mixinStereoChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount)
+{
+    auto channelBuffer = channel->data();
+    if (!channelBuffer) {
+        return;
+    }
+
+    const float gains[4] = {
+        streamGain(channel, 0, 0), streamGain(channel, 0, 1),
+        streamGain(channel, 1, 0), streamGain(channel, 1, 1)
+    };
+    m_kernels.panStereo(m_buffer.data(), channelBuffer, samplesCount, gains);
+}
+
+void Mixer::mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount)
+{
+    auto channelBuffer = channel->data();
+    if (!channelBuffer) {
+        return;
+    }
+
+    unsigned int outStreams = streamCount();
+    unsigned int channelStreams = channel->streamCount();
+
+    if (channelStreams == 1 && outStreams == 2) {
+        m_kernels.panMono(m_buffer.data(), channelBuffer, samplesCount, streamGain(channel, 0, 0), streamGain(channel, 0, 1));
+        return;
+    }
+
+    if (channelStreams == 1 && outStreams == 1) {
+        m_kernels.accumulate(m_buffer.data(), channelBuffer, samplesCount, streamGain(channel, 0, 0));
+        return;
+    }
+
+    for (unsigned int j = 0; j < outStreams; ++j) {
+        float gain = streamGain(channel, streamId, j);
+        for (unsigned int i = 0; i < samplesCount; ++i) {
+            m_buffer[i * outStreams + j] += gain * channelBuffer[i * channelStreams + streamId];
         }
     }
 }
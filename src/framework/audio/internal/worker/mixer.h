@@ -24,10 +24,13 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include "imixer.h"
 #include "abstractaudiosource.h"
 #include "mixerchannel.h"
 #include "clock.h"
+#include "audioworkerpool.h"
+#include "mixkernels.h"
 
 namespace mu::audio {
 class Mixer : public IMixer, public AbstractAudioSource, public std::enable_shared_from_this<Mixer>
@@ -55,6 +58,8 @@ public:
     void setLevel(ChannelID channelId, unsigned int streamId, float level) override;
     void setBalance(ChannelID channelId, unsigned int streamId, std::complex<float> balance) override;
 
+    void setRenderThreadCount(unsigned int count) override;
+
     // IAudioSource (AbstractAudioSource)
     void setSampleRate(unsigned int sampleRate) override;
 
@@ -69,15 +74,26 @@ public:
     void setClock(std::shared_ptr<Clock> clock);
 
 private:
+    void forwardChannels(unsigned int sampleCount);
+
     //! mix the channel in to the buffer
     void mixinChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount);
     void mixinChannelStream(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int samplesCount);
+    void mixinStereoChannel(std::shared_ptr<MixerChannel> channel, unsigned int samplesCount);
+    float streamGain(std::shared_ptr<MixerChannel> channel, unsigned int streamId, unsigned int outStreamId) const;
 
     Mode m_mode = STEREO;
     float m_masterLevel = 1.f;
     std::map<ChannelID, std::shared_ptr<MixerChannel> > m_inputList = {};
     std::map<unsigned int, std::shared_ptr<IAudioProcessor> > m_insertList = {};
     std::shared_ptr<Clock> m_clock;
+
+    std::unique_ptr<AudioWorkerPool> m_renderPool;
+    std::vector<MixerChannel*> m_renderChannels;
+    unsigned int m_renderSampleCount = 0;
+    AudioWorkerPool::Job m_renderJob;
+
+    const MixKernels& m_kernels = MixKernels::instance();
 };
 }
 
@@ -0,0 +1,318 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "mixkernels.h"
+
+#include <initializer_list>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MU_AUDIO_MIXKERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MU_TARGET_SSE2
+#define MU_TARGET_AVX2
+#else
+#define MU_TARGET_SSE2 __attribute__((target("sse2")))
+#define MU_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+using namespace mu::audio;
+
+// ============================================================
+// Scalar
+// ============================================================
+
+static void gainScalar(float* buffer, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] *= gain;
+    }
+}
+
+static void accumulateScalar(float* dest, const float* src, size_t count, float gain)
+{
+    for (size_t i = 0; i < count; ++i) {
+        dest[i] += gain * src[i];
+    }
+}
+
+static void panMonoScalar(float* dest, const float* src, size_t sampleCount, float leftGain, float rightGain)
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        dest[2 * i] += leftGain * src[i];
+        dest[2 * i + 1] += rightGain * src[i];
+    }
+}
+
+static void panStereoScalar(float* dest, const float* src, size_t sampleCount, const float gains[4])
+{
+    for (size_t i = 0; i < sampleCount; ++i) {
+        float left = src[2 * i];
+        float right = src[2 * i + 1];
+        dest[2 * i] = (dest[2 * i] + gains[0] * left) + gains[2] * right;
+        dest[2 * i + 1] = (dest[2 * i + 1] + gains[1] * left) + gains[3] * right;
+    }
+}
+
+#ifdef MU_AUDIO_MIXKERNELS_X86
+
+// ============================================================
+// SSE2, 2 stereo samples per step
+// ============================================================
+
+MU_TARGET_SSE2 static void gainSSE2(float* buffer, size_t count, float gain)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(buffer + i, _mm_mul_ps(_mm_loadu_ps(buffer + i), g));
+    }
+    gainScalar(buffer + i, count - i, gain);
+}
+
+MU_TARGET_SSE2 static void accumulateSSE2(float* dest, const float* src, size_t count, float gain)
+{
+    const __m128 g = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 d = _mm_loadu_ps(dest + i);
+        _mm_storeu_ps(dest + i, _mm_add_ps(d, _mm_mul_ps(g, _mm_loadu_ps(src + i))));
+    }
+    accumulateScalar(dest + i, src + i, count - i, gain);
+}
+
+MU_TARGET_SSE2 static void panMonoSSE2(float* dest, const float* src, size_t sampleCount, float leftGain, float rightGain)
+{
+    const __m128 g = _mm_setr_ps(leftGain, rightGain, leftGain, rightGain);
+    size_t i = 0;
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m128 s = _mm_loadu_ps(src + i);
+        __m128 lo = _mm_unpacklo_ps(s, s); // s0 s0 s1 s1
+        __m128 hi = _mm_unpackhi_ps(s, s); // s2 s2 s3 s3
+
+        float* d = dest + 2 * i;
+        _mm_storeu_ps(d, _mm_add_ps(_mm_loadu_ps(d), _mm_mul_ps(g, lo)));
+        _mm_storeu_ps(d + 4, _mm_add_ps(_mm_loadu_ps(d + 4), _mm_mul_ps(g, hi)));
+    }
+    panMonoScalar(dest + 2 * i, src + i, sampleCount - i, leftGain, rightGain);
+}
+
+MU_TARGET_SSE2 static void panStereoSSE2(float* dest, const float* src, size_t sampleCount, const float gains[4])
+{
+    const __m128 fromLeft = _mm_setr_ps(gains[0], gains[1], gains[0], gains[1]);
+    const __m128 fromRight = _mm_setr_ps(gains[2], gains[3], gains[2], gains[3]);
+    size_t i = 0;
+    for (; i + 2 <= sampleCount; i += 2) {
+        __m128 s = _mm_loadu_ps(src + 2 * i);
+        __m128 left = _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 0, 0));  // l0 l0 l1 l1
+        __m128 right = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 1, 1)); // r0 r0 r1 r1
+
+        float* d = dest + 2 * i;
+        __m128 mixed = _mm_add_ps(_mm_loadu_ps(d), _mm_mul_ps(fromLeft, left));
+        _mm_storeu_ps(d, _mm_add_ps(mixed, _mm_mul_ps(fromRight, right)));
+    }
+    panStereoScalar(dest + 2 * i, src + 2 * i, sampleCount - i, gains);
+}
+
+// ============================================================
+// AVX2, 4 stereo samples per step
+// ============================================================
+
+MU_TARGET_AVX2 static void gainAVX2(float* buffer, size_t count, float gain)
+{
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(buffer + i, _mm256_mul_ps(_mm256_loadu_ps(buffer + i), g));
+    }
+    gainScalar(buffer + i, count - i, gain);
+}
+
+MU_TARGET_AVX2 static void accumulateAVX2(float* dest, const float* src, size_t count, float gain)
+{
+    //! NOTE No FMA here, the rounding must stay the same as in the scalar version
+    const __m256 g = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 d = _mm256_loadu_ps(dest + i);
+        _mm256_storeu_ps(dest + i, _mm256_add_ps(d, _mm256_mul_ps(g, _mm256_loadu_ps(src + i))));
+    }
+    accumulateScalar(dest + i, src + i, count - i, gain);
+}
+
+MU_TARGET_AVX2 static void panMonoAVX2(float* dest, const float* src, size_t sampleCount, float leftGain, float rightGain)
+{
+    const __m256 g = _mm256_setr_ps(leftGain, rightGain, leftGain, rightGain, leftGain, rightGain, leftGain, rightGain);
+    const __m256i loIndex = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i hiIndex = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    size_t i = 0;
+    for (; i + 8 <= sampleCount; i += 8) {
+        __m256 s = _mm256_loadu_ps(src + i);
+        __m256 lo = _mm256_permutevar8x32_ps(s, loIndex);
+        __m256 hi = _mm256_permutevar8x32_ps(s, hiIndex);
+
+        float* d = dest + 2 * i;
+        _mm256_storeu_ps(d, _mm256_add_ps(_mm256_loadu_ps(d), _mm256_mul_ps(g, lo)));
+        _mm256_storeu_ps(d + 8, _mm256_add_ps(_mm256_loadu_ps(d + 8), _mm256_mul_ps(g, hi)));
+    }
+    panMonoScalar(dest + 2 * i, src + i, sampleCount - i, leftGain, rightGain);
+}
+
+MU_TARGET_AVX2 static void panStereoAVX2(float* dest, const float* src, size_t sampleCount, const float gains[4])
+{
+    const __m256 fromLeft = _mm256_setr_ps(gains[0], gains[1], gains[0], gains[1], gains[0], gains[1], gains[0], gains[1]);
+    const __m256 fromRight = _mm256_setr_ps(gains[2], gains[3], gains[2], gains[3], gains[2], gains[3], gains[2], gains[3]);
+    size_t i = 0;
+    for (; i + 4 <= sampleCount; i += 4) {
+        __m256 s = _mm256_loadu_ps(src + 2 * i);
+        __m256 left = _mm256_moveldup_ps(s);  // l0 l0 l1 l1 ...
+        __m256 right = _mm256_movehdup_ps(s); // r0 r0 r1 r1 ...
+
+        float* d = dest + 2 * i;
+        __m256 mixed = _mm256_add_ps(_mm256_loadu_ps(d), _mm256_mul_ps(fromLeft, left));
+        _mm256_storeu_ps(d, _mm256_add_ps(mixed, _mm256_mul_ps(fromRight, right)));
+    }
+    panStereoScalar(dest + 2 * i, src + 2 * i, sampleCount - i, gains);
+}
+
+static bool cpuSupports(MixKernels::Isa isa)
+{
+#ifdef _MSC_VER
+    if (isa == MixKernels::Isa::Scalar) {
+        return true;
+    }
+
+    int info[4] = { 0 };
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (isa == MixKernels::Isa::SSE2) {
+        return sse2;
+    }
+
+    if (!osxsave || !avx || maxLeaf < 7) {
+        return false;
+    }
+    // the OS saves the ymm registers
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    switch (isa) {
+    case MixKernels::Isa::Scalar: return true;
+    case MixKernels::Isa::SSE2: return __builtin_cpu_supports("sse2");
+    case MixKernels::Isa::AVX2: return __builtin_cpu_supports("avx2");
+    }
+    return false;
+#endif
+}
+
+#else
+
+static bool cpuSupports(MixKernels::Isa isa)
+{
+    return isa == MixKernels::Isa::Scalar;
+}
+
+#endif // MU_AUDIO_MIXKERNELS_X86
+
+static MixKernels makeKernels(MixKernels::Isa isa)
+{
+    MixKernels k;
+    k.isa = isa;
+    k.gain = gainScalar;
+    k.accumulate = accumulateScalar;
+    k.panMono = panMonoScalar;
+    k.panStereo = panStereoScalar;
+
+#ifdef MU_AUDIO_MIXKERNELS_X86
+    switch (isa) {
+    case MixKernels::Isa::Scalar:
+        break;
+    case MixKernels::Isa::SSE2:
+        k.gain = gainSSE2;
+        k.accumulate = accumulateSSE2;
+        k.panMono = panMonoSSE2;
+        k.panStereo = panStereoSSE2;
+        break;
+    case MixKernels::Isa::AVX2:
+        k.gain = gainAVX2;
+        k.accumulate = accumulateAVX2;
+        k.panMono = panMonoAVX2;
+        k.panStereo = panStereoAVX2;
+        break;
+    }
+#endif
+
+    return k;
+}
+
+const MixKernels* MixKernels::kernels(Isa isa)
+{
+    static const MixKernels scalar = makeKernels(Isa::Scalar);
+    static const MixKernels sse2 = makeKernels(Isa::SSE2);
+    static const MixKernels avx2 = makeKernels(Isa::AVX2);
+
+    if (!cpuSupports(isa)) {
+        return nullptr;
+    }
+
+    switch (isa) {
+    case Isa::Scalar: return &scalar;
+    case Isa::SSE2: return &sse2;
+    case Isa::AVX2: return &avx2;
+    }
+
+    return nullptr;
+}
+
+const MixKernels& MixKernels::instance()
+{
+    static const MixKernels* best = []() {
+        for (Isa isa : { Isa::AVX2, Isa::SSE2 }) {
+            if (const MixKernels* k = kernels(isa)) {
+                return k;
+            }
+        }
+        return kernels(Isa::Scalar);
+    }();
+
+    return *best;
+}
+
+const char* MixKernels::isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar: return "scalar";
+    case Isa::SSE2: return "sse2";
+    case Isa::AVX2: return "avx2";
+    }
+
+    return "";
+}
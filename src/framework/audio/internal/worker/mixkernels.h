@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_MIXKERNELS_H
+#define MU_AUDIO_MIXKERNELS_H
+
+#include <cstddef>
+
+namespace mu::audio {
+//! Inner loops of the mixer on interleaved float buffers.
+//! Every implementation does the same operations in the same order as the scalar one,
+//! so the result doesn't depend on the selected instruction set.
+struct MixKernels
+{
+    enum class Isa {
+        Scalar = 0,
+        SSE2,
+        AVX2
+    };
+
+    Isa isa = Isa::Scalar;
+
+    //! buffer[i] *= gain, used for channel gain and master level
+    void (* gain)(float* buffer, size_t count, float gain) = nullptr;
+
+    //! dest[i] += gain * src[i]
+    void (* accumulate)(float* dest, const float* src, size_t count, float gain) = nullptr;
+
+    //! mono source into the stereo dest: dest[2i] += leftGain * src[i], dest[2i + 1] += rightGain * src[i]
+    void (* panMono)(float* dest, const float* src, size_t sampleCount, float leftGain, float rightGain) = nullptr;
+
+    //! stereo source into the stereo dest: left source stream is mixed in first, then the right one
+    //! gains = { left to left, left to right, right to left, right to right }
+    void (* panStereo)(float* dest, const float* src, size_t sampleCount, const float gains[4]) = nullptr;
+
+    //! the best implementation supported by this CPU, selected once
+    static const MixKernels& instance();
+
+    //! the implementation for the given set, or nullptr if it is not supported here
+    static const MixKernels* kernels(Isa isa);
+
+    static const char* isaName(Isa isa);
+};
+}
+
+#endif // MU_AUDIO_MIXKERNELS_H
@@ -184,7 +184,7 @@ void Sequencer::timeUpdate()
     bool willcontinue = false;
     for (auto& val : m_tracks) {
         Track& track = val.second;
-        track->forwardTime(m_clock->timeInMiliSeconds());
+        track->forwardSamples(m_clock->time(), m_clock->sampleRate());
         willcontinue |= track->isRunning();
     }
     m_positionChanged.notify();
@@ -0,0 +1,66 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_IOFFLINERENDERER_H
+#define MU_AUDIO_IOFFLINERENDERER_H
+
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+#include "modularity/imoduleexport.h"
+#include "retval.h"
+#include "midi/miditypes.h"
+
+namespace mu::audio {
+//! Renders a midi stream to audio without the audio driver, as fast as the CPU allows.
+//! It has its own synthesizers and mixer, so it doesn't interfere with the playback.
+class IOfflineRenderer : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IOfflineRenderer)
+public:
+    virtual ~IOfflineRenderer() = default;
+
+    struct Options {
+        unsigned int sampleRate = 44100;
+        unsigned int blockSize = 1024;  // samples per block
+        unsigned int tailMsec = 3000;   // rendered after the last event, for releases and reverb
+    };
+
+    struct Stats {
+        uint64_t samples = 0;
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+
+        //! how many times faster than realtime
+        double realtimeFactor() const { return renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0; }
+    };
+
+    //! interleaved stereo block, return false to abort the render
+    using BlockHandler = std::function<bool (const float* data, unsigned int sampleCount)>;
+
+    //! renders in the calling thread, blocks are passed to onBlock as soon as they are ready
+    virtual RetVal<Stats> render(const std::shared_ptr<midi::MidiStream>& stream, const Options& options,
+                                 const BlockHandler& onBlock) = 0;
+};
+}
+
+#endif // MU_AUDIO_IOFFLINERENDERER_H
@@ -49,6 +49,12 @@ public:
 
     virtual Ret setupChannels(const std::vector<midi::Event>& events) = 0;
     virtual bool handleEvent(const midi::Event& e) = 0;
+
+    //! Handles the event sampleOffset samples after the start of the block rendered
+    //! by the next forward(), the rendering is split at the offsets of the events
+    virtual void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) = 0;
+    virtual void clearScheduledEvents() = 0;
+
     virtual void writeBuf(float* stream, unsigned int samples) = 0;
 
     virtual void allSoundsOff() = 0; // all channels
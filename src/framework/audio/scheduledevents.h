@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_SCHEDULEDEVENTS_H
+#define MU_AUDIO_SCHEDULEDEVENTS_H
+
+#include <array>
+#include <algorithm>
+
+#include "midi/miditypes.h"
+
+namespace mu::audio::synth {
+//! Events waiting to be handled at sample offsets inside the next rendered blocks.
+//! A synthesizer renders a block in pieces split at the event offsets, so the timing
+//! of the events does not depend on the block size.
+//! The events are kept in a fixed buffer, so scheduling never allocates on the audio thread.
+class ScheduledEvents
+{
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    //! offset counts from the start of the next rendered block, offsets beyond
+    //! that block carry over to the following ones
+    //! returns false when the buffer is full, the caller should handle the event right away then
+    bool schedule(const midi::Event& e, unsigned int sampleOffset)
+    {
+        if (m_size == CAPACITY) {
+            return false;
+        }
+
+        //! NOTE Events mostly come in order, so this rarely moves anything.
+        //! Events with the same offset keep the order they were scheduled in
+        size_t pos = m_size;
+        while (pos > 0 && m_events[pos - 1].offset > sampleOffset) {
+            m_events[pos] = m_events[pos - 1];
+            --pos;
+        }
+        m_events[pos] = { sampleOffset, e };
+        ++m_size;
+        return true;
+    }
+
+    void clear() { m_size = 0; }
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    //! renders sampleCount samples by render(offset, count), calling handle(event)
+    //! for each due event right before the piece that starts at its offset
+    template<typename Handler, typename Renderer>
+    void render(unsigned int sampleCount, Handler handle, Renderer render)
+    {
+        size_t next = 0;
+        unsigned int position = 0;
+        while (position < sampleCount) {
+            while (next < m_size && m_events[next].offset <= position) {
+                handle(m_events[next].event);
+                ++next;
+            }
+
+            unsigned int end = sampleCount;
+            if (next < m_size && m_events[next].offset < sampleCount) {
+                end = m_events[next].offset;
+            }
+
+            render(position, end - position);
+            position = end;
+        }
+
+        //! NOTE Keep the events of the next blocks, their order does not change
+        std::copy(m_events.begin() + next, m_events.begin() + m_size, m_events.begin());
+        m_size -= next;
+        for (size_t i = 0; i < m_size; ++i) {
+            m_events[i].offset -= sampleCount;
+        }
+    }
+
+private:
+    struct Item {
+        unsigned int offset = 0;
+        midi::Event event;
+    };
+
+    std::array<Item, CAPACITY> m_events;
+    size_t m_size = 0;
+};
+}
+
+#endif // MU_AUDIO_SCHEDULEDEVENTS_H
@@ -0,0 +1,172 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "internal/audiobuffer.h"
+
+using namespace mu::audio;
+
+class AudioBufferTests : public ::testing::Test
+{
+public:
+    static std::vector<float> ramp(unsigned int samples, unsigned int streams, float from)
+    {
+        std::vector<float> data(samples * streams);
+        for (unsigned int i = 0; i < data.size(); ++i) {
+            data[i] = from + i;
+        }
+        return data;
+    }
+};
+
+TEST_F(AudioBufferTests, PushPop_WrapAround)
+{
+    //! GIVEN Buffer with some data already consumed, so the next write wraps around the end
+    AudioBuffer buffer(2, 8192);
+
+    std::vector<float> skip = ramp(6000, 2, 0.f);
+    std::vector<float> out(skip.size());
+    buffer.push(skip.data(), 6000);
+    buffer.pop(out.data(), 6000);
+
+    //! WHEN We write and read a block crossing the end of the storage
+    std::vector<float> in = ramp(4000, 2, 100.f);
+    buffer.push(in.data(), 4000);
+    out.assign(in.size(), -1.f);
+    buffer.pop(out.data(), 4000);
+
+    //! THEN Data is the same and nothing is lost
+    EXPECT_EQ(out, in);
+    EXPECT_EQ(buffer.underrunCount(), 0u);
+    EXPECT_EQ(buffer.overrunCount(), 0u);
+}
+
+TEST_F(AudioBufferTests, Underrun_FillSilence)
+{
+    //! GIVEN Buffer with less data than requested
+    AudioBuffer buffer(2, 8192);
+    std::vector<float> in = ramp(10, 2, 1.f);
+    buffer.push(in.data(), 10);
+
+    //! WHEN We read more than there is
+    std::vector<float> out(32 * 2, -1.f);
+    buffer.pop(out.data(), 32);
+
+    //! THEN Available data is returned, the rest is silence, underrun is counted
+    EXPECT_TRUE(std::equal(in.begin(), in.end(), out.begin()));
+    for (size_t i = in.size(); i < out.size(); ++i) {
+        EXPECT_EQ(out[i], 0.f);
+    }
+    EXPECT_EQ(buffer.underrunCount(), 1u);
+}
+
+TEST_F(AudioBufferTests, Underrun_RepeatLastBlock)
+{
+    //! GIVEN Buffer with repeat policy and one delivered block
+    AudioBuffer buffer(1, 8192);
+    buffer.setUnderrunPolicy(IAudioBuffer::UnderrunPolicy::RepeatLastBlock);
+
+    std::vector<float> in = { 1.f, 2.f, 3.f, 4.f };
+    buffer.push(in.data(), 4);
+    std::vector<float> out(4);
+    buffer.pop(out.data(), 4);
+
+    //! WHEN The buffer is empty
+    std::vector<float> repeated(6, -1.f);
+    buffer.pop(repeated.data(), 6);
+
+    //! THEN The last delivered block is repeated
+    std::vector<float> expected = { 1.f, 2.f, 3.f, 4.f, 1.f, 2.f };
+    EXPECT_EQ(repeated, expected);
+    EXPECT_EQ(buffer.underrunCount(), 1u);
+}
+
+TEST_F(AudioBufferTests, Overrun_Counted)
+{
+    //! GIVEN Buffer that is almost full
+    AudioBuffer buffer(1, 8192);
+    std::vector<float> in = ramp(8192, 1, 0.f);
+    buffer.push(in.data(), 8000);
+
+    //! WHEN We push more than fits
+    buffer.push(in.data(), 1000);
+
+    //! THEN Only the free space is written and overrun is counted
+    EXPECT_EQ(buffer.overrunCount(), 1u);
+
+    std::vector<float> out(8192, -1.f);
+    buffer.pop(out.data(), 8192);
+    EXPECT_EQ(buffer.underrunCount(), 0u);
+}
+
+TEST_F(AudioBufferTests, ProducerConsumer_Threads)
+{
+    //! GIVEN Producer and consumer in separate threads, the producer never writes more than fits
+    AudioBuffer buffer(1, 8192);
+    const unsigned int total = 1 << 20;
+    const unsigned int block = 256;
+    std::atomic<unsigned int> consumed = { 0 };
+
+    std::thread producer([&]() {
+        std::vector<float> in(block);
+        unsigned int written = 0;
+        while (written < total) {
+            if (written + block - consumed.load() > 8192) {
+                std::this_thread::yield();
+                continue;
+            }
+            //! NOTE values start from 1, zero is the padding of an underrun
+            for (unsigned int i = 0; i < block; ++i) {
+                in[i] = static_cast<float>((written + i) % 65536 + 1);
+            }
+            buffer.push(in.data(), block);
+            written += block;
+        }
+    });
+
+    //! WHEN Consumer reads everything
+    std::vector<float> out(block);
+    unsigned int expected = 0;
+    bool ordered = true;
+    while (expected < total) {
+        buffer.pop(out.data(), block);
+        for (unsigned int i = 0; i < block; ++i) {
+            if (out[i] == 0.f) {
+                continue;
+            }
+            ordered = ordered && out[i] == static_cast<float>(expected % 65536 + 1);
+            ++expected;
+        }
+        consumed.store(expected);
+    }
+
+    producer.join();
+
+    //! THEN Every sample came exactly once and in order
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(expected, total);
+    EXPECT_EQ(buffer.overrunCount(), 0u);
+}
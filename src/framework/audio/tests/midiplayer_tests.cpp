@@ -0,0 +1,549 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/midiplayer.h"
+#include "internal/synthesizers/synthesizersregister.h"
+#include "scheduledevents.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+
+class MidiPlayerTests : public ::testing::Test
+{
+public:
+    //! mono synth that writes a single 1.0 sample where a note starts
+    class ClickSynth : public ISynthesizer
+    {
+    public:
+        bool isValid() const override { return true; }
+        std::string name() const override { return "Click"; }
+        SoundFontFormats soundFontFormats() const override { return {}; }
+
+        Ret init() override { return make_ret(Ret::Code::Ok); }
+        Ret addSoundFonts(const std::vector<io::path>&) override { return make_ret(Ret::Code::Ok); }
+        Ret removeSoundFonts() override { return make_ret(Ret::Code::Ok); }
+
+        bool isActive() const override { return true; }
+        void setIsActive(bool) override {}
+
+        Ret setupChannels(const std::vector<Event>&) override { return make_ret(Ret::Code::Ok); }
+        bool handleEvent(const Event& e) override
+        {
+            if (e.opcode() == Event::Opcode::NoteOn) {
+                m_noteStarted = true;
+                ++m_noteOnCount;
+            }
+            return true;
+        }
+
+        void scheduleEvent(const Event& e, unsigned int sampleOffset) override
+        {
+            if (!m_scheduledEvents.schedule(e, sampleOffset)) {
+                handleEvent(e);
+            }
+        }
+        void clearScheduledEvents() override { m_scheduledEvents.clear(); }
+
+        void writeBuf(float* stream, unsigned int samples) override
+        {
+            std::fill(stream, stream + samples, 0.f);
+            if (m_noteStarted) {
+                stream[0] = 1.f;
+                m_noteStarted = false;
+            }
+        }
+
+        void allSoundsOff() override {}
+        void flushSound() override {}
+        void channelSoundsOff(channel_t) override {}
+        bool channelVolume(channel_t, float) override { return true; }
+        bool channelBalance(channel_t, float) override { return true; }
+        bool channelPitch(channel_t, int16_t) override { return true; }
+
+        void setSampleRate(unsigned int) override {}
+        unsigned int streamCount() const override { return 1; }
+        async::Channel<unsigned int> streamsCountChanged() const override { return m_streamsCountChanged; }
+        const float* data() const override { return m_buffer.data(); }
+        void setBufferSize(unsigned int samples) override { m_buffer.resize(samples); }
+
+        void forward(unsigned int sampleCount) override
+        {
+            m_scheduledEvents.render(sampleCount, [this](const Event& e) {
+                handleEvent(e);
+            }, [this](unsigned int offset, unsigned int count) {
+                writeBuf(m_buffer.data() + offset, count);
+            });
+        }
+
+        size_t noteOnCount() const { return m_noteOnCount; }
+
+    private:
+        ScheduledEvents m_scheduledEvents;
+        std::vector<float> m_buffer;
+        async::Channel<unsigned int> m_streamsCountChanged;
+        bool m_noteStarted = false;
+        size_t m_noteOnCount = 0;
+    };
+
+    class NoMidiPortDataSender : public IMidiPortDataSender
+    {
+    public:
+        void setMidiStream(std::shared_ptr<MidiStream>) override {}
+        bool sendEvents(tick_t, tick_t) override { return true; }
+        bool sendSingleEvent(const Event&) override { return true; }
+    };
+
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    static Event noteOn(uint8_t note)
+    {
+        Event e(Event::Opcode::NoteOn);
+        e.setChannel(0);
+        e.setNote(note);
+        e.setVelocity(64);
+        return e;
+    }
+
+    //! 120 bpm, 50 samples per tick at 48 kHz, from tick 2000 240 bpm, 25 samples per tick
+    static std::shared_ptr<MidiStream> makeStream(const std::vector<tick_t>& onsets)
+    {
+        std::shared_ptr<MidiStream> stream = std::make_shared<MidiStream>();
+        MidiData& data = stream->initData;
+        data.division = 480;
+        data.tempoMap = { { 0, 500000 }, { 2000, 250000 } };
+        data.synthMap = { { 0, "Click" } };
+
+        Event program(Event::Opcode::ProgramChange);
+        program.setChannel(0);
+        data.initEvents.push_back(program);
+        data.tracks.push_back({ 0, { 0 } });
+
+        Chunk chunk;
+        chunk.beginTick = 0;
+        chunk.endTick = 4000;
+        for (tick_t tick : onsets) {
+            chunk.events.insert({ tick, noteOn(60) });
+        }
+        data.chunks.insert({ chunk.beginTick, chunk });
+
+        stream->lastTick = chunk.endTick;
+        return stream;
+    }
+
+    //! notes on every tick, split into chunks of chunkTicks like the notation playback does
+    static std::shared_ptr<MidiStream> makeDenseStream(tick_t lastTick, int notesPerTick, tick_t chunkTicks)
+    {
+        std::shared_ptr<MidiStream> stream = makeStream({});
+        MidiData& data = stream->initData;
+        data.tempoMap = { { 0, 500000 } };
+        data.chunks.clear();
+
+        for (tick_t begin = 0; begin < lastTick; begin += chunkTicks) {
+            Chunk chunk;
+            chunk.beginTick = begin;
+            chunk.endTick = begin + chunkTicks;
+            for (tick_t tick = begin; tick < chunk.endTick; ++tick) {
+                for (int n = 0; n < notesPerTick; ++n) {
+                    chunk.events.insert({ tick, noteOn(40 + n) });
+                }
+            }
+            data.chunks.insert({ chunk.beginTick, std::move(chunk) });
+        }
+
+        stream->lastTick = lastTick;
+        return stream;
+    }
+
+    static uint64_t expectedSample(tick_t tick)
+    {
+        if (tick <= 2000) {
+            return tick * 50;
+        }
+        return 2000 * 50 + (tick - 2000) * 25;
+    }
+
+    //! renders the stream block by block like the sequencer and the mixer do,
+    //! returns the positions of the clicks
+    static std::vector<uint64_t> renderOnsets(const std::shared_ptr<MidiStream>& stream, unsigned int blockSize)
+    {
+        std::shared_ptr<ClickSynth> synth = std::make_shared<ClickSynth>();
+        synth->setBufferSize(blockSize);
+
+        std::shared_ptr<SynthesizersRegister> synthesizers = std::make_shared<SynthesizersRegister>();
+        synthesizers->registerSynthesizer("Click", synth);
+        synthesizers->setDefaultSynthesizer("Click");
+
+        MIDIPlayer player;
+        player.setsynthesizersRegister(synthesizers);
+        player.setmidiPortDataSender(std::make_shared<NoMidiPortDataSender>());
+        player.loadMIDI(stream);
+        player.run();
+
+        std::vector<uint64_t> onsets;
+        uint64_t position = 0;
+        while (position < expectedSample(stream->lastTick)) {
+            player.forwardSamples(position + blockSize, SAMPLE_RATE);
+            synth->forward(blockSize);
+
+            const float* data = synth->data();
+            for (unsigned int i = 0; i < blockSize; ++i) {
+                if (data[i] > 0.f) {
+                    onsets.push_back(position + i);
+                }
+            }
+            position += blockSize;
+        }
+        return onsets;
+    }
+
+    static constexpr unsigned int SAMPLE_RATE = 48000;
+};
+
+TEST_F(MidiPlayerTests, ScheduledEvents_SplitBlockAtOffsets)
+{
+    //! GIVEN Events at the start, inside and beyond the block
+    ScheduledEvents events;
+    events.schedule(noteOn(62), 40);
+    events.schedule(noteOn(60), 0);
+    events.schedule(noteOn(61), 10);
+    events.schedule(noteOn(63), 70);
+
+    //! WHEN A block of 64 samples is rendered
+    std::vector<std::pair<unsigned int, unsigned int> > pieces;
+    std::vector<int> notes;
+    events.render(64, [&notes](const Event& e) {
+        notes.push_back(e.note());
+    }, [&pieces](unsigned int offset, unsigned int count) {
+        pieces.push_back({ offset, count });
+    });
+
+    //! THEN The block is split at the offsets and the events are handled in their order
+    std::vector<std::pair<unsigned int, unsigned int> > expectedPieces = { { 0, 10 }, { 10, 30 }, { 40, 24 } };
+    EXPECT_EQ(pieces, expectedPieces);
+    EXPECT_EQ(notes, std::vector<int>({ 60, 61, 62 }));
+
+    //! THEN The later event carries over to the next block
+    pieces.clear();
+    notes.clear();
+    events.render(64, [&notes](const Event& e) {
+        notes.push_back(e.note());
+    }, [&pieces](unsigned int offset, unsigned int count) {
+        pieces.push_back({ offset, count });
+    });
+
+    expectedPieces = { { 0, 6 }, { 6, 58 } };
+    EXPECT_EQ(pieces, expectedPieces);
+    EXPECT_EQ(notes, std::vector<int>({ 63 }));
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(MidiPlayerTests, ScheduledEvents_FullBufferRejectsEvents)
+{
+    //! GIVEN A full buffer of events in reverse order
+    ScheduledEvents events;
+    for (size_t i = 0; i < ScheduledEvents::CAPACITY; ++i) {
+        EXPECT_TRUE(events.schedule(noteOn(60 + i % 2), static_cast<unsigned int>(ScheduledEvents::CAPACITY - i)));
+    }
+
+    //! WHEN One more event is scheduled
+    //! THEN It is rejected and the buffer keeps its events
+    EXPECT_FALSE(events.schedule(noteOn(62), 0));
+    EXPECT_EQ(events.size(), ScheduledEvents::CAPACITY);
+
+    //! WHEN The blocks are rendered
+    std::vector<unsigned int> offsets;
+    unsigned int blockStart = 0;
+    for (int block = 0; block < 32; ++block) {
+        events.render(64, [](const Event&) {}, [&offsets, blockStart](unsigned int offset, unsigned int) {
+            offsets.push_back(blockStart + offset);
+        });
+        blockStart += 64;
+    }
+
+    //! THEN All events are handled, sorted by their offset, and the buffer is free again
+    EXPECT_TRUE(events.empty());
+    EXPECT_TRUE(std::is_sorted(offsets.begin(), offsets.end()));
+    EXPECT_EQ(std::count_if(offsets.begin(), offsets.end(), [](unsigned int offset) { return offset % 64 != 0; }),
+              static_cast<std::ptrdiff_t>(ScheduledEvents::CAPACITY - ScheduledEvents::CAPACITY / 64));
+    EXPECT_TRUE(events.schedule(noteOn(62), 0));
+}
+
+TEST_F(MidiPlayerTests, NoteOnsets_SampleAccurate)
+{
+    //! GIVEN Notes on ticks that fall inside blocks of any size, before and after a tempo change
+    std::vector<tick_t> ticks = { 0, 1, 100, 1000, 1001, 1999, 2000, 2001, 3000, 3333 };
+    std::shared_ptr<MidiStream> stream = makeStream(ticks);
+
+    std::vector<uint64_t> expected;
+    for (tick_t tick : ticks) {
+        expected.push_back(expectedSample(tick));
+    }
+
+    //! WHEN The stream is rendered with different block sizes
+    //! THEN Each note starts exactly at the sample of its tick
+    for (unsigned int blockSize : { 64u, 100u, 1024u, 4096u }) {
+        EXPECT_EQ(renderOnsets(stream, blockSize), expected) << "block size " << blockSize;
+    }
+}
+
+TEST_F(MidiPlayerTests, Seek_Forward_PlaysFromNewPosition)
+{
+    //! GIVEN A player that has played the first blocks of a stream
+    std::shared_ptr<MidiStream> stream = makeStream({ 100, 500, 1000, 1001 });
+    const unsigned int blockSize = 512;
+
+    std::shared_ptr<ClickSynth> synth = std::make_shared<ClickSynth>();
+    synth->setBufferSize(blockSize);
+
+    std::shared_ptr<SynthesizersRegister> synthesizers = std::make_shared<SynthesizersRegister>();
+    synthesizers->registerSynthesizer("Click", synth);
+    synthesizers->setDefaultSynthesizer("Click");
+
+    MIDIPlayer player;
+    player.setsynthesizersRegister(synthesizers);
+    player.setmidiPortDataSender(std::make_shared<NoMidiPortDataSender>());
+    player.loadMIDI(stream);
+    player.run();
+
+    uint64_t position = 0;
+    for (; position < 20 * blockSize; position += blockSize) {
+        player.forwardSamples(position + blockSize, SAMPLE_RATE);
+        synth->forward(blockSize);
+    }
+    EXPECT_EQ(synth->noteOnCount(), 1u);
+
+    //! WHEN It seeks forward, and the clock continues from the new position
+    player.seek(1000);
+    position = SAMPLE_RATE;
+
+    std::vector<uint64_t> onsets;
+    for (int block = 0; block < 20; ++block, position += blockSize) {
+        player.forwardSamples(position + blockSize, SAMPLE_RATE);
+        synth->forward(blockSize);
+
+        //! THEN The player time follows the clock from the new position
+        EXPECT_EQ(player.milliseconds(), (position + blockSize) * 1000 / SAMPLE_RATE);
+
+        const float* data = synth->data();
+        for (unsigned int i = 0; i < blockSize; ++i) {
+            if (data[i] > 0.f) {
+                onsets.push_back(position + i);
+            }
+        }
+    }
+
+    //! THEN The notes after the new position start at the sample of their tick
+    EXPECT_EQ(onsets, std::vector<uint64_t>({ expectedSample(1000), expectedSample(1001) }));
+}
+
+TEST_F(MidiPlayerTests, EventTimeline_SortedSnapshots)
+{
+    //! GIVEN A timeline with the first chunk
+    EventTimeline timeline;
+    Chunks chunks;
+    Chunk first;
+    first.beginTick = 0;
+    first.endTick = 100;
+    first.events.insert({ 50, noteOn(60) });
+    first.events.insert({ 10, noteOn(61) });
+    first.events.insert({ 10, Event::NOOP() });
+    chunks.insert({ first.beginTick, first });
+    timeline.reset(chunks);
+
+    TimelineSnapshotPtr snapshot = timeline.snapshot();
+    uint64_t revision = timeline.revision();
+
+    //! WHEN Chunks are added out of order, one of them twice
+    Chunk third;
+    third.beginTick = 200;
+    third.endTick = 300;
+    third.events.insert({ 250, noteOn(62) });
+    timeline.add(third);
+
+    Chunk second;
+    second.beginTick = 100;
+    second.endTick = 200;
+    timeline.add(second);
+    timeline.add(second);
+    timeline.add(Chunk());
+
+    //! THEN The snapshot taken before stays the same
+    ASSERT_EQ(snapshot->chunks.size(), 1u);
+
+    //! THEN The new snapshot has the chunks in the tick order
+    TimelineSnapshotPtr current = timeline.snapshot();
+    EXPECT_GT(timeline.revision(), revision);
+    ASSERT_EQ(current->chunks.size(), 3u);
+    EXPECT_EQ(current->chunks[0]->beginTick, 0);
+    EXPECT_EQ(current->chunks[1]->beginTick, 100);
+    EXPECT_EQ(current->chunks[2]->beginTick, 200);
+
+    //! THEN The events of a chunk are flat and sorted
+    const ChunkTimeline& chunk = *current->chunks[0];
+    EXPECT_EQ(chunk.ticks, std::vector<tick_t>({ 10, 10, 50 }));
+    EXPECT_EQ(chunk.kinds[0], ChunkTimeline::Kind::NoteOn);
+    EXPECT_EQ(chunk.kinds[1], ChunkTimeline::Kind::Noop);
+    EXPECT_EQ(chunk.lowerBound(11), 2u);
+
+    EXPECT_EQ(current->chunkIndex(150), 1u);
+    EXPECT_EQ(current->validTick(0, 1000), 300);
+    EXPECT_EQ(current->validTick(0, 50), 100);
+}
+
+TEST_F(MidiPlayerTests, EventTimeline_WriterFreesRetiredSnapshots)
+{
+    auto chunkAt = [](tick_t beginTick) {
+        Chunk chunk;
+        chunk.beginTick = beginTick;
+        chunk.endTick = beginTick + 100;
+        chunk.events.insert({ beginTick, noteOn(60) });
+        return chunk;
+    };
+
+    //! GIVEN The reader uses the first snapshot
+    EventTimeline timeline;
+    timeline.reset(Chunks());
+    const TimelineSnapshot* inUse = timeline.acquire();
+    std::weak_ptr<const TimelineSnapshot> first = timeline.snapshot();
+    EXPECT_EQ(inUse, first.lock().get());
+
+    //! WHEN The writer publishes two snapshots
+    timeline.add(chunkAt(0));
+    std::weak_ptr<const TimelineSnapshot> second = timeline.snapshot();
+    timeline.add(chunkAt(100));
+
+    //! THEN The snapshot in use is kept, the one the reader never took is freed
+    EXPECT_FALSE(first.expired());
+    EXPECT_TRUE(second.expired());
+    EXPECT_EQ(timeline.retiredCount(), 1u);
+
+    //! WHEN The reader acquires the latest snapshot and the writer publishes again
+    inUse = timeline.acquire();
+    EXPECT_EQ(inUse, timeline.snapshot().get());
+    EXPECT_EQ(inUse->chunks.size(), 2u);
+    timeline.add(chunkAt(200));
+
+    //! THEN The first snapshot is freed by the writer
+    EXPECT_TRUE(first.expired());
+    EXPECT_EQ(timeline.retiredCount(), 1u);
+
+    //! WHEN The reader releases its snapshot
+    timeline.release();
+    timeline.add(chunkAt(300));
+
+    //! THEN Only the latest snapshot is left
+    EXPECT_EQ(timeline.retiredCount(), 0u);
+}
+
+TEST_F(MidiPlayerTests, EventTimeline_ConcurrentReader)
+{
+    //! GIVEN A reader thread that acquires snapshots while the chunks are added
+    EventTimeline timeline;
+    timeline.reset(Chunks());
+    const tick_t chunkCount = 2000;
+
+    std::atomic<bool> done { false };
+    std::atomic<bool> ordered { true };
+    std::thread reader([&]() {
+        size_t prevSize = 0;
+        while (!done) {
+            const TimelineSnapshot* snapshot = timeline.acquire();
+            tick_t prevTick = -1;
+            for (const ChunkTimelinePtr& chunk : snapshot->chunks) {
+                if (chunk->beginTick <= prevTick || chunk->ticks.front() != chunk->beginTick) {
+                    ordered = false;
+                }
+                prevTick = chunk->beginTick;
+            }
+            if (snapshot->chunks.size() < prevSize) {
+                ordered = false;
+            }
+            prevSize = snapshot->chunks.size();
+        }
+    });
+
+    //! WHEN The writer adds the chunks
+    for (tick_t i = 0; i < chunkCount; ++i) {
+        Chunk chunk;
+        chunk.beginTick = i * 10;
+        chunk.endTick = chunk.beginTick + 10;
+        chunk.events.insert({ chunk.beginTick, noteOn(60) });
+        timeline.add(chunk);
+    }
+    done = true;
+    reader.join();
+
+    //! THEN The reader always saw complete, sorted snapshots
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(timeline.snapshot()->chunks.size(), static_cast<size_t>(chunkCount));
+    EXPECT_LE(timeline.retiredCount(), 1u);
+}
+
+TEST_F(MidiPlayerTests, DISABLED_SendEvents_Benchmark)
+{
+    //! NOTE Measures how many events per second the player dispatches to the synthesizer,
+    //! run with --gtest_also_run_disabled_tests, the results are recorded as test properties
+    const tick_t lastTick = 480 * 4 * 20;
+    const tick_t chunkTicks = 480 * 4 * 4;
+
+    for (int notesPerTick : { 1, 8, 32 }) {
+        std::shared_ptr<MidiStream> stream = makeDenseStream(lastTick, notesPerTick, chunkTicks);
+        const size_t eventCount = static_cast<size_t>(lastTick) * notesPerTick;
+
+        std::shared_ptr<ClickSynth> synth = std::make_shared<ClickSynth>();
+        std::shared_ptr<SynthesizersRegister> synthesizers = std::make_shared<SynthesizersRegister>();
+        synthesizers->registerSynthesizer("Click", synth);
+        synthesizers->setDefaultSynthesizer("Click");
+
+        MIDIPlayer player;
+        player.setsynthesizersRegister(synthesizers);
+        player.setmidiPortDataSender(std::make_shared<NoMidiPortDataSender>());
+        player.loadMIDI(stream);
+        player.run();
+
+        auto start = std::chrono::steady_clock::now();
+        unsigned long msec = 0;
+        while (player.isRunning()) {
+            msec += 10;
+            player.forwardTime(msec);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EXPECT_EQ(synth->noteOnCount(), eventCount);
+
+        RecordProperty("events_per_sec_" + std::to_string(notesPerTick) + "_notes_per_tick",
+                       std::to_string(eventCount / elapsed.count()));
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/mixer.h"
+
+using namespace mu::audio;
+
+class MixerTests : public ::testing::Test
+{
+public:
+    //! stereo source with some work per sample, like a small synth
+    class TestSource : public AbstractAudioSource
+    {
+    public:
+        explicit TestSource(float frequency)
+            : m_frequency(frequency) {}
+
+        unsigned int streamCount() const override { return 2; }
+
+        void forward(unsigned int sampleCount) override
+        {
+            for (unsigned int i = 0; i < sampleCount; ++i) {
+                float value = 0.f;
+                for (int h = 1; h <= HARMONICS; ++h) {
+                    value += std::sin(m_phase * h) / h;
+                }
+                m_phase += m_frequency;
+                m_buffer[i * 2] = value;
+                m_buffer[i * 2 + 1] = -value;
+            }
+        }
+
+    private:
+        static constexpr int HARMONICS = 8;
+        float m_frequency = 0.f;
+        float m_phase = 0.f;
+    };
+
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    static std::shared_ptr<Mixer> makeMixer(unsigned int channelCount, unsigned int renderThreads)
+    {
+        std::shared_ptr<Mixer> mixer = std::make_shared<Mixer>();
+        mixer->setBufferSize(BLOCK_SIZE);
+        for (unsigned int i = 0; i < channelCount; ++i) {
+            IMixer::ChannelID id = mixer->addChannel(std::make_shared<TestSource>(0.01f + 0.003f * i));
+            mixer->setLevel(id, 0, 0.5f + 0.01f * i);
+            mixer->setBalance(id, 1, 0.3f);
+        }
+        mixer->setLevel(0.8f);
+        mixer->setRenderThreadCount(renderThreads);
+        return mixer;
+    }
+
+    static constexpr unsigned int BLOCK_SIZE = 1024;
+};
+
+TEST_F(MixerTests, ParallelRender_SameAsSerial)
+{
+    //! GIVEN Two mixers with the same channels, one renders serially, another one on 4 threads
+    std::shared_ptr<Mixer> serial = makeMixer(13, 0);
+    std::shared_ptr<Mixer> parallel = makeMixer(13, 4);
+
+    //! WHEN Both render several blocks
+    //! THEN The output is bit identical
+    for (int block = 0; block < 16; ++block) {
+        serial->forward(BLOCK_SIZE);
+        parallel->forward(BLOCK_SIZE);
+        EXPECT_EQ(std::memcmp(serial->data(), parallel->data(), BLOCK_SIZE * 2 * sizeof(float)), 0);
+    }
+}
+
+TEST_F(MixerTests, DISABLED_ParallelRender_Benchmark)
+{
+    //! NOTE Records how the render time of one block scales with the channel count,
+    //! run with --gtest_also_run_disabled_tests
+    const unsigned int threads = std::max(2u, std::thread::hardware_concurrency());
+    const int blocks = 16;
+    RecordProperty("threads", std::to_string(threads));
+
+    for (unsigned int channels : { 1u, 4u, 16u, 40u, 64u }) {
+        double results[2] = { 0.0, 0.0 };
+        for (int mode = 0; mode < 2; ++mode) {
+            std::shared_ptr<Mixer> mixer = makeMixer(channels, mode == 0 ? 0 : threads);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int block = 0; block < blocks; ++block) {
+                mixer->forward(BLOCK_SIZE);
+            }
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            results[mode] = elapsed.count() / blocks;
+        }
+
+        const std::string key = "channels" + std::to_string(channels);
+        RecordProperty(key + "_serialUsPerBlock", std::to_string(results[0]));
+        RecordProperty(key + "_parallelUsPerBlock", std::to_string(results[1]));
+        RecordProperty(key + "_speedup", std::to_string(results[0] / results[1]));
+    }
+}
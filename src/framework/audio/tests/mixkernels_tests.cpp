@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "internal/worker/mixkernels.h"
+
+using namespace mu::audio;
+
+class MixKernelsTests : public ::testing::Test
+{
+public:
+    static std::vector<float> signal(size_t count, float seed)
+    {
+        std::vector<float> data(count);
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = seed * static_cast<float>((i * 7919) % 1000) / 1000.f - 0.5f;
+        }
+        return data;
+    }
+
+    static std::vector<MixKernels::Isa> isaList()
+    {
+        return { MixKernels::Isa::Scalar, MixKernels::Isa::SSE2, MixKernels::Isa::AVX2 };
+    }
+
+    //! odd size, so every implementation also goes through its tail
+    static constexpr size_t SAMPLES = 1031;
+};
+
+TEST_F(MixKernelsTests, AllIsa_SameAsScalar)
+{
+    const MixKernels* scalar = MixKernels::kernels(MixKernels::Isa::Scalar);
+    ASSERT_TRUE(scalar);
+
+    const float gains[4] = { 0.9f, 0.1f, 0.25f, 0.75f };
+    std::vector<float> mono = signal(SAMPLES, 0.7f);
+    std::vector<float> stereo = signal(SAMPLES * 2, 1.3f);
+
+    for (MixKernels::Isa isa : isaList()) {
+        const MixKernels* k = MixKernels::kernels(isa);
+        if (!k) {
+            continue;
+        }
+
+        //! GIVEN The same input for the scalar and the tested kernels
+        std::vector<float> expected = signal(SAMPLES * 2, 0.5f);
+        std::vector<float> actual = expected;
+
+        //! WHEN We run every kernel
+        scalar->gain(expected.data(), expected.size(), 0.8f);
+        k->gain(actual.data(), actual.size(), 0.8f);
+
+        scalar->accumulate(expected.data(), stereo.data(), expected.size(), 0.3f);
+        k->accumulate(actual.data(), stereo.data(), actual.size(), 0.3f);
+
+        scalar->panMono(expected.data(), mono.data(), SAMPLES, 0.6f, 0.4f);
+        k->panMono(actual.data(), mono.data(), SAMPLES, 0.6f, 0.4f);
+
+        scalar->panStereo(expected.data(), stereo.data(), SAMPLES, gains);
+        k->panStereo(actual.data(), stereo.data(), SAMPLES, gains);
+
+        //! THEN The result is bit identical
+        EXPECT_EQ(std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)), 0)
+            << MixKernels::isaName(isa);
+    }
+}
+
+TEST_F(MixKernelsTests, Instance_IsSupported)
+{
+    const MixKernels& k = MixKernels::instance();
+    EXPECT_TRUE(MixKernels::kernels(k.isa) != nullptr);
+    EXPECT_TRUE(k.gain && k.accumulate && k.panMono && k.panStereo);
+}
+
+TEST_F(MixKernelsTests, DISABLED_Benchmark)
+{
+    //! NOTE Records ns per stereo sample of every kernel for every supported instruction set,
+    //! run with --gtest_also_run_disabled_tests
+    const size_t samples = 1024;
+    const int repeats = 2000;
+    const float gains[4] = { 0.9f, 0.1f, 0.25f, 0.75f };
+
+    std::vector<float> mono = signal(samples, 0.7f);
+    std::vector<float> stereo = signal(samples * 2, 1.3f);
+    std::vector<float> dest(samples * 2, 0.f);
+
+    auto measure = [&](const std::function<void()>& func) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            func();
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (static_cast<double>(repeats) * samples);
+    };
+
+    for (MixKernels::Isa isa : isaList()) {
+        const MixKernels* k = MixKernels::kernels(isa);
+        if (!k) {
+            continue;
+        }
+
+        double gain = measure([&]() { k->gain(dest.data(), dest.size(), 0.999f); });
+        double accumulate = measure([&]() { k->accumulate(dest.data(), stereo.data(), dest.size(), 0.5f); });
+        double panMono = measure([&]() { k->panMono(dest.data(), mono.data(), samples, 0.6f, 0.4f); });
+        double panStereo = measure([&]() { k->panStereo(dest.data(), stereo.data(), samples, gains); });
+
+        const std::string isaName = MixKernels::isaName(isa);
+        RecordProperty(isaName + "_gainNsPerSample", std::to_string(gain));
+        RecordProperty(isaName + "_accumulateNsPerSample", std::to_string(accumulate));
+        RecordProperty(isaName + "_panMonoNsPerSample", std::to_string(panMono));
+        RecordProperty(isaName + "_panStereoNsPerSample", std::to_string(panStereo));
+    }
+}
@@ -0,0 +1,627 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "internal/synthesizers/zerberus/internal/channel.h"
+#include "internal/synthesizers/zerberus/internal/instrument.h"
+#include "internal/synthesizers/zerberus/internal/sample.h"
+#include "internal/synthesizers/zerberus/internal/samplestreamer.h"
+#include "internal/synthesizers/zerberus/internal/voice.h"
+#include "internal/synthesizers/zerberus/internal/zerberus.h"
+#include "internal/synthesizers/zerberus/internal/zone.h"
+
+using namespace mu::zerberus;
+
+class ZerberusTests : public ::testing::Test
+{
+public:
+    static Zone* makeZone(int keyLo, int keyHi, int veloLo, int veloHi, Trigger trigger)
+    {
+        Zone* z = new Zone;
+        z->keyLo = keyLo;
+        z->keyHi = keyHi;
+        z->keyBase = keyLo;
+        z->veloLo = veloLo;
+        z->veloHi = veloHi;
+        z->trigger = trigger;
+        z->sample = new Sample(0, new short[SAMPLE_FRAMES](), SAMPLE_FRAMES, 44100);
+        return z;
+    }
+
+    //! piano like: every two keys have velocity layers of round robin zones and release zones,
+    //! a zone plays while the modulation wheel is up and a CC triggered zone for the pedal
+    static ZInstrument* makeInstrument(Zerberus* zerberus, int velocityLayers, int roundRobin)
+    {
+        ZInstrument* instrument = new ZInstrument(zerberus);
+        for (int key = 21; key <= 108; key += 2) {
+            for (int layer = 0; layer < velocityLayers; ++layer) {
+                int veloLo = layer * 128 / velocityLayers;
+                int veloHi = (layer + 1) * 128 / velocityLayers - 1;
+                for (int rr = 0; rr < roundRobin; ++rr) {
+                    Zone* z = makeZone(key, key + 1, veloLo, veloHi, Trigger::ATTACK);
+                    z->seqLen = roundRobin - 1;
+                    z->seqPos = rr;
+                    instrument->addZone(z);
+                }
+                instrument->addZone(makeZone(key, key + 1, veloLo, veloHi, Trigger::RELEASE));
+            }
+        }
+
+        Zone* modulation = makeZone(60, 72, 32, 127, Trigger::ATTACK);
+        modulation->useCC = true;
+        modulation->locc[1] = 64;
+        modulation->ccConditions.push_back(1);
+        instrument->addZone(modulation);
+
+        Zone* pedal = makeZone(0, 127, 0, 127, Trigger::CC);
+        pedal->onLocc[64] = 64;
+        pedal->onHicc[64] = 127;
+        instrument->addZone(pedal);
+
+        instrument->buildZoneIndex();
+        return instrument;
+    }
+
+    static std::map<const Zone*, int> zonePositions(const ZInstrument* instrument)
+    {
+        std::map<const Zone*, int> positions;
+        for (const Zone* z : instrument->zones()) {
+            positions.insert({ z, int(positions.size()) });
+        }
+        return positions;
+    }
+
+    struct Note {
+        int key = 0;
+        int velo = 0;
+        Trigger trigger = Trigger::ATTACK;
+        double random = 0.0;
+    };
+
+    static std::vector<Note> makeChords(int chordCount, int chordSize)
+    {
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int> root(21, 96);
+        std::uniform_int_distribution<int> velo(1, 127);
+        std::uniform_int_distribution<int> interval(1, 4);
+
+        std::vector<Note> notes;
+        for (int c = 0; c < chordCount; ++c) {
+            int key = root(gen);
+            for (int n = 0; n < chordSize && key <= 108; ++n) {
+                Trigger trigger = c % 2 ? Trigger::RELEASE : Trigger::ATTACK;
+                notes.push_back({ key, velo(gen), trigger, double(gen()) / gen.max() });
+                key += interval(gen);
+            }
+        }
+        return notes;
+    }
+
+    //! a decaying tone of a few partials
+    static short tone(int frame, int channel)
+    {
+        double t = double(frame) / 44100;
+        double v = 0.5 * std::sin(2 * M_PI * 220 * t) + 0.25 * std::sin(2 * M_PI * (661 + 3 * channel) * t)
+                   + 0.1 * std::sin(2 * M_PI * 2750 * t);
+        return short(v * std::exp(-t) * 32000);
+    }
+
+    //! a zone with the tone, looped in the middle, with all envelope stages
+    static Zone* makeRenderZone(int channels, LoopMode loopMode, FilterType filterType)
+    {
+        static const int frames = 20000;
+        short* data = new short[(frames + 4) * channels]();
+        for (int f = 0; f < frames; ++f) {
+            for (int c = 0; c < channels; ++c) {
+                data[channels + f * channels + c] = tone(f, c);
+            }
+        }
+
+        return makeRenderZone(new Sample(channels, data, frames, 44100), loopMode, filterType);
+    }
+
+    static Zone* makeRenderZone(Sample* sample, LoopMode loopMode, FilterType filterType)
+    {
+        Zone* z = new Zone;
+        z->sample = sample;
+        z->keyBase = 60;
+        z->pitchKeytrack = 1.0;
+        z->loopMode = loopMode;
+        z->loopStart = 5000;
+        z->loopEnd = 9000;
+        z->ampegDelay = 2;
+        z->ampegAttack = 10;
+        z->ampegHold = 5;
+        z->ampegDecay = 50;
+        z->ampegSustain = 0.5;
+        z->ampegRelease = 30;
+        z->pan = 20;
+        z->isCutoffDefined = true;
+        z->cutoff = 3000;
+        z->fil_veltrack = 0;
+        z->fil_type = filterType;
+        return z;
+    }
+
+    //! a 16 bit wav file of the tone
+    static QString writeSampleFile(const std::string& name, int channels, int frames)
+    {
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream f(path, std::ios::binary);
+        auto put16 = [&f](uint16_t v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+        auto put32 = [&f](uint32_t v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+
+        const uint32_t dataSize = frames * channels * sizeof(short);
+        f.write("RIFF", 4);
+        put32(36 + dataSize);
+        f.write("WAVEfmt ", 8);
+        put32(16);
+        put16(1);
+        put16(channels);
+        put32(44100);
+        put32(44100 * channels * sizeof(short));
+        put16(channels * sizeof(short));
+        put16(16);
+        f.write("data", 4);
+        put32(dataSize);
+        for (int frame = 0; frame < frames; ++frame) {
+            for (int c = 0; c < channels; ++c) {
+                put16(tone(frame, c));
+            }
+        }
+
+        return QString::fromStdString(path);
+    }
+
+    static constexpr int SAMPLE_FRAMES = 64;
+};
+
+TEST_F(ZerberusTests, ZoneIndex_SameMatchesAsScan)
+{
+    //! GIVEN Two equal instruments, one is matched by a scan of all zones, another one through the index
+    Zerberus zerberus;
+    ZInstrument* scanned = makeInstrument(&zerberus, 8, 3);
+    ZInstrument* indexed = makeInstrument(&zerberus, 8, 3);
+    std::map<const Zone*, int> scannedPositions = zonePositions(scanned);
+    std::map<const Zone*, int> indexedPositions = zonePositions(indexed);
+
+    Channel* scannedChannel = zerberus.channel(0);
+    scannedChannel->setInstrument(scanned);
+    Channel* indexedChannel = zerberus.channel(1);
+    indexedChannel->setInstrument(indexed);
+
+    //! WHEN Every key is played with every velocity, with and without the modulation wheel
+    //! THEN The same zones match in the same order, the round robin stays in sync
+    for (int modulation : { 0, 127 }) {
+        scannedChannel->controller(1, modulation);
+        indexedChannel->controller(1, modulation);
+
+        for (Trigger trigger : { Trigger::ATTACK, Trigger::RELEASE }) {
+            for (int key = 0; key < 128; ++key) {
+                for (int velo = 0; velo < 128; ++velo) {
+                    std::vector<int> scannedMatches;
+                    for (Zone* z : scanned->zones()) {
+                        if (z->match(scannedChannel, key, velo, trigger, 0.5, -1, -1)) {
+                            scannedMatches.push_back(scannedPositions[z]);
+                        }
+                    }
+
+                    std::vector<int> indexedMatches;
+                    for (Zone* z : indexed->zoneIndex().zones(trigger, key, velo)) {
+                        if (z->match(indexedChannel, key, velo, trigger, 0.5, -1, -1)) {
+                            indexedMatches.push_back(indexedPositions[z]);
+                        }
+                    }
+
+                    ASSERT_EQ(scannedMatches, indexedMatches) << "key " << key << ", velo " << velo;
+                }
+            }
+        }
+    }
+
+    //! THEN The CC triggered zones are found for any key
+    EXPECT_EQ(indexed->zoneIndex().zones(Trigger::CC, 0, 0).size(), 1u);
+
+    delete scanned;
+    delete indexed;
+}
+
+TEST_F(ZerberusTests, NoteOn_StartsMatchedVoices)
+{
+    //! GIVEN An indexed instrument on a channel
+    Zerberus zerberus;
+    zerberus.setSampleRate(44100);
+    ZInstrument* instrument = makeInstrument(&zerberus, 4, 2);
+    zerberus.channel(0)->setInstrument(instrument);
+    zerberus.controller(0, 1, 127);
+
+    //! WHEN A chord is played
+    for (int key : { 48, 64, 67 }) {
+        zerberus.noteOn(0, key, 100);
+    }
+
+    //! THEN A voice starts for the round robin zone of each note, and for the modulation zone of the notes in its range
+    int voices = 0;
+    for (Voice* v = zerberus.getActiveVoices(); v; v = v->next()) {
+        ++voices;
+    }
+    EXPECT_EQ(voices, 5);
+
+    zerberus.channel(0)->setInstrument(nullptr);
+    delete instrument;
+}
+
+TEST_F(ZerberusTests, DISABLED_Trigger_DenseChords_Benchmark)
+{
+    //! NOTE Measures the time to find the zones of the notes of dense chords, by a scan of all zones
+    //! and through the index; the results are recorded as test properties
+    Zerberus zerberus;
+    const std::vector<Note> notes = makeChords(2000, 10);
+
+    for (int velocityLayers : { 4, 16, 32 }) {
+        ZInstrument* instrument = makeInstrument(&zerberus, velocityLayers, 4);
+        Channel* channel = zerberus.channel(0);
+        channel->setInstrument(instrument);
+
+        double results[2] = { 0.0, 0.0 };
+        size_t matches[2] = { 0, 0 };
+        for (int mode = 0; mode < 2; ++mode) {
+            auto start = std::chrono::steady_clock::now();
+            for (const Note& note : notes) {
+                if (mode == 0) {
+                    for (Zone* z : instrument->zones()) {
+                        matches[mode] += z->match(channel, note.key, note.velo, note.trigger, note.random, -1, -1);
+                    }
+                } else {
+                    for (Zone* z : instrument->zoneIndex().zones(note.trigger, note.key, note.velo)) {
+                        matches[mode] += z->match(channel, note.key, note.velo, note.trigger, note.random, -1, -1);
+                    }
+                }
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            results[mode] = elapsed.count() / notes.size();
+        }
+
+        EXPECT_EQ(matches[0], matches[1]);
+
+        const std::string zones = std::to_string(instrument->zones().size());
+        RecordProperty("scan_ns_per_note_" + zones + "_zones", std::to_string(results[0]));
+        RecordProperty("index_ns_per_note_" + zones + "_zones", std::to_string(results[1]));
+
+        channel->setInstrument(nullptr);
+        delete instrument;
+    }
+}
+
+TEST_F(ZerberusTests, Voice_BlockRenderingMatchesPerSample)
+{
+    Zerberus zerberus;
+    zerberus.setSampleRate(44100);
+    Channel* channel = zerberus.channel(0);
+
+    const int blockSizes[] = { 37, 256, 1, 500, 64, 3, 1024 };
+    const int totalFrames = 44100;
+    const int stopFrame = 22050;
+
+    for (int channels : { 1, 2 }) {
+        for (LoopMode loopMode : { LoopMode::NO_LOOP, LoopMode::CONTINUOUS, LoopMode::SUSTAIN }) {
+            for (FilterType filterType : { FilterType::lpf_2p, FilterType::hpf_1p, FilterType::lpf_1p }) {
+                Zone* z = makeRenderZone(channels, loopMode, filterType);
+
+                for (int key : { 48, 60, 67 }) {
+                    //! GIVEN Two voices of the same note, one renders blocks, another one every sample
+                    Voice blockVoice(&zerberus);
+                    Voice sampleVoice(&zerberus);
+                    blockVoice.start(channel, key, 100, z, 0.0);
+                    sampleVoice.start(channel, key, 100, z, 0.0);
+
+                    //! WHEN They are rendered with different buffer sizes, and stopped in the middle
+                    std::vector<float> blockOut(totalFrames * 2, 0.f);
+                    std::vector<float> sampleOut(totalFrames * 2, 0.f);
+                    bool stopped = false;
+                    for (int frame = 0, b = 0; frame < totalFrames && !sampleVoice.isOff(); ++b) {
+                        const int frames = std::min(blockSizes[b % std::size(blockSizes)], totalFrames - frame);
+                        if (!stopped && frame >= stopFrame) {
+                            blockVoice.stop();
+                            sampleVoice.stop();
+                            stopped = true;
+                        }
+
+                        blockVoice.process(frames, blockOut.data() + frame * 2);
+                        sampleVoice.processPerSample(frames, sampleOut.data() + frame * 2);
+                        frame += frames;
+
+                        //! THEN Both go off at the same time
+                        ASSERT_EQ(blockVoice.isOff(), sampleVoice.isOff()) << "frame " << frame;
+                    }
+
+                    //! THEN The output is the same within the float rounding of the filter
+                    float peak = 0.f;
+                    float maxDiff = 0.f;
+                    for (size_t i = 0; i < blockOut.size(); ++i) {
+                        peak = std::max(peak, std::fabs(sampleOut[i]));
+                        maxDiff = std::max(maxDiff, std::fabs(blockOut[i] - sampleOut[i]));
+                    }
+                    EXPECT_GT(peak, 0.f);
+                    EXPECT_LE(maxDiff, peak * 1e-5f) << "channels " << channels << ", loop mode " << int(loopMode)
+                                              << ", filter " << int(filterType) << ", key " << key;
+                    EXPECT_EQ(blockVoice.getSamplesSinceStart(), sampleVoice.getSamplesSinceStart());
+                }
+
+                delete z;
+            }
+        }
+    }
+}
+
+TEST_F(ZerberusTests, DISABLED_Voice_Polyphony_Benchmark)
+{
+    //! NOTE Measures the time to render a second of sustained looped voices every sample and in blocks;
+    //! the results are recorded as test properties
+    Zerberus zerberus;
+    zerberus.setSampleRate(44100);
+    Channel* channel = zerberus.channel(0);
+
+    const int voiceCount = 64;
+    const int blockSize = 512;
+    const int blocks = 44100 / blockSize;
+
+    for (int channels : { 1, 2 }) {
+        Zone* z = makeRenderZone(channels, LoopMode::CONTINUOUS, FilterType::lpf_2p);
+        std::vector<float> out(blockSize * 2);
+
+        double results[2] = { 0.0, 0.0 };
+        for (int mode = 0; mode < 2; ++mode) {
+            std::vector<std::unique_ptr<Voice> > voices;
+            for (int i = 0; i < voiceCount; ++i) {
+                voices.push_back(std::make_unique<Voice>(&zerberus));
+                voices.back()->start(channel, 36 + i % 48, 100, z, 0.0);
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            for (int b = 0; b < blocks; ++b) {
+                for (auto& v : voices) {
+                    if (mode == 0) {
+                        v->processPerSample(blockSize, out.data());
+                    } else {
+                        v->process(blockSize, out.data());
+                    }
+                }
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            results[mode] = elapsed.count() / (double(blocks) * blockSize * voiceCount);
+        }
+
+        RecordProperty("per_sample_ns_per_frame_" + std::to_string(channels) + "_channels", std::to_string(results[0]));
+        RecordProperty("block_ns_per_frame_" + std::to_string(channels) + "_channels", std::to_string(results[1]));
+
+        delete z;
+    }
+}
+
+TEST_F(ZerberusTests, StreamedSample_PlaysLikeResident)
+{
+    //! GIVEN Sample files read whole and with a preload of 20 ms, the rest is streamed
+    Zerberus zerberus;
+    zerberus.setSampleRate(44100);
+    ZInstrument residentInstrument(&zerberus);
+
+    Zerberus streaming;
+    streaming.setSampleRate(44100);
+    streaming.setSamplePreload(20);
+    ZInstrument streamedInstrument(&streaming);
+
+    const int blockSize = 512;
+    const int totalFrames = 22050;
+    const int stopFrame = 8192;
+
+    for (int channels : { 1, 2 }) {
+        QString path = writeSampleFile("zerberus_stream_" + std::to_string(channels) + ".wav", channels, totalFrames);
+
+        for (LoopMode loopMode : { LoopMode::NO_LOOP, LoopMode::SUSTAIN }) {
+            // the loop of a looped zone stays in memory
+            const long long residentFrames = loopMode == LoopMode::SUSTAIN ? 9004 : 0;
+            Zone* residentZone = makeRenderZone(residentInstrument.readSample(path, nullptr, residentFrames),
+                                                loopMode, FilterType::lpf_2p);
+            Zone* streamedZone = makeRenderZone(streamedInstrument.readSample(path, nullptr, residentFrames),
+                                                loopMode, FilterType::lpf_2p);
+
+            EXPECT_FALSE(residentZone->sample->isStreamed());
+            ASSERT_TRUE(streamedZone->sample->isStreamed());
+            EXPECT_LT(streamedZone->sample->residentBytes(), residentZone->sample->residentBytes() / 2);
+
+            for (int key : { 60, 67 }) {
+                //! WHEN Both play a note in real time, stopped in the middle
+                Voice residentVoice(&zerberus);
+                Voice streamedVoice(&streaming);
+                residentVoice.start(zerberus.channel(0), key, 100, residentZone, 0.0);
+                streamedVoice.start(streaming.channel(0), key, 100, streamedZone, 0.0);
+                const long long underruns = streaming.streamUnderruns();
+
+                std::vector<float> residentOut(totalFrames * 2, 0.f);
+                std::vector<float> streamedOut(totalFrames * 2, 0.f);
+                for (int frame = 0; frame + blockSize <= totalFrames && !residentVoice.isOff(); frame += blockSize) {
+                    if (frame == stopFrame) {
+                        residentVoice.stop();
+                        streamedVoice.stop();
+                    }
+
+                    residentVoice.process(blockSize, residentOut.data() + frame * 2);
+                    streamedVoice.process(blockSize, streamedOut.data() + frame * 2);
+                    ASSERT_EQ(residentVoice.isOff(), streamedVoice.isOff()) << "frame " << frame;
+
+                    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+                }
+
+                //! THEN The streamed sample sounds the same, without underruns
+                float peak = 0.f;
+                float maxDiff = 0.f;
+                for (size_t i = 0; i < residentOut.size(); ++i) {
+                    peak = std::max(peak, std::fabs(residentOut[i]));
+                    maxDiff = std::max(maxDiff, std::fabs(residentOut[i] - streamedOut[i]));
+                }
+                EXPECT_GT(peak, 0.f);
+                EXPECT_LE(maxDiff, peak * 1e-5f) << "channels " << channels << ", loop mode " << int(loopMode)
+                                                 << ", key " << key;
+                EXPECT_EQ(streaming.streamUnderruns(), underruns);
+            }
+
+            delete residentZone;
+            delete streamedZone;
+        }
+
+        std::filesystem::remove(path.toStdString());
+    }
+}
+
+TEST_F(ZerberusTests, StreamedSample_StreamFramesLineUpWithData)
+{
+    //! GIVEN A sample file read whole and with a preload of 20 ms
+    Zerberus zerberus;
+    ZInstrument residentInstrument(&zerberus);
+
+    Zerberus streaming;
+    streaming.setSamplePreload(20);
+    ZInstrument streamedInstrument(&streaming);
+
+    for (int channels : { 1, 2 }) {
+        const int frames = 2000;
+        QString path = writeSampleFile("zerberus_stream_frames_" + std::to_string(channels) + ".wav", channels, frames);
+        std::unique_ptr<Sample> resident(residentInstrument.readSample(path, nullptr));
+        std::unique_ptr<Sample> streamed(streamedInstrument.readSample(path, nullptr));
+        ASSERT_TRUE(streamed->isStreamed());
+
+        //! WHEN The rest of the sample is streamed
+        const long long residentFrames = streamed->residentFrames();
+        SampleStream* stream = SampleStreamer::instance()->open(streamed.get(), residentFrames);
+        ASSERT_TRUE(stream);
+        for (int i = 0; i < 1000 && stream->writtenFrames() < frames + 2; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        //! THEN The resident and the streamed frames are the frames of data() of the whole sample,
+        //! up to the padding after its end
+        for (long long pos = 0; pos < (frames + 2) * channels; ++pos) {
+            short value = 0;
+            if (pos < residentFrames * channels) {
+                value = streamed->data()[pos];
+            } else {
+                ASSERT_TRUE(stream->read(pos, value)) << "pos " << pos;
+            }
+            ASSERT_EQ(value, resident->data()[pos]) << "channels " << channels << ", frame " << pos / channels;
+        }
+        EXPECT_EQ(streamed->data()[(residentFrames - 1) * channels], tone(residentFrames - 1, 0));
+        EXPECT_EQ(resident->data()[residentFrames * channels], tone(residentFrames, 0));
+
+        stream->close();
+    }
+}
+
+TEST_F(ZerberusTests, StreamedSample_MissingFileCountsUnderruns)
+{
+    //! GIVEN A streamed sample whose file is gone after loading
+    Zerberus streaming;
+    streaming.setSampleRate(44100);
+    streaming.setSamplePreload(20);
+    ZInstrument instrument(&streaming);
+
+    QString path = writeSampleFile("zerberus_stream_missing.wav", 1, 22050);
+    Zone* z = makeRenderZone(instrument.readSample(path, nullptr), LoopMode::NO_LOOP, FilterType::lpf_2p);
+    std::filesystem::remove(path.toStdString());
+    ASSERT_TRUE(z->sample->isStreamed());
+
+    //! WHEN It plays past its preload
+    Voice voice(&streaming);
+    voice.start(streaming.channel(0), 60, 100, z, 0.0);
+    const long long underruns = streaming.streamUnderruns();
+
+    std::vector<float> out(4096 * 2, 0.f);
+    for (int frame = 0; frame < 4096; frame += 512) {
+        voice.process(512, out.data() + frame * 2);
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    }
+
+    //! THEN The frames it can't stream are silent and counted as underruns
+    EXPECT_GT(streaming.streamUnderruns(), underruns);
+
+    float peak = 0.f;
+    for (int i = 0; i < 2048 * 2; ++i) {
+        peak = std::max(peak, std::fabs(out[i]));
+    }
+    float tail = 0.f;
+    for (size_t i = 2048 * 2; i < out.size(); ++i) {
+        tail = std::max(tail, std::fabs(out[i]));
+    }
+    EXPECT_GT(peak, 0.f);
+    EXPECT_LT(tail, peak * 1e-6f);
+
+    voice.off();
+    delete z;
+}
+
+TEST_F(ZerberusTests, DISABLED_SampleLibrary_Load_Benchmark)
+{
+    //! NOTE Measures the load time and the sample memory of a library, read whole and with a preload;
+    //! the results are recorded as test properties
+    const int sampleCount = 24;
+    std::vector<QString> paths;
+    for (int i = 0; i < sampleCount; ++i) {
+        paths.push_back(writeSampleFile("zerberus_library_" + std::to_string(i) + ".wav", 2, 88200));
+    }
+
+    for (int preload : { 0, 100 }) {
+        Zerberus zerberus;
+        zerberus.setSamplePreload(preload);
+        ZInstrument instrument(&zerberus);
+
+        auto start = std::chrono::steady_clock::now();
+        for (const QString& path : paths) {
+            Zone* z = new Zone;
+            z->sample = instrument.readSample(path, nullptr);
+            instrument.addZone(z);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        SampleMemory memory = instrument.sampleMemory();
+        const std::string suffix = "_preload_" + std::to_string(preload) + "_ms";
+        RecordProperty("load_ms" + suffix, std::to_string(elapsed.count()));
+        RecordProperty("resident_kb" + suffix, std::to_string(memory.resident / 1024));
+        RecordProperty("total_kb" + suffix, std::to_string(memory.total / 1024));
+    }
+
+    for (const QString& path : paths) {
+        std::filesystem::remove(path.toStdString());
+    }
+}
@@ -22,6 +22,15 @@
 
 #include "runtime.h"
 
+#include <algorithm>
+#include <cstdio>
+
+#include <QtGlobal>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
 static thread_local std::string s_threadName;
 
 void mu::runtime::setThreadName(const std::string& name)
@@ -37,3 +46,34 @@ const std::string& mu::runtime::threadName()
     }
     return s_threadName;
 }
+
+int64_t mu::runtime::peakRssKb(bool includeChildren)
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+
+    int64_t maxrss = usage.ru_maxrss;
+    if (includeChildren && getrusage(RUSAGE_CHILDREN, &usage) == 0) {
+        maxrss = std::max<int64_t>(maxrss, usage.ru_maxrss);
+    }
+#ifdef Q_OS_MACOS
+    maxrss /= 1024; // bytes on macOS
+#endif
+    return maxrss;
+#else
+    Q_UNUSED(includeChildren);
+    return -1;
+#endif
+}
+
+std::string mu::runtime::throughputInfo(int64_t bytes, double seconds)
+{
+    const double mb = bytes / (1024.0 * 1024.0);
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%.2f MB in %.3f s: %.2f MB/s, peak RSS %lld KB",
+                  mb, seconds, seconds > 0 ? mb / seconds : 0.0, static_cast<long long>(peakRssKb()));
+    return buf;
+}
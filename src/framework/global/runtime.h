@@ -22,6 +22,8 @@
 #ifndef MU_FRAMEWORK_RUNTIME_H
 #define MU_FRAMEWORK_RUNTIME_H
 
+#include <cstdint>
+#include <string>
 #include <thread>
 #include <sstream>
 
@@ -50,6 +52,14 @@ inline std::string toString(const std::thread::id& id)
 
 void setThreadName(const std::string& name);
 const std::string& threadName();
+
+//! NOTE Peak resident set size in KB of the process, and of its finished
+//! child processes if includeChildren is set; -1 if not supported
+int64_t peakRssKb(bool includeChildren = false);
+
+//! NOTE "<size> MB in <time> s: <rate> MB/s, peak RSS <peakRssKb> KB",
+//! for the benchmarks that measure reading or writing files
+std::string throughputInfo(int64_t bytes, double seconds);
 }
 
 #endif // MU_FRAMEWORK_RUNTIME_H
@@ -31,6 +31,10 @@
 #include <functional>
 #include <set>
 #include <cassert>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 #include "async/channel.h"
 #include "midievent.h"
 
@@ -57,6 +61,229 @@ struct Chunk {
 };
 using Chunks = std::map<tick_t /*begin*/, Chunk>;
 
+//! Flat copy of the chunk events for the playback, sorted by tick.
+//! The fields are kept in separate arrays, so the search by tick and the checks
+//! of the channel and the kind of an event do not touch the event data.
+struct ChunkTimeline {
+    enum class Kind : uint8_t {
+        Noop = 0,
+        NoteOn,
+        NoteOff,
+        Other
+    };
+
+    tick_t beginTick = 0;
+    tick_t endTick = 0;
+    std::vector<tick_t> ticks;
+    std::vector<channel_t> channels;
+    std::vector<Kind> kinds;
+    std::vector<Event> events;
+
+    ChunkTimeline() = default;
+    explicit ChunkTimeline(const Chunk& chunk)
+        : beginTick(chunk.beginTick), endTick(chunk.endTick)
+    {
+        ticks.reserve(chunk.events.size());
+        channels.reserve(chunk.events.size());
+        kinds.reserve(chunk.events.size());
+        events.reserve(chunk.events.size());
+
+        //! NOTE The multimap is already sorted, events of the same tick keep their order
+        for (const auto& it : chunk.events) {
+            const Event& e = it.second;
+            ticks.push_back(it.first);
+            channels.push_back(e ? e.channel() : 0);
+            kinds.push_back(kindOf(e));
+            events.push_back(e);
+        }
+    }
+
+    size_t size() const { return ticks.size(); }
+
+    //! index of the first event at tick or later
+    size_t lowerBound(tick_t tick) const
+    {
+        return std::lower_bound(ticks.begin(), ticks.end(), tick) - ticks.begin();
+    }
+
+    static Kind kindOf(const Event& e)
+    {
+        if (!e) {
+            return Kind::Noop;
+        }
+
+        if (e.isChannelVoice()) {
+            if (e.opcode() == Event::Opcode::NoteOn) {
+                return Kind::NoteOn;
+            }
+            if (e.opcode() == Event::Opcode::NoteOff) {
+                return Kind::NoteOff;
+            }
+        }
+
+        return Kind::Other;
+    }
+};
+using ChunkTimelinePtr = std::shared_ptr<const ChunkTimeline>;
+
+//! Immutable set of chunk timelines sorted by the begin tick
+struct TimelineSnapshot {
+    std::vector<ChunkTimelinePtr> chunks;
+
+    //! index of the chunk that contains tick, or of the first one after it
+    size_t chunkIndex(tick_t tick) const
+    {
+        auto it = std::upper_bound(chunks.begin(), chunks.end(), tick, [](tick_t t, const ChunkTimelinePtr& c) {
+            return t < c->beginTick;
+        });
+
+        if (it != chunks.begin() && (*(it - 1))->endTick > tick) {
+            --it;
+        }
+
+        return it - chunks.begin();
+    }
+
+    //! end tick of the data available without gaps from fromTick, looked up
+    //! no further than maxDistanceTick
+    tick_t validTick(tick_t fromTick, tick_t maxDistanceTick) const
+    {
+        if (chunks.empty()) {
+            return 0;
+        }
+
+        size_t i = chunkIndex(fromTick);
+        if (i == chunks.size() || chunks[i]->beginTick > fromTick) {
+            i = i > 0 ? i - 1 : 0;
+        }
+
+        for (; i < chunks.size(); ++i) {
+            const ChunkTimeline& chunk = *chunks[i];
+
+            if ((chunk.endTick - fromTick) > maxDistanceTick) {
+                return chunk.endTick;
+            }
+
+            if (i + 1 == chunks.size() || chunk.endTick != chunks[i + 1]->beginTick) {
+                return chunk.endTick;
+            }
+        }
+
+        return chunks.back()->endTick;
+    }
+};
+using TimelineSnapshotPtr = std::shared_ptr<const TimelineSnapshot>;
+
+//! The playback data of a stream. The chunks are flattened on the thread that makes them,
+//! each change publishes a new snapshot. There is one reader, the audio thread: it checks
+//! the revision and acquires the snapshot only when it has changed.
+//! The writer owns all snapshots. The reader marks the one it uses in a hazard pointer,
+//! the writer frees the others when it publishes, so the audio thread neither locks
+//! nor frees memory.
+class EventTimeline
+{
+    static_assert(std::atomic<const TimelineSnapshot*>::is_always_lock_free, "the reader must not lock");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "the reader must not lock");
+
+public:
+    void reset(const Chunks& chunks)
+    {
+        auto snapshot = std::make_shared<TimelineSnapshot>();
+        for (const auto& it : chunks) {
+            if (it.second.beginTick < it.second.endTick) {
+                snapshot->chunks.push_back(std::make_shared<const ChunkTimeline>(it.second));
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        publish(snapshot);
+    }
+
+    void add(const Chunk& chunk)
+    {
+        if (chunk.beginTick >= chunk.endTick) {
+            return;
+        }
+
+        ChunkTimelinePtr timeline = std::make_shared<const ChunkTimeline>(chunk);
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        const std::vector<ChunkTimelinePtr>& chunks = m_snapshot->chunks;
+        auto it = std::lower_bound(chunks.begin(), chunks.end(), chunk.beginTick, [](const ChunkTimelinePtr& c, tick_t t) {
+            return c->beginTick < t;
+        });
+
+        //! NOTE Like the insertion into Chunks, the chunk that is already there stays
+        if (it != chunks.end() && (*it)->beginTick == chunk.beginTick) {
+            return;
+        }
+
+        auto snapshot = std::make_shared<TimelineSnapshot>();
+        snapshot->chunks.reserve(chunks.size() + 1);
+        snapshot->chunks.insert(snapshot->chunks.end(), chunks.begin(), it);
+        snapshot->chunks.push_back(timeline);
+        snapshot->chunks.insert(snapshot->chunks.end(), it, chunks.end());
+        publish(snapshot);
+    }
+
+    uint64_t revision() const { return m_revision.load(std::memory_order_acquire); }
+
+    //! the latest snapshot, for the writer side
+    TimelineSnapshotPtr snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return m_snapshot;
+    }
+
+    //! the latest snapshot, for the reader; it stays valid until the next acquire() or release()
+    const TimelineSnapshot* acquire()
+    {
+        const TimelineSnapshot* snapshot = m_latest.load();
+        for (;;) {
+            m_inUse.store(snapshot);
+            const TimelineSnapshot* latest = m_latest.load();
+            if (latest == snapshot) {
+                return snapshot;
+            }
+            snapshot = latest;
+        }
+    }
+
+    void release()
+    {
+        m_inUse.store(nullptr);
+    }
+
+    //! snapshots kept for the reader, besides the latest one
+    size_t retiredCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        return m_retired.size();
+    }
+
+private:
+    void publish(const TimelineSnapshotPtr& snapshot)
+    {
+        m_retired.push_back(m_snapshot);
+        m_snapshot = snapshot;
+        m_latest.store(snapshot.get());
+        m_revision.fetch_add(1, std::memory_order_release);
+
+        //! NOTE The reader can't take a retired snapshot any more, only keep the one it marked
+        const TimelineSnapshot* inUse = m_inUse.load();
+        m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(), [inUse](const TimelineSnapshotPtr& s) {
+            return s.get() != inUse;
+        }), m_retired.end());
+    }
+
+    mutable std::mutex m_writeMutex;
+    TimelineSnapshotPtr m_snapshot = std::make_shared<TimelineSnapshot>();
+    std::vector<TimelineSnapshotPtr> m_retired;
+    std::atomic<const TimelineSnapshot*> m_latest{ m_snapshot.get() };
+    std::atomic<const TimelineSnapshot*> m_inUse{ nullptr };
+    std::atomic<uint64_t> m_revision{ 0 };
+};
+
 struct Program {
     channel_t channel = 0;
     program_t program = 0;
@@ -136,7 +363,17 @@ struct MidiStream {
     async::Channel<Chunk> stream;
     async::Channel<tick_t> request;
 
+    //! NOTE The chunks of initData and of the stream, made for the playback
+    EventTimeline timeline;
+
     bool isValid() const { return initData.isValid(); }
+
+    //! adds the chunk to the timeline before the receivers of the stream get it
+    void sendChunk(const Chunk& chunk)
+    {
+        timeline.add(chunk);
+        stream.send(chunk);
+    }
 };
 
 using MidiDeviceID = std::string;
@@ -371,6 +371,7 @@ public:
             _highestChannel = c;
         }
     }
+    int highestChannel() const { return _highestChannel; }
 };
 
 typedef EventList::iterator iEvent;
@@ -99,6 +99,18 @@ bool VstSynthesiser::handleEvent(const midi::Event& e)
     return m_vstAudioClient->handleEvent(e);
 }
 
+void VstSynthesiser::scheduleEvent(const midi::Event& e, unsigned int sampleOffset)
+{
+    if (!m_scheduledEvents.schedule(e, sampleOffset)) {
+        handleEvent(e);
+    }
+}
+
+void VstSynthesiser::clearScheduledEvents()
+{
+    m_scheduledEvents.clear();
+}
+
 void VstSynthesiser::writeBuf(float* stream, unsigned int samples)
 {
     m_vstAudioClient->process(stream, samples);
@@ -160,7 +172,16 @@ async::Channel<unsigned int> VstSynthesiser::streamsCountChanged() const
 
 void VstSynthesiser::forward(unsigned int sampleCount)
 {
-    writeBuf(m_buffer.data(), sampleCount);
+    if (m_scheduledEvents.empty()) {
+        writeBuf(m_buffer.data(), sampleCount);
+        return;
+    }
+
+    m_scheduledEvents.render(sampleCount, [this](const midi::Event& e) {
+        handleEvent(e);
+    }, [this](unsigned int offset, unsigned int count) {
+        writeBuf(m_buffer.data() + offset * streamCount(), count);
+    });
 }
 
 const float* VstSynthesiser::data() const
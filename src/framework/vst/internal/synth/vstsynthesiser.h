@@ -24,6 +24,7 @@
 #define MU_VST_VSTSYNTHESISER_H
 
 #include "audio/isynthesizer.h"
+#include "audio/scheduledevents.h"
 #include "modularity/ioc.h"
 
 #include "vsttypes.h"
@@ -51,6 +52,8 @@ public:
     Ret removeSoundFonts() override;
 
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
+    void clearScheduledEvents() override;
     void writeBuf(float* stream, unsigned int samples) override;
     void allSoundsOff() override;
     void flushSound() override;
@@ -79,6 +82,7 @@ private:
     bool m_isActive = false;
 
     std::vector<float> m_buffer;
+    audio::synth::ScheduledEvents m_scheduledEvents;
 
     async::Channel<unsigned int> m_streamsCountChanged;
 };
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "abstractaudiowriter.h"
+
+#include <cstring>
+#include <sndfile.h>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::iex::audioexport;
+using namespace mu::system;
+
+static constexpr int AUDIO_CHANNELS = 2;
+
+static sf_count_t deviceFileLen(void* device)
+{
+    return static_cast<IODevice*>(device)->size();
+}
+
+static sf_count_t deviceSeek(sf_count_t offset, int whence, void* device)
+{
+    IODevice* d = static_cast<IODevice*>(device);
+    qint64 pos = offset;
+    switch (whence) {
+    case SEEK_CUR: pos += d->pos();
+        break;
+    case SEEK_END: pos += d->size();
+        break;
+    default:
+        break;
+    }
+
+    if (!d->seek(pos)) {
+        return -1;
+    }
+    return d->pos();
+}
+
+static sf_count_t deviceRead(void* ptr, sf_count_t count, void* device)
+{
+    return static_cast<IODevice*>(device)->read(static_cast<char*>(ptr), count);
+}
+
+static sf_count_t deviceWrite(const void* ptr, sf_count_t count, void* device)
+{
+    return static_cast<IODevice*>(device)->write(static_cast<const char*>(ptr), count);
+}
+
+static sf_count_t deviceTell(void* device)
+{
+    return static_cast<IODevice*>(device)->pos();
+}
+
+static SF_VIRTUAL_IO deviceIO = {
+    deviceFileLen,
+    deviceSeek,
+    deviceRead,
+    deviceWrite,
+    deviceTell
+};
+
+Ret AbstractAudioWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options&)
+{
+    IF_ASSERT_FAILED(notation && notation->playback()) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    return writeStream(notation->playback()->exportMidiStream(), destinationDevice);
+}
+
+Ret AbstractAudioWriter::writeStream(const std::shared_ptr<midi::MidiStream>& stream, IODevice& destinationDevice)
+{
+    if (!offlineRenderer()) {
+        LOGE() << "audio export requires the audio module";
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    //! NOTE The headers are finalized on close, so the device must be seekable
+    if (destinationDevice.isSequential()) {
+        LOGE() << "audio export requires a random access device";
+        return make_ret(Ret::Code::NotSupported);
+    }
+
+    m_isAborted = false;
+
+    audio::IOfflineRenderer::Options renderOptions;
+
+    SF_INFO info;
+    memset(&info, 0, sizeof(info));
+    info.samplerate = static_cast<int>(renderOptions.sampleRate);
+    info.channels = AUDIO_CHANNELS;
+    info.format = format();
+
+    SNDFILE* sf = sf_open_virtual(&deviceIO, SFM_WRITE, &info, &destinationDevice);
+    if (!sf) {
+        LOGE() << "failed open sndfile: " << sf_strerror(nullptr);
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    bool writeFailed = false;
+    auto onBlock = [this, sf, &writeFailed](const float* data, unsigned int sampleCount) {
+        if (sf_writef_float(sf, data, sampleCount) != static_cast<sf_count_t>(sampleCount)) {
+            LOGE() << "failed write audio: " << sf_strerror(sf);
+            writeFailed = true;
+            return false;
+        }
+        return !m_isAborted;
+    };
+
+    RetVal<audio::IOfflineRenderer::Stats> rv = offlineRenderer()->render(stream, renderOptions, onBlock);
+
+    sf_close(sf);
+
+    if (writeFailed) {
+        return make_ret(Ret::Code::InternalError);
+    }
+
+    if (!rv.ret) {
+        return rv.ret;
+    }
+
+    LOGI() << "rendered " << rv.val.audioSeconds << "s of audio in " << rv.val.renderSeconds
+           << "s (" << rv.val.realtimeFactor() << "x realtime)";
+
+    return make_ret(Ret::Code::Ok);
+}
+
+void AbstractAudioWriter::abort()
+{
+    m_isAborted = true;
+}
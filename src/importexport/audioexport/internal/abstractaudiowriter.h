@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+#define MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
+
+#include <atomic>
+
+#include "notation/abstractnotationwriter.h"
+#include "modularity/ioc.h"
+#include "audio/iofflinerenderer.h"
+
+namespace mu::iex::audioexport {
+//! Renders the score with the offline renderer and encodes it with libsndfile.
+//! The blocks are written as soon as they are rendered, so the memory doesn't grow with the score length.
+class AbstractAudioWriter : public notation::AbstractNotationWriter
+{
+    INJECT(iex_audioexport, audio::IOfflineRenderer, offlineRenderer)
+
+public:
+    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    void abort() override;
+
+    Ret writeStream(const std::shared_ptr<midi::MidiStream>& stream, system::IODevice& destinationDevice);
+
+protected:
+    //! SF_FORMAT_* major and subtype
+    virtual int format() const = 0;
+
+private:
+    std::atomic<bool> m_isAborted { false };
+};
+}
+
+#endif // MU_IMPORTEXPORT_ABSTRACTAUDIOWRITER_H
@@ -33,7 +33,9 @@ mu::Ret Mp3Writer::write(const notation::INotationPtr notation, system::IODevice
     UNUSED(destinationDevice)
     UNUSED(options)
 
-    NOT_IMPLEMENTED;
+    //! NOTE libsndfile can't encode mp3 (the version we require), and there is no lame in the dependencies,
+    //! the offline render is ready for it, see AbstractAudioWriter
+    LOGE() << "mp3 export requires an mp3 encoder, which is not available";
 
-    return make_ret(Ret::Code::NotImplemented);
+    return make_ret(Ret::Code::NotSupported);
 }
@@ -23,13 +23,13 @@
 #ifndef MU_IMPORTEXPORT_WAVEWRITER_H
 #define MU_IMPORTEXPORT_WAVEWRITER_H
 
-#include "notation/abstractnotationwriter.h"
+#include "abstractaudiowriter.h"
 
 namespace mu::iex::audioexport {
-class WaveWriter : public notation::AbstractNotationWriter
+class WaveWriter : public AbstractAudioWriter
 {
-public:
-    Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+protected:
+    int format() const override;
 };
 }
 
@@ -0,0 +1,339 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <QBuffer>
+
+#include "importexport/audioexport/internal/wavewriter.h"
+#include "internal/audiosanitizer.h"
+#include "internal/offlinerenderer.h"
+#include "internal/synthesizers/synthesizersregister.h"
+#include "async/asyncable.h"
+#include "audioerrors.h"
+#include "scheduledevents.h"
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::audio::synth;
+using namespace mu::midi;
+using namespace mu::iex::audioexport;
+
+class AudioExportTests : public ::testing::Test, public async::Asyncable
+{
+public:
+    //! mono synth that writes a single 1.0 sample where a note starts
+    class ClickSynth : public ISynthesizer
+    {
+    public:
+        bool isValid() const override { return true; }
+        std::string name() const override { return "Click"; }
+        SoundFontFormats soundFontFormats() const override { return {}; }
+
+        Ret init() override { return make_ret(Ret::Code::Ok); }
+        Ret addSoundFonts(const std::vector<io::path>&) override { return make_ret(Ret::Code::Ok); }
+        Ret removeSoundFonts() override { return make_ret(Ret::Code::Ok); }
+
+        bool isActive() const override { return true; }
+        void setIsActive(bool) override {}
+
+        Ret setupChannels(const std::vector<Event>&) override { return make_ret(Ret::Code::Ok); }
+        bool handleEvent(const Event& e) override
+        {
+            if (e.opcode() == Event::Opcode::NoteOn) {
+                m_noteStarted = true;
+            }
+            return true;
+        }
+
+        void scheduleEvent(const Event& e, unsigned int sampleOffset) override
+        {
+            if (!m_scheduledEvents.schedule(e, sampleOffset)) {
+                handleEvent(e);
+            }
+        }
+        void clearScheduledEvents() override { m_scheduledEvents.clear(); }
+
+        void writeBuf(float* stream, unsigned int samples) override
+        {
+            std::fill(stream, stream + samples, 0.f);
+            if (m_noteStarted) {
+                stream[0] = 1.f;
+                m_noteStarted = false;
+            }
+        }
+
+        void allSoundsOff() override { m_noteStarted = false; }
+        void flushSound() override {}
+        void channelSoundsOff(channel_t) override {}
+        bool channelVolume(channel_t, float) override { return true; }
+        bool channelBalance(channel_t, float) override { return true; }
+        bool channelPitch(channel_t, int16_t) override { return true; }
+
+        void setSampleRate(unsigned int) override {}
+        unsigned int streamCount() const override { return 1; }
+        async::Channel<unsigned int> streamsCountChanged() const override { return m_streamsCountChanged; }
+        const float* data() const override { return m_buffer.data(); }
+        void setBufferSize(unsigned int samples) override { m_buffer.resize(samples); }
+
+        void forward(unsigned int sampleCount) override
+        {
+            m_scheduledEvents.render(sampleCount, [this](const Event& e) {
+                handleEvent(e);
+            }, [this](unsigned int offset, unsigned int count) {
+                writeBuf(m_buffer.data() + offset, count);
+            });
+        }
+
+    private:
+        ScheduledEvents m_scheduledEvents;
+        std::vector<float> m_buffer;
+        async::Channel<unsigned int> m_streamsCountChanged;
+        bool m_noteStarted = false;
+    };
+
+    struct WavFile {
+        bool isValid = false;
+        uint16_t format = 0;
+        uint16_t channels = 0;
+        uint32_t sampleRate = 0;
+        uint16_t bitsPerSample = 0;
+        std::vector<int16_t> samples;   // interleaved
+    };
+
+    void SetUp() override
+    {
+        //! NOTE Exports run in the main thread
+        AudioSanitizer::setupMainThread();
+
+        std::shared_ptr<SynthesizersRegister> synthesizers = std::make_shared<SynthesizersRegister>();
+        synthesizers->registerSynthesizer("Click", std::make_shared<ClickSynth>());
+        synthesizers->setDefaultSynthesizer("Click");
+
+        m_writer.setofflineRenderer(std::make_shared<OfflineRenderer>(synthesizers));
+    }
+
+    static Event noteOn(uint8_t note)
+    {
+        Event e(Event::Opcode::NoteOn);
+        e.setChannel(0);
+        e.setNote(note);
+        e.setVelocity(64);
+        return e;
+    }
+
+    static Chunk makeChunk(tick_t beginTick, tick_t endTick, const std::vector<tick_t>& onsets)
+    {
+        Chunk chunk;
+        chunk.beginTick = beginTick;
+        chunk.endTick = endTick;
+        for (tick_t tick : onsets) {
+            if (tick >= beginTick && tick < endTick) {
+                chunk.events.insert({ tick, noteOn(60) });
+            }
+        }
+        return chunk;
+    }
+
+    //! 120 bpm with 441 ticks per quarter, 50 samples per tick at 44.1 kHz
+    static std::shared_ptr<MidiStream> makeStream(const std::vector<tick_t>& onsets, tick_t loadedTicks)
+    {
+        std::shared_ptr<MidiStream> stream = std::make_shared<MidiStream>();
+        MidiData& data = stream->initData;
+        data.division = 441;
+        data.tempoMap = { { 0, 500000 } };
+        data.synthMap = { { 0, "Click" } };
+
+        Event program(Event::Opcode::ProgramChange);
+        program.setChannel(0);
+        data.initEvents.push_back(program);
+        data.tracks.push_back({ 0, { 0 } });
+
+        Chunk chunk = makeChunk(0, loadedTicks, onsets);
+        data.chunks.insert({ chunk.beginTick, chunk });
+        stream->timeline.reset(data.chunks);
+
+        stream->lastTick = LAST_TICK;
+        stream->isStreamingAllowed = loadedTicks < LAST_TICK;
+        return stream;
+    }
+
+    static uint32_t readUInt(const char* data, int bytes)
+    {
+        uint32_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i) {
+            value = (value << 8) | static_cast<uint8_t>(data[i]);
+        }
+        return value;
+    }
+
+    //! RIFF header, fmt and data chunks, the other chunks are skipped
+    static WavFile parseWav(const QByteArray& bytes)
+    {
+        WavFile wav;
+        if (bytes.size() < 12 || !bytes.startsWith("RIFF") || bytes.mid(8, 4) != "WAVE") {
+            return wav;
+        }
+
+        EXPECT_EQ(readUInt(bytes.constData() + 4, 4), static_cast<uint32_t>(bytes.size() - 8));
+
+        int pos = 12;
+        bool hasFormat = false;
+        while (pos + 8 <= bytes.size()) {
+            QByteArray id = bytes.mid(pos, 4);
+            int size = static_cast<int>(readUInt(bytes.constData() + pos + 4, 4));
+            const char* body = bytes.constData() + pos + 8;
+            if (pos + 8 + size > bytes.size()) {
+                return wav;
+            }
+
+            if (id == "fmt ") {
+                wav.format = static_cast<uint16_t>(readUInt(body, 2));
+                wav.channels = static_cast<uint16_t>(readUInt(body + 2, 2));
+                wav.sampleRate = readUInt(body + 4, 4);
+                wav.bitsPerSample = static_cast<uint16_t>(readUInt(body + 14, 2));
+                hasFormat = true;
+            } else if (id == "data") {
+                wav.samples.resize(size / sizeof(int16_t));
+                std::memcpy(wav.samples.data(), body, wav.samples.size() * sizeof(int16_t));
+                wav.isValid = hasFormat;
+            }
+
+            pos += 8 + size + (size & 1);
+        }
+
+        return wav;
+    }
+
+    //! frames where the left channel starts a click
+    static std::vector<uint64_t> onsetFrames(const WavFile& wav)
+    {
+        std::vector<uint64_t> onsets;
+        for (size_t frame = 0; frame < wav.samples.size() / 2; ++frame) {
+            if (wav.samples[frame * 2] > 0) {
+                onsets.push_back(frame);
+            }
+        }
+        return onsets;
+    }
+
+    static uint64_t blocksLength(uint64_t samples, unsigned int blockSize)
+    {
+        return (samples + blockSize - 1) / blockSize * blockSize;
+    }
+
+    static constexpr tick_t LAST_TICK = 1323;
+    static constexpr uint64_t SAMPLES_PER_TICK = 50;
+
+    WaveWriter m_writer;
+};
+
+TEST_F(AudioExportTests, Wav_LengthOnsetsAndHeader)
+{
+    //! GIVEN A stream of three beats with notes inside and on the edges of the blocks
+    std::vector<tick_t> ticks = { 0, 10, 441, 1000, 1322 };
+    std::shared_ptr<MidiStream> stream = makeStream(ticks, LAST_TICK);
+
+    //! WHEN It is written to a wav file
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    Ret ret = m_writer.writeStream(stream, buffer);
+    ASSERT_TRUE(ret);
+
+    //! THEN The header is a 16 bit stereo pcm at the render sample rate
+    WavFile wav = parseWav(buffer.data());
+    ASSERT_TRUE(wav.isValid);
+    IOfflineRenderer::Options options;
+    EXPECT_EQ(wav.format, 1);
+    EXPECT_EQ(wav.channels, 2);
+    EXPECT_EQ(wav.sampleRate, options.sampleRate);
+    EXPECT_EQ(wav.bitsPerSample, 16);
+
+    //! THEN The score and the tail are rendered in whole blocks
+    uint64_t tailSamples = static_cast<uint64_t>(options.tailMsec) * options.sampleRate / 1000;
+    uint64_t expectedFrames = blocksLength(LAST_TICK * SAMPLES_PER_TICK, options.blockSize)
+                              + blocksLength(tailSamples, options.blockSize);
+    EXPECT_EQ(wav.samples.size() / 2, expectedFrames);
+
+    //! THEN Each note starts exactly at the sample of its tick
+    std::vector<uint64_t> expectedOnsets;
+    for (tick_t tick : ticks) {
+        expectedOnsets.push_back(tick * SAMPLES_PER_TICK);
+    }
+    EXPECT_EQ(onsetFrames(wav), expectedOnsets);
+}
+
+TEST_F(AudioExportTests, Wav_LateChunk_KeepsOnsets)
+{
+    //! GIVEN A stream that answers the request of the second chunk from another thread, some time later
+    std::vector<tick_t> ticks = { 0, 10, 441, 1000, 1322 };
+    std::shared_ptr<MidiStream> stream = makeStream(ticks, 441);
+
+    std::thread answer;
+    stream->request.onReceive(this, [stream = stream.get(), &answer, ticks](tick_t tick) {
+        if (answer.joinable()) {
+            return;
+        }
+        answer = std::thread([stream, ticks, tick]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            stream->sendChunk(makeChunk(tick, LAST_TICK, ticks));
+        });
+    });
+
+    //! WHEN It is written to a wav file
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    Ret ret = m_writer.writeStream(stream, buffer);
+    if (answer.joinable()) {
+        answer.join();
+    }
+    ASSERT_TRUE(ret);
+
+    //! THEN The render waits for the chunk, the notes of the late chunk are not moved
+    WavFile wav = parseWav(buffer.data());
+    ASSERT_TRUE(wav.isValid);
+
+    std::vector<uint64_t> expectedOnsets;
+    for (tick_t tick : ticks) {
+        expectedOnsets.push_back(tick * SAMPLES_PER_TICK);
+    }
+    EXPECT_EQ(onsetFrames(wav), expectedOnsets);
+}
+
+TEST_F(AudioExportTests, Wav_UnansweredRequest_Fails)
+{
+    //! GIVEN A stream that never answers the request of the second chunk
+    std::shared_ptr<MidiStream> stream = makeStream({ 0, 441 }, 441);
+
+    //! WHEN It is written to a wav file
+    QBuffer buffer;
+    buffer.open(QIODevice::ReadWrite);
+    Ret ret = m_writer.writeStream(stream, buffer);
+
+    //! THEN The render gives up with an error, instead of writing silence
+    EXPECT_EQ(ret.code(), static_cast<int>(Err::AudioStreamDataNotReceived));
+}
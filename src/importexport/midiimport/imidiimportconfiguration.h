@@ -36,6 +36,10 @@ public:
 
     virtual int midiShortestNote() const = 0; //ticks
     virtual void setMidiShortestNote(int ticks) = 0;
+
+    //! NOTE Time limit for the tuplet combination search of one bar, 0 - no limit
+    virtual int midiTupletSearchTimeLimit() const = 0; // ms
+    virtual void setMidiTupletSearchTimeLimit(int ms) = 0;
 };
 }
 
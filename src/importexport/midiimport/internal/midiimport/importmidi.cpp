@@ -20,7 +20,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QElapsedTimer>
 #include <QMessageBox>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include "framework/midi_old/midifile.h"
 #include "libmscore/score.h"
@@ -74,6 +77,10 @@
 #include "importmidi_instrument.h"
 #include "importmidi_chordname.h"
 
+#include "log.h"
+#include "modularity/ioc.h"
+#include "importexport/midiimport/imidiimportconfiguration.h"
+
 #include <set>
 
 namespace Ms {
@@ -183,7 +190,8 @@ void setChordVoice(MidiChord& chord, int voice)
 void findAllTupletsForDrums(
     MTrack& mtrack,
     TimeSigMap* sigmap,
-    const ReducedFraction& basicQuant)
+    const ReducedFraction& basicQuant,
+    int tupletSearchTimeLimit)
 {
     const size_t drumVoiceCount = 2;
     // drum track has 2 voices (stem up and stem down),
@@ -206,7 +214,8 @@ void findAllTupletsForDrums(
                               MidiTuplet::TupletData> > tuplets(drumVoiceCount);
     for (size_t voice = 0; voice < drumVoiceCount; ++voice) {
         if (!chords[voice].empty()) {
-            MidiTuplet::findAllTuplets(tuplets[voice], chords[voice], sigmap, basicQuant);
+            MidiTuplet::findAllTuplets(tuplets[voice], chords[voice], sigmap, basicQuant,
+                                       tupletSearchTimeLimit);
         }
     }
     mtrack.chords.clear();
@@ -221,58 +230,92 @@ void findAllTupletsForDrums(
     // note: temporary local tuplets and chords are deleted here
 }
 
+//---------------------------------------------------------
+//   quantizeTrack
+//    uses only the track data (and the shared read-only
+//    operations), so tracks can be quantized concurrently
+//---------------------------------------------------------
+
+void quantizeTrack(MTrack& mtrack,
+                   TimeSigMap* sigmap,
+                   const ReducedFraction& lastTick,
+                   int tupletSearchTimeLimit)
+{
+    auto& opers = midiImportOperations;
+
+    // pass current track index through MidiImportOperations
+    // for further usage
+    MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
+
+    const auto basicQuant = Quantize::quantValueToFraction(
+        opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
+#ifdef QT_DEBUG
+    Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
+               "quantizeTrack", "Last tick is less than max note off time");
+#endif
+    MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
+
+    if (mtrack.mtrack->drumTrack()) {
+        findAllTupletsForDrums(mtrack, sigmap, basicQuant, tupletSearchTimeLimit);
+    } else {
+        MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant,
+                                   tupletSearchTimeLimit);
+    }
+#ifdef QT_DEBUG
+    Q_ASSERT_X(!doNotesOverlap(mtrack),
+               "quantizeTrack",
+               "There are overlapping notes of the same voice that is incorrect");
+#endif
+    // (4/3 of the smallest duration) tol is less sensitive
+    // to on time inaccuracies than 1/2 earlier
+    MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
+    Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
+    MidiTuplet::removeEmptyTuplets(mtrack);
+#ifdef QT_DEBUG
+    Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
+               "quantizeTrack", "Tuplet chord/note is outside tuplet "
+                                "or non-tuplet chord/note is inside tuplet");
+#endif
+}
+
+//---------------------------------------------------------
+//   quantizeAllTracks
+//    the tuplet search dominates the import time, so the tracks
+//    are quantized in parallel; they don't share any data here,
+//    the result doesn't depend on the order of processing
+//---------------------------------------------------------
+
 void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
                        TimeSigMap* sigmap,
                        const ReducedFraction& lastTick)
 {
     auto& opers = midiImportOperations;
 
+    std::vector<MTrack*> tracksToQuantize;
     for (auto& track: tracks) {
         MTrack& mtrack = track.second;
         if (mtrack.chords.empty()) {
             continue;
         }
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
-
+        // operations are shared by all tracks - change them before going parallel
         if (opers.data()->processingsOfOpenedFile == 0) {
             opers.data()->trackOpers.isDrumTrack.setValue(
-                opers.currentTrack(), mtrack.mtrack->drumTrack());
+                mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
             if (mtrack.mtrack->drumTrack()) {
                 opers.data()->trackOpers.maxVoiceCount.setValue(
-                    opers.currentTrack(), MidiOperations::VoiceCount::V_1);
+                    mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
             }
         }
-        const auto basicQuant = Quantize::quantValueToFraction(
-            opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
-#ifdef QT_DEBUG
-        Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
-                   "quantizeAllTracks", "Last tick is less than max note off time");
-#endif
-        MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
-
-        if (mtrack.mtrack->drumTrack()) {
-            findAllTupletsForDrums(mtrack, sigmap, basicQuant);
-        } else {
-            MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
-        }
-#ifdef QT_DEBUG
-        Q_ASSERT_X(!doNotesOverlap(track.second),
-                   "quantizeAllTracks",
-                   "There are overlapping notes of the same voice that is incorrect");
-#endif
-        // (4/3 of the smallest duration) tol is less sensitive
-        // to on time inaccuracies than 1/2 earlier
-        MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
-        Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
-        MidiTuplet::removeEmptyTuplets(mtrack);
-#ifdef QT_DEBUG
-        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
-                   "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
-                                        "or non-tuplet chord/note is inside tuplet");
-#endif
+        tracksToQuantize.push_back(&mtrack);
     }
+
+    // the configuration is not thread-safe, read it here once for all tracks
+    auto conf = mu::framework::ioc()->resolve<mu::iex::midiimport::IMidiImportConfiguration>("iex_midiimport");
+    const int tupletSearchTimeLimit = conf ? conf->midiTupletSearchTimeLimit() : 0;
+
+    QtConcurrent::blockingMap(tracksToQuantize, [sigmap, &lastTick, tupletSearchTimeLimit](MTrack* mtrack) {
+        quantizeTrack(*mtrack, sigmap, lastTick, tupletSearchTimeLimit);
+    });
 }
 
 //---------------------------------------------------------
@@ -1104,8 +1147,32 @@ ReducedFraction findLastChordTick(const std::multimap<int, MTrack>& tracks)
     return lastTick;
 }
 
+//---------------------------------------------------------
+//   StageTimer
+//    durations of the import stages, for the log
+//---------------------------------------------------------
+
+class StageTimer
+{
+public:
+    StageTimer() { _timer.start(); }
+
+    void stage(const QString& name)
+    {
+        _stages.append(QString("%1 %2 ms").arg(name).arg(_timer.nsecsElapsed() / 1e6, 0, 'f', 1));
+        _timer.restart();
+    }
+
+    QString toString() const { return _stages.join(", "); }
+
+private:
+    QElapsedTimer _timer;
+    QStringList _stages;
+};
+
 QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
 {
+    StageTimer timer;
     auto* sigmap = score->sigmap();
 
     auto tracks = createMTrackList(sigmap, mf);
@@ -1126,6 +1193,8 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
         }
         MidiLyrics::extractLyricsToMidiData(mf);
     }
+    timer.stage("tracks");
+
     // for newly opened MIDI file - detect if it is a human performance
     // if so - detect beats and set initial time signature
     if (opers.data()->processingsOfOpenedFile == 0) {
@@ -1143,6 +1212,7 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     MChord::collectChords(tracks, { 2, 1 }, { 1, 2 });
     MidiBeat::adjustChordsToBeats(tracks);
     MChord::mergeChordsWithEqualOnTimeAndVoice(tracks);
+    timer.stage("beats");
 
     // for newly opened MIDI file
     if (opers.data()->processingsOfOpenedFile == 0
@@ -1158,8 +1228,12 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     LRHand::splitIntoLeftRightHands(tracks);
     MidiDrum::splitDrumVoices(tracks);
     MidiDrum::splitDrumTracks(tracks);
+    timer.stage("split");
+
     ReducedFraction lastTick = findLastChordTick(tracks);
     quantizeAllTracks(tracks, sigmap, lastTick);
+    timer.stage(QString("quantize (%1 threads)").arg(QThreadPool::globalInstance()->maxThreadCount()));
+
     MChord::removeOverlappingNotes(tracks);
 #ifdef QT_DEBUG
     Q_ASSERT_X(!doNotesOverlap(tracks),
@@ -1174,12 +1248,15 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     }
     Simplify::simplifyDurationsForDrums(tracks, sigmap);
     MChord::splitUnequalChords(tracks);
+    timer.stage("voices");
+
     // no more track insertion/reordering/deletion from now
     QList<MTrack> trackList = prepareTrackList(tracks);
     MidiInstr::setGrandStaffProgram(trackList);
     MidiInstr::findInstrumentsForAllTracks(trackList);
     MidiInstr::createInstruments(score, trackList);
     MidiDrum::setStaffBracketForDrums(trackList);
+    timer.stage("instruments");
 
     const auto firstTick = findFirstChordTick(trackList);
 
@@ -1190,14 +1267,23 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     MidiKey::recognizeMainKeySig(trackList);
     createNotes(lastTick, trackList);
     processLyricMeta(trackList);
+    timer.stage("notes");
+
     applySwing(trackList);
+    timer.stage("swing");
+
     createClefs(trackList);
+    timer.stage("clefs");
+
     createTimeSignatures(score);
     score->connectTies();
 
     MidiLyrics::setLyricsToScore(trackList);
     MidiTempo::setTempo(tracks, score);
     MidiChordName::setChordNames(trackList);
+    timer.stage("finish");
+
+    LOGD() << "tracks: " << trackList.size() << ", " << timer.toString();
 
     return trackList;
 }
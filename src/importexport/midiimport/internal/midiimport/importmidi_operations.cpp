@@ -310,10 +310,16 @@ bool Data::hasMidiFile(const QString& fileName)
 
 int Data::currentTrack() const
 {
-    Q_ASSERT_X(_currentTrack >= 0,
+    Q_ASSERT_X(currentTrackRef() >= 0,
                "Data::currentTrack", "Invalid current track index");
 
-    return _currentTrack;
+    return currentTrackRef();
+}
+
+int& Data::currentTrackRef() const
+{
+    thread_local int currentTrack = -1;
+    return currentTrack;
 }
 
 void Data::setOperationsFile(const QString& fileName)
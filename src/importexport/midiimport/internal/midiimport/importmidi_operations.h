@@ -254,9 +254,11 @@ private:
     friend class CurrentTrackSetter;
     friend class CurrentMidiFileSetter;
 
+    // current track is per thread: the tracks are quantized concurrently
+    int& currentTrackRef() const;
+
     QString _currentMidiFile;
     QString _midiOperationsFile;
-    int _currentTrack = -1;
 
     std::map<QString, FileData> _data;      // <file name, tracks data>
 };
@@ -268,13 +270,13 @@ public:
     CurrentTrackSetter(Data& opers, int track)
         : _opers(opers)
     {
-        _oldValue = _opers._currentTrack;
-        _opers._currentTrack = track;
+        _oldValue = _opers.currentTrackRef();
+        _opers.currentTrackRef() = track;
     }
 
     ~CurrentTrackSetter()
     {
-        _opers._currentTrack = _oldValue;
+        _opers.currentTrackRef() = _oldValue;
     }
 
 private:
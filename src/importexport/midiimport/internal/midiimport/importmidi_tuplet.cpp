@@ -1077,7 +1077,8 @@ void findTuplets(
     const ReducedFraction& basicQuant,
     std::multimap<ReducedFraction, TupletData>& tupletEvents,
     const TimeSigMap* sigmap,
-    int barIndex)
+    int barIndex,
+    int searchTimeLimitMs)
 {
     if (chords.empty() || startBarChordIt == endBarChordIt) {
         return;
@@ -1101,7 +1102,7 @@ void findTuplets(
         return;
     }
 
-    filterTuplets(tuplets, basicQuant);
+    filterTuplets(tuplets, basicQuant, searchTimeLimitMs);
     // later notes will be sorted and their indexes become invalid
     // so assign staccato information to notes now
     if (opers.simplifyDurations.value(currentTrack)) {
@@ -1169,7 +1170,8 @@ void findAllTuplets(
     std::multimap<ReducedFraction, TupletData>& tuplets,
     std::multimap<ReducedFraction, MidiChord>& chords,
     const TimeSigMap* sigmap,
-    const ReducedFraction& basicQuant)
+    const ReducedFraction& basicQuant,
+    int searchTimeLimitMs)
 {
     if (chords.empty()) {
         return;
@@ -1192,7 +1194,7 @@ void findAllTuplets(
             if (endBarIt->second.barIndex > currentBarIndex) {
                 const size_t oldTupletCount = tuplets.size();
                 findTuplets(startBarIt, endBarIt, chords, basicQuant,
-                            tuplets, sigmap, currentBarIndex);
+                            tuplets, sigmap, currentBarIndex, searchTimeLimitMs);
 
                 Q_ASSERT_X(tuplets.size() >= oldTupletCount, "MidiTuplet::findAllTuplets",
                            "Some old tuplets were deleted that is incorrect");
@@ -1233,7 +1235,7 @@ void findAllTuplets(
         }
         // handle the last bar containing chords
         findTuplets(startBarIt, chords.end(), chords, basicQuant, tuplets,
-                    sigmap, startBarIt->second.barIndex);
+                    sigmap, startBarIt->second.barIndex, searchTimeLimitMs);
     }
     // check if there are not detected off times inside tuplets
     setAllTupletOffTimes(tuplets, chords, sigmap);
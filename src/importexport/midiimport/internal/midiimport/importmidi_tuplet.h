@@ -102,7 +102,7 @@ findTupletContainingTime(int voice, const ReducedFraction& time, const std::mult
 
 void findAllTuplets(
     std::multimap<ReducedFraction, TupletData>& tuplets, std::multimap<ReducedFraction, MidiChord>& chords, const TimeSigMap* sigmap,
-    const ReducedFraction& basicQuant);
+    const ReducedFraction& basicQuant, int searchTimeLimitMs);
 
 ReducedFraction findOnTimeBetweenChords(
     const std::pair<const ReducedFraction, MidiChord>& chord, const std::multimap<ReducedFraction, MidiChord>& chords,
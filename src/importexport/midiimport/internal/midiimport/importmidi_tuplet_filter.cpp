@@ -28,6 +28,7 @@
 #include "libmscore/mscore.h"
 
 #include <set>
+#include <QElapsedTimer>
 
 namespace Ms {
 namespace MidiTuplet {
@@ -261,17 +262,73 @@ bool isInCommonIndexes(
     return false;
 }
 
+//---------------------------------------------------------
+//   TupletSearchData
+//    values that don't change during the search
+//    of the best tuplet combination, computed once
+//---------------------------------------------------------
+
+class TupletSearchData
+{
+public:
+    TupletSearchData(const std::vector<TupletInfo>& tuplets,
+                     const ReducedFraction& basicQuant,
+                     int timeLimitMs)
+        : _tupletChordIds(tuplets.size())
+        , _timeLimitMs(timeLimitMs)
+    {
+        // chords can be shared between tuplets, so give each chord a unique id
+        std::map<const std::pair<const ReducedFraction, MidiChord>*, int> chordIds;
+        for (size_t i = 0; i != tuplets.size(); ++i) {
+            for (const auto& chord: tuplets[i].chords) {
+                const auto* chordPtr = &*chord.second;
+                auto it = chordIds.find(chordPtr);
+                if (it == chordIds.end()) {
+                    it = chordIds.insert({ chordPtr, int(_chordQuantErrors.size()) }).first;
+                    _chordQuantErrors.push_back(Quantize::findOnTimeQuantError(*chordPtr, basicQuant));
+                }
+                _tupletChordIds[i].push_back(it->second);
+            }
+        }
+        if (_timeLimitMs > 0) {
+            _timer.start();
+        }
+    }
+
+    size_t chordCount() const { return _chordQuantErrors.size(); }
+    const std::vector<int>& tupletChordIds(int tupletIndex) const { return _tupletChordIds[tupletIndex]; }
+    const ReducedFraction& chordQuantError(int chordId) const { return _chordQuantErrors[chordId]; }
+
+    bool isTimeOut()
+    {
+        if (_timeLimitMs <= 0) {
+            return false;
+        }
+        if (!_isTimeOut) {
+            _isTimeOut = _timer.elapsed() >= _timeLimitMs;
+        }
+        return _isTimeOut;
+    }
+
+private:
+    std::vector<std::vector<int> > _tupletChordIds;
+    std::vector<ReducedFraction> _chordQuantErrors;
+    int _timeLimitMs = 0;
+    QElapsedTimer _timer;
+    bool _isTimeOut = false;
+};
+
 TupletErrorResult findTupletError(
     const std::vector<int>& tupletIndexes,
     const std::vector<TupletInfo>& tuplets,
     size_t voiceCount,
-    const ReducedFraction& basicQuant)
+    const TupletSearchData& searchData)
 {
     ReducedFraction sumError{ 0, 1 };
     ReducedFraction sumLengthOfRests{ 0, 1 };
     size_t sumChordCount = 0;
     int sumChordPlaces = 0;
-    std::set<std::pair<const ReducedFraction, MidiChord>*> usedChords;
+    std::vector<char> usedChords(searchData.chordCount(), 0);
     std::vector<char> usedIndexes(tuplets.size(), 0);
 
     for (int i: tupletIndexes) {
@@ -283,8 +340,8 @@ TupletErrorResult findTupletError(
         sumChordPlaces += tuplet.tupletNumber;
 
         usedIndexes[i] = 1;
-        for (const auto& chord: tuplet.chords) {
-            usedChords.insert(&*chord.second);
+        for (int chordId: searchData.tupletChordIds(i)) {
+            usedChords[chordId] = 1;
         }
     }
     // add quant error of all chords excluded from tuplets
@@ -292,12 +349,11 @@ TupletErrorResult findTupletError(
         if (usedIndexes[i]) {
             continue;
         }
-        const auto& tuplet = tuplets[i];
-        for (const auto& chord: tuplet.chords) {
-            if (usedChords.find(&*chord.second) != usedChords.end()) {
+        for (int chordId: searchData.tupletChordIds(int(i))) {
+            if (usedChords[chordId]) {
                 continue;
             }
-            sumError += Quantize::findOnTimeQuantError(*chord.second, basicQuant);
+            sumError += searchData.chordQuantError(chordId);
         }
     }
 
@@ -473,11 +529,11 @@ void tryUpdateBestIndexes(
     const std::vector<int>& selectedTuplets,
     const std::vector<TupletInfo>& tuplets,
     const std::map<int, std::vector<std::pair<ReducedFraction, ReducedFraction> > >& voiceIntervals,
-    const ReducedFraction& basicQuant)
+    const TupletSearchData& searchData)
 {
     const size_t voiceCount = voiceIntervals.size();
     const auto error = findTupletError(selectedTuplets, tuplets,
-                                       voiceCount, basicQuant);
+                                       voiceCount, searchData);
     if (!minCurrentError.isInitialized() || error < minCurrentError) {
         minCurrentError = error;
         bestTupletIndexes = selectedTuplets;
@@ -582,9 +638,13 @@ void findNextTuplet(
     const std::vector<TupletInfo>& tuplets,
     const std::vector<std::pair<ReducedFraction, ReducedFraction> >& tupletIntervals,
     size_t commonsSize,
-    const ReducedFraction& basicQuant)
+    TupletSearchData& searchData)
 {
     while (!validTuplets.empty()) {
+        // keep the best combination found so far if the search takes too long
+        if (searchData.isTimeOut()) {
+            return;
+        }
         size_t index = validTuplets.first();
 
         bool isCommonGroupBegins = (selectedTuplets.empty() && index == commonsSize);
@@ -621,7 +681,7 @@ void findNextTuplet(
             }
             if (!canAddMoreIndexes) {
                 tryUpdateBestIndexes(bestTupletIndexes, minCurrentError,
-                                     selectedTuplets, tuplets, voiceIntervals, basicQuant);
+                                     selectedTuplets, tuplets, voiceIntervals, searchData);
             }
             return;
         }
@@ -658,11 +718,11 @@ void findNextTuplet(
             }
             if (!canAddMoreIndexes) {
                 tryUpdateBestIndexes(bestTupletIndexes, minCurrentError,
-                                     selectedTuplets, tuplets, voiceIntervals, basicQuant);
+                                     selectedTuplets, tuplets, voiceIntervals, searchData);
             }
         } else {
             findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                           tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                           tupletCommons, tuplets, tupletIntervals, commonsSize, searchData);
         }
 
         selectedTuplets.pop_back();
@@ -692,7 +752,8 @@ std::vector<int> findBestTuplets(
     const std::vector<TupletCommon>& tupletCommons,
     const std::vector<TupletInfo>& tuplets,
     size_t commonsSize,
-    const ReducedFraction& basicQuant)
+    const ReducedFraction& basicQuant,
+    int searchTimeLimitMs)
 {
     std::vector<int> bestTupletIndexes;
     std::vector<int> selectedTuplets;
@@ -700,9 +761,21 @@ std::vector<int> findBestTuplets(
     const auto tupletIntervals = findTupletIntervals(tuplets, basicQuant);
 
     ValidTuplets validTuplets(int(tuplets.size()));
+    TupletSearchData searchData(tuplets, basicQuant, searchTimeLimitMs);
 
     findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                   tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                   tupletCommons, tuplets, tupletIntervals, commonsSize, searchData);
+
+    if (searchData.isTimeOut()) {
+        qDebug("MIDI import: tuplet search time limit exceeded, using the best combination found so far");
+        // the search may be stopped before any combination is evaluated;
+        // the longest uncommon group is always a valid one
+        if (bestTupletIndexes.empty() && tuplets.size() > commonsSize) {
+            for (size_t i = commonsSize; i != tuplets.size(); ++i) {
+                bestTupletIndexes.push_back(int(i));
+            }
+        }
+    }
 
     return bestTupletIndexes;
 }
@@ -745,7 +818,8 @@ void removeExtraTuplets(std::vector<TupletInfo>& tuplets)
 // to be split into different voices
 
 void filterTuplets(std::vector<TupletInfo>& tuplets,
-                   const ReducedFraction& basicQuant)
+                   const ReducedFraction& basicQuant,
+                   int searchTimeLimitMs)
 {
     if (tuplets.empty()) {
         return;
@@ -771,7 +845,8 @@ void filterTuplets(std::vector<TupletInfo>& tuplets,
     const auto tupletCommons = findTupletCommons(tuplets);
 
     const std::vector<int> bestIndexes = findBestTuplets(tupletCommons, tuplets,
-                                                         commonsSize, basicQuant);
+                                                         commonsSize, basicQuant,
+                                                         searchTimeLimitMs);
 #ifdef QT_DEBUG
     Q_ASSERT_X(validateSelectedTuplets(bestIndexes.begin(), bestIndexes.end(), tuplets),
                "MIDI tuplets: filterTuplets", "Tuplets have common chords but they shouldn't");
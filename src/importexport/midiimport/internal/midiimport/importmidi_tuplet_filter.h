@@ -30,7 +30,7 @@ class ReducedFraction;
 namespace MidiTuplet {
 struct TupletInfo;
 
-void filterTuplets(std::vector<TupletInfo>& tuplets, const ReducedFraction& basicQuant);
+void filterTuplets(std::vector<TupletInfo>& tuplets, const ReducedFraction& basicQuant, int searchTimeLimitMs);
 } // namespace MidiTuplet
 } // namespace Ms
 
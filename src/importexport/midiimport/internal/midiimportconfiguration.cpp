@@ -29,10 +29,12 @@ using namespace mu::framework;
 using namespace mu::iex::midiimport;
 
 static const Settings::Key SHORTEST_NOTE_KEY("iex_midiimport", "io/midi/shortestNote");
+static const Settings::Key TUPLET_SEARCH_TIME_LIMIT_KEY("iex_midiimport", "io/midi/tupletSearchTimeLimit");
 
 void MidiImportConfiguration::init()
 {
     settings()->setDefaultValue(SHORTEST_NOTE_KEY, Val(Ms::MScore::division / 4));
+    settings()->setDefaultValue(TUPLET_SEARCH_TIME_LIMIT_KEY, Val(0));
 }
 
 int MidiImportConfiguration::midiShortestNote() const
@@ -44,3 +46,13 @@ void MidiImportConfiguration::setMidiShortestNote(int ticks)
 {
     settings()->setValue(SHORTEST_NOTE_KEY, Val(ticks));
 }
+
+int MidiImportConfiguration::midiTupletSearchTimeLimit() const
+{
+    return settings()->value(TUPLET_SEARCH_TIME_LIMIT_KEY).toInt();
+}
+
+void MidiImportConfiguration::setMidiTupletSearchTimeLimit(int ms)
+{
+    settings()->setValue(TUPLET_SEARCH_TIME_LIMIT_KEY, Val(ms));
+}
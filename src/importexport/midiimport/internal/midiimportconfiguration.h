@@ -32,6 +32,9 @@ public:
 
     int midiShortestNote() const override; // ticks
     void setMidiShortestNote(int ticks) override;
+
+    int midiTupletSearchTimeLimit() const override; // ms
+    void setMidiTupletSearchTimeLimit(int ms) override;
 };
 }
 
@@ -430,6 +430,9 @@ private slots:
 
     // gui - tracks model
     void testGuiTracksModel();
+
+    // performance of the tuplet combination search
+    void benchmarkTupletFilter();
 };
 
 //---------------------------------------------------------
@@ -1227,6 +1230,41 @@ void TestImportMidi::testGuiTracksModel()
     QCOMPARE(model.flags(model.index(0, channelCol)), notEditableFlags);
 }
 
+//---------------------------------------------------------
+//   benchmarkTupletFilter
+//    import the files with the largest number of
+//    competing tuplets; the resulting tuplets
+//    are checked by the tuplet tests above
+//---------------------------------------------------------
+
+void TestImportMidi::benchmarkTupletFilter()
+{
+    const QStringList midiFiles = {
+        "tuplet_2_voices_3_5_tuplets",
+        "tuplet_3_5_7_tuplets",
+        "tuplet_5_5_tuplets_rests",
+        "tuplet_mars",
+        "tuplet_tied_3_5_tuplets",
+        "voice_tuplet"
+    };
+
+    auto& opers = midiImportOperations;
+    for (const QString& midiFile : midiFiles) {
+        opers.addNewMidiFile(midiFilePath(midiFile));
+    }
+
+    QBENCHMARK {
+        for (const QString& midiFile : midiFiles) {
+            const QString midiFileFullPath = midiFilePath(midiFile);
+            MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, midiFileFullPath);
+
+            MasterScore score(mscore->baseStyle());
+            score.setName(midiFile);
+            QCOMPARE(importMidi(&score, midiFileFullPath), Score::FileError::FILE_NO_ERROR);
+        }
+    }
+}
+
 QTEST_MAIN(TestImportMidi)
 
 #include "tst_importmidi.moc"
@@ -39,6 +39,10 @@ public:
     virtual bool musicxmlImportLayout() const = 0;
     virtual void setMusicxmlImportLayout(bool value) = 0;
 
+    //! NOTE The schema validation runs alongside the import, off means no validation at all
+    virtual bool musicxmlImportValidation() const = 0;
+    virtual void setMusicxmlImportValidation(bool value) = 0;
+
     virtual bool musicxmlExportLayout() const = 0;
     virtual void setMusicxmlExportLayout(bool value) = 0;
 
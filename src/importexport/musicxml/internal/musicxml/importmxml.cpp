@@ -34,7 +34,8 @@
 #include "importmxmlpass2.h"
 
 namespace Ms {
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev)
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev,
+                                          const std::function<Score::FileError()>& checkBeforePass2)
 {
     //qDebug("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
     //       score, qPrintable(name), dev);
@@ -52,6 +53,13 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
         return res;
     }
 
+    if (checkBeforePass2) {
+        res = checkBeforePass2();
+        if (res != Score::FileError::FILE_NO_ERROR) {
+            return res;
+        }
+    }
+
     // pass 2
     dev->seek(0);
     MusicXMLParserPass2 pass2(score, pass1, &logger);
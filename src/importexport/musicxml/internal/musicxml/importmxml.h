@@ -28,7 +28,14 @@
 #include "musicxml.h" // for the creditwords definition
 #include "musicxmlsupport.h"
 
+#include <functional>
+
 namespace Ms {
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev);
+/**
+ Import MusicXML from \a dev into \a score. If \a checkBeforePass2 is set, it is called
+ after pass 1 and pass 2 only runs when it returns FILE_NO_ERROR.
+ */
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev,
+                                          const std::function<Score::FileError()>& checkBeforePass2 = nullptr);
 } // namespace Ms
 #endif
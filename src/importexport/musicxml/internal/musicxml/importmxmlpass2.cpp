@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <cmath>
@@ -1792,17 +1793,29 @@ void MusicXMLParserPass2::part()
 //---------------------------------------------------------
 
 /**
- In Score \a score find the measure starting at \a tick.
+ In Score \a score find the first measure starting at \a tick.
+ Pass 1 creates zero-length measures, which start at the same tick as
+ the next measure, so this is not the same as Score::tick2measure().
+ Uses the tick index of the measure list: called for every measure
+ of every part, a walk from the first measure made pass 2 quadratic.
  */
 
 static Measure* findMeasure(Score* score, const Fraction& tick)
 {
-    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
-        if (m->tick() == tick) {
-            return m;
+    const std::vector<Measure*>* index = score->measures()->tickIndex();
+    if (!index) {
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            if (m->tick() == tick) {
+                return m;
+            }
         }
+        return 0;
     }
-    return 0;
+
+    auto it = std::lower_bound(index->begin(), index->end(), tick, [](const Measure* m, const Fraction& t) {
+        return m->tick() < t;
+    });
+    return (it != index->end() && (*it)->tick() == tick) ? *it : 0;
 }
 
 //---------------------------------------------------------
@@ -28,10 +28,14 @@
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
 #include <QBuffer>
+#include <QtConcurrent>
 
 #include "thirdparty/qzip/qzipreader_p.h"
 #include "importmxml.h"
 
+#include "modularity/ioc.h"
+#include "importexport/musicxml/imusicxmlconfiguration.h"
+
 namespace Ms {
 //---------------------------------------------------------
 //   tupletAssert -- check assertions for tuplet handling
@@ -62,18 +66,29 @@ static void tupletAssert()
     }
 }
 
+//---------------------------------------------------------
+//   ValidationResult
+//---------------------------------------------------------
+
+struct ValidationResult {
+    bool schemaLoaded = true;
+    bool valid = true;
+    QString error;              // why the schema could not be loaded
+    QString details;            // the validation errors
+};
+
 //---------------------------------------------------------
 //   initMusicXmlSchema
 //    return false on error
 //---------------------------------------------------------
 
-static bool initMusicXmlSchema(QXmlSchema& schema)
+static bool initMusicXmlSchema(QXmlSchema& schema, QString& error)
 {
     // read the MusicXML schema from the application resources
     QFile schemaFile(":/schema/musicxml.xsd");
     if (!schemaFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
         qDebug("initMusicXmlSchema() could not open resource musicxml.xsd");
-        MScore::lastError = QObject::tr("Internal error: Could not open resource musicxml.xsd\n");
+        error = QObject::tr("Internal error: Could not open resource musicxml.xsd\n");
         return false;
     }
 
@@ -95,7 +110,7 @@ static bool initMusicXmlSchema(QXmlSchema& schema)
     schema.load(schemaBa);
     if (!schema.isValid()) {
         qDebug("initMusicXmlSchema() internal error: MusicXML schema is invalid");
-        MScore::lastError = QObject::tr("Internal error: MusicXML schema is invalid\n");
+        error = QObject::tr("Internal error: MusicXML schema is invalid\n");
         return false;
     }
 
@@ -181,37 +196,61 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 }
 
 //---------------------------------------------------------
-//   doValidate
+//   validate
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Validate MusicXML \a data from file \a name.
+ Runs in a worker thread, so it must not touch MScore::lastError or the GUI.
  */
 
-static Score::FileError doValidate(const QString& name, QIODevice* dev)
+static ValidationResult validate(const QString& name, const QByteArray& data)
 {
     //QElapsedTimer t;
     //t.start();
 
+    ValidationResult result;
+
     // initialize the schema
     ValidatorMessageHandler messageHandler;
     QXmlSchema schema;
     schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
-        return Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by initMusicXmlSchema
+    if (!initMusicXmlSchema(schema, result.error)) {
+        result.schemaLoaded = false;
+        return result;
     }
+
     // validate the data
     QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
+    result.valid = validator.validate(data, QUrl::fromLocalFile(name));
+    result.details = messageHandler.getErrors();
     //qDebug("Validation time elapsed: %d ms", t.elapsed());
 
-    if (!valid) {
+    return result;
+}
+
+//---------------------------------------------------------
+//   checkValidationResult
+//---------------------------------------------------------
+
+/**
+ Report the validation of file \a name, ask the user whether to keep an invalid file.
+ */
+
+static Score::FileError checkValidationResult(const QString& name, const ValidationResult& result)
+{
+    if (!result.schemaLoaded) {
+        MScore::lastError = result.error;
+        return Score::FileError::FILE_BAD_FORMAT;
+    }
+
+    if (!result.valid) {
         qDebug("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
         MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
         if (MScore::noGui) {
             return Score::FileError::FILE_NO_ERROR;         // might as well try anyhow in converter mode
         }
-        if (musicXMLValidationErrorDialog(MScore::lastError, messageHandler.getErrors()) != QMessageBox::Yes) {
+        if (musicXMLValidationErrorDialog(MScore::lastError, result.details) != QMessageBox::Yes) {
             return Score::FileError::FILE_USER_ABORT;
         }
     }
@@ -220,29 +259,52 @@ static Score::FileError doValidate(const QString& name, QIODevice* dev)
     return Score::FileError::FILE_NO_ERROR;
 }
 
+//---------------------------------------------------------
+//   isValidationEnabled
+//---------------------------------------------------------
+
+static bool isValidationEnabled()
+{
+    auto configuration = mu::framework::ioc()->resolve<mu::iex::musicxml::IMusicXmlConfiguration>("iex_musicxml");
+    return configuration ? configuration->musicxmlImportValidation() : true;
+}
+
 //---------------------------------------------------------
 //   doValidateAndImport
 //---------------------------------------------------------
 
 /**
- Validate and import MusicXML data from file \a name contained in QIODevice \a dev into score \a score.
+ Validate and import MusicXML \a data from file \a name into score \a score.
+ The file is read only once: the validation runs in a worker thread on the same
+ data while pass 1 reads it from memory. The result is checked before pass 2,
+ so an invalid file is not imported completely before the user decides to keep it.
  */
 
-static Score::FileError doValidateAndImport(Score* score, const QString& name, QIODevice* dev)
+static Score::FileError doValidateAndImport(Score* score, const QString& name, const QByteArray& data)
 {
     // verify tuplet TDuration::DurationType dependencies
     tupletAssert();
 
     // validate the file
-    Score::FileError res;
-    res = doValidate(name, dev);
-    if (res != Score::FileError::FILE_NO_ERROR) {
-        return res;
+    QFuture<ValidationResult> validation;
+    std::function<Score::FileError()> checkValidation;
+    if (isValidationEnabled()) {
+        validation = QtConcurrent::run(validate, name, data);
+        checkValidation = [&validation, &name]() {
+            return checkValidationResult(name, validation.result());
+        };
     }
 
     // actually do the import
-    res = importMusicXMLfromBuffer(score, name, dev);
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    Score::FileError res = importMusicXMLfromBuffer(score, name, &buffer, checkValidation);
     //qDebug("importMusicXml() return %d", int(res));
+
+    //! NOTE When pass 1 fails, the validation is not waited for by the check
+    validation.waitForFinished();
+
     return res;
 }
 
@@ -266,7 +328,7 @@ Score::FileError importMusicXml(MasterScore* score, QIODevice* dev, const QStrin
     }
 
     // and import it
-    return doValidateAndImport(score, name, dev);
+    return doValidateAndImport(score, name, dev->readAll());
 }
 
 Score::FileError importMusicXml(MasterScore* score, const QString& name)
@@ -287,7 +349,7 @@ Score::FileError importMusicXml(MasterScore* score, const QString& name)
     }
 
     // and import it
-    return doValidateAndImport(score, name, &xmlFile);
+    return doValidateAndImport(score, name, xmlFile.readAll());
 }
 
 //---------------------------------------------------------
@@ -319,11 +381,9 @@ Score::FileError importCompressedMusicXml(MasterScore* score, const QString& nam
     if (!extractRootfile(&mxlFile, data)) {
         return Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by extractRootfile
     }
-    QBuffer buffer(&data);
-    buffer.open(QIODevice::ReadOnly);
 
     // and import it
-    return doValidateAndImport(score, name, &buffer);
+    return doValidateAndImport(score, name, data);
 }
 
 //---------------------------------------------------------
@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QDirIterator>
+#include <QElapsedTimer>
+
+#include <vector>
+
+#include "testing/qtestsuite.h"
+
+#include "testbase.h"
+
+#include "libmscore/score.h"
+#include "importexport/musicxml/internal/musicxml/exportxml.h"
+
+#include "runtime.h"
+#include "settings.h"
+
+using namespace mu;
+using namespace mu::framework;
+
+namespace Ms {
+extern Score::FileError importMusicXml(MasterScore*, const QString&);
+extern Score::FileError importCompressedMusicXml(MasterScore*, const QString&);
+}
+
+//! NOTE Directory with the MusicXML files to measure, the benchmark is skipped when not set
+static const char* CORPUS_ENV("MUSICXML_BENCHMARK_CORPUS");
+
+static const std::string MODULE_NAME("importexport");
+static const std::string PREF_IMPORT_MUSICXML_VALIDATION("import/musicXML/validation");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestMxmlBenchmark
+//    import and export throughput, not a regression test:
+//    reports MB/s and peak memory, import with and without
+//    the validation. Opt-in, runs only with CORPUS_ENV set
+//---------------------------------------------------------
+
+class TestMxmlBenchmark : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QStringList corpus() const;
+    void importCorpus(bool validation);
+
+private slots:
+    void initTestCase();
+    void importWithoutValidation() { importCorpus(false); }
+    void importWithValidation() { importCorpus(true); }
+    void exportCorpus();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestMxmlBenchmark::initTestCase()
+{
+    if (qEnvironmentVariableIsEmpty(CORPUS_ENV)) {
+        QSKIP("set MUSICXML_BENCHMARK_CORPUS to the directory of the files to measure");
+    }
+
+    initMTest(QString(iex_musicxml_tests_DATA_ROOT));
+}
+
+//---------------------------------------------------------
+//   corpus
+//---------------------------------------------------------
+
+QStringList TestMxmlBenchmark::corpus() const
+{
+    QString dir = qEnvironmentVariable(CORPUS_ENV);
+
+    QStringList files;
+    QDirIterator it(dir, { "*.xml", "*.musicxml", "*.mxl" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files << it.next();
+    }
+    files.sort();
+    return files;
+}
+
+//---------------------------------------------------------
+//   importCorpus
+//---------------------------------------------------------
+
+void TestMxmlBenchmark::importCorpus(bool validation)
+{
+    settings()->setValue(Settings::Key(MODULE_NAME, PREF_IMPORT_MUSICXML_VALIDATION), Val(validation));
+
+    QStringList files = corpus();
+    QVERIFY(!files.isEmpty());
+
+    qint64 bytes = 0;
+    qint64 elapsedNs = 0;
+    int failed = 0;
+
+    QBENCHMARK {
+        failed = 0;
+        for (const QString& path : files) {
+            MasterScore* score = new MasterScore(mscore->baseStyle());
+            score->setName(QFileInfo(path).completeBaseName());
+
+            QElapsedTimer timer;
+            timer.start();
+
+            ScoreLoad sl;
+            Score::FileError rv = path.endsWith(".mxl", Qt::CaseInsensitive)
+                                  ? importCompressedMusicXml(score, path)
+                                  : importMusicXml(score, path);
+
+            elapsedNs += timer.nsecsElapsed();
+            bytes += QFileInfo(path).size();
+            if (rv != Score::FileError::FILE_NO_ERROR) {
+                ++failed;
+            }
+
+            delete score;
+        }
+    }
+
+    qDebug("MusicXML import, validation %s: %d files (%d failed), %s",
+           validation ? "on" : "off", int(files.size()), failed,
+           runtime::throughputInfo(bytes, elapsedNs / 1e9).c_str());
+
+    settings()->setValue(Settings::Key(MODULE_NAME, PREF_IMPORT_MUSICXML_VALIDATION), Val(true));
+}
+
+//---------------------------------------------------------
+//   exportCorpus
+//    only the export is timed, the scores are imported and
+//    laid out before, the output goes to memory
+//---------------------------------------------------------
+
+void TestMxmlBenchmark::exportCorpus()
+{
+    QStringList files = corpus();
+    QVERIFY(!files.isEmpty());
+
+    std::vector<MasterScore*> scores;
+    int failed = 0;
+
+    for (const QString& path : files) {
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        score->setName(QFileInfo(path).completeBaseName());
+        {
+            ScoreLoad sl;
+            Score::FileError rv = path.endsWith(".mxl", Qt::CaseInsensitive)
+                                  ? importCompressedMusicXml(score, path)
+                                  : importMusicXml(score, path);
+            if (rv != Score::FileError::FILE_NO_ERROR) {
+                ++failed;
+                delete score;
+                continue;
+            }
+        }
+        score->doLayout();
+        scores.push_back(score);
+    }
+
+    qint64 bytes = 0;
+    qint64 elapsedNs = 0;
+    int exportFailed = 0;
+
+    QBENCHMARK {
+        exportFailed = 0;
+        for (MasterScore* score : scores) {
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+
+            QElapsedTimer timer;
+            timer.start();
+
+            if (!saveXml(score, &buffer)) {
+                ++exportFailed;
+            }
+
+            elapsedNs += timer.nsecsElapsed();
+            bytes += buffer.size();
+        }
+    }
+
+    qDebug("MusicXML export: %d files (%d failed), written %s",
+           int(files.size()), failed + exportFailed, runtime::throughputInfo(bytes, elapsedNs / 1e9).c_str());
+
+    qDeleteAll(scores);
+}
+
+QTEST_MAIN(TestMxmlBenchmark)
+#include "tst_mxml_benchmark.moc"
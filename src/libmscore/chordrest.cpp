@@ -219,7 +219,8 @@ bool ChordRest::readProperties(XmlReader& e)
 {
     const QStringRef& tag(e.name());
 
-    if (tag == "durationType") {
+    switch (e.tag()) {
+    case XmlTag::DURATION_TYPE:
         setDurationType(e.readElementText());
         if (actualDurationType().type() != TDuration::DurationType::V_MEASURE) {
             if (score()->mscVersion() < 112 && (type() == ElementType::REST)
@@ -244,7 +245,8 @@ bool ChordRest::readProperties(XmlReader& e)
                 setTicks(event.timesig());
             }
         }
-    } else if (tag == "BeamMode") {
+        break;
+    case XmlTag::BEAM_MODE: {
         QString val(e.readElementText());
         Beam::Mode bm = Beam::Mode::AUTO;
         if (val == "auto") {
@@ -265,19 +267,27 @@ bool ChordRest::readProperties(XmlReader& e)
             bm = Beam::Mode(val.toInt());
         }
         _beamMode = Beam::Mode(bm);
-    } else if (tag == "Articulation") {
+    }
+    break;
+    case XmlTag::ARTICULATION: {
         Articulation* atr = new Articulation(score());
         atr->setTrack(track());
         atr->read(e);
         add(atr);
-    } else if (tag == "leadingSpace" || tag == "trailingSpace") {
+    }
+    break;
+    case XmlTag::LEADING_SPACE:
+    case XmlTag::TRAILING_SPACE:
         qDebug("ChordRest: %s obsolete", tag.toLocal8Bit().data());
         e.skipCurrentElement();
-    } else if (tag == "small") {
+        break;
+    case XmlTag::SMALL:
         _small = e.readInt();
-    } else if (tag == "duration") {
+        break;
+    case XmlTag::DURATION:
         setTicks(e.readFraction());
-    } else if (tag == "ticklen") {      // obsolete (version < 1.12)
+        break;
+    case XmlTag::TICKLEN: {      // obsolete (version < 1.12)
         int mticks = score()->sigmap()->timesig(e.tick()).timesig().ticks();
         int i = e.readInt();
         if (i == 0) {
@@ -291,28 +301,34 @@ bool ChordRest::readProperties(XmlReader& e)
             setTicks(f);
             setDurationType(TDuration(f));
         }
-    } else if (tag == "dots") {
+    }
+    break;
+    case XmlTag::DOTS:
         setDots(e.readInt());
-    } else if (tag == "staffMove") {
+        break;
+    case XmlTag::STAFF_MOVE:
         _staffMove = e.readInt();
         if (vStaffIdx() < part()->staves()->first()->idx() || vStaffIdx() > part()->staves()->last()->idx()) {
             _staffMove = 0;
         }
-    } else if (tag == "Spanner") {
+        break;
+    case XmlTag::SPANNER:
         Spanner::readSpanner(e, this, track());
-    } else if (tag == "Lyrics") {
+        break;
+    case XmlTag::LYRICS: {
         Element* element = new Lyrics(score());
         element->setTrack(e.track());
         element->read(e);
         add(element);
-    } else if (tag == "pos") {
+    }
+    break;
+    case XmlTag::POS: {
         QPointF pt = e.readPoint();
         setOffset(pt * spatium());
     }
-//      else if (tag == "offset")
-//            DurationElement::readProperties(e);
-    else if (!DurationElement::readProperties(e)) {
-        return false;
+    break;
+    default:
+        return DurationElement::readProperties(e);
     }
     return true;
 }
@@ -63,6 +63,7 @@
 #include "stafftext.h"
 #include "articulation.h"
 #include "layoutbreak.h"
+#include "layoutprofiler.h"
 #include "drumset.h"
 #include "beam.h"
 #include "lyrics.h"
@@ -273,6 +274,8 @@ void Score::undoRedo(bool undo, EditData* ed)
 
 void Score::endCmd(const bool isCmdFromInspector, bool rollback)
 {
+    LAYOUT_PROFILE_STAGE(EndCmd);
+
     if (!undoStack()->active()) {
         qDebug("Score::endCmd(): no cmd active");
         update();
@@ -331,6 +334,7 @@ void Score::update(bool resetCmdState)
             for (Score* s : ms->scoreList()) {
                 s->doLayoutRange(cs.startTick(), cs.endTick());
             }
+            ms->touchPlayback(cs.startTick(), cs.endTick());
             updateAll = true;
         }
     }
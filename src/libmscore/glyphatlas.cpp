@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "glyphatlas.h"
+
+#include <cstring>
+
+namespace Ms {
+static const int PAGE_SIZE = 1024;
+static const int GLYPH_PADDING = 1;
+
+//---------------------------------------------------------
+//   byteMul
+//    multiply premultiplied argb by a coverage 0 - 255
+//---------------------------------------------------------
+
+static inline QRgb byteMul(QRgb x, uint a)
+{
+    uint t = (x & 0xff00ff) * a;
+    t = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+    t &= 0xff00ff;
+
+    x = ((x >> 8) & 0xff00ff) * a;
+    x = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+    x &= 0xff00ff00;
+    return x | t;
+}
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+GlyphAtlas* GlyphAtlas::instance()
+{
+    static GlyphAtlas atlas;
+    return &atlas;
+}
+
+//---------------------------------------------------------
+//   glyph
+//---------------------------------------------------------
+
+const GlyphAtlas::Glyph* GlyphAtlas::glyph(const Key& key)
+{
+    auto it = _glyphs.constFind(key);
+    if (it == _glyphs.constEnd()) {
+        ++_stats.misses;
+        return nullptr;
+    }
+    ++_stats.hits;
+    return &it.value();
+}
+
+//---------------------------------------------------------
+//   insert
+//    copy the coverage of a FreeType 8 bit gray bitmap
+//---------------------------------------------------------
+
+const GlyphAtlas::Glyph* GlyphAtlas::insert(const Key& key, const FT_Bitmap* bitmap, const QPoint& offset)
+{
+    Glyph g;
+    g.offset = offset;
+
+    QSize size(int(bitmap->width), int(bitmap->rows));
+    if (!size.isEmpty()) {
+        QPoint pos;
+        if (!allocate(size, &g.page, &pos)) {
+            return nullptr;
+        }
+        g.rect = QRect(pos, size);
+
+        QImage& image = _pages[g.page].image;
+        for (int y = 0; y < size.height(); ++y) {
+            const uchar* src = bitmap->buffer + bitmap->pitch * y;
+            memcpy(image.scanLine(pos.y() + y) + pos.x(), src, size.width());
+        }
+    }
+
+    auto it = _glyphs.insert(key, g);
+    _stats.glyphs = _glyphs.size();
+    return &it.value();
+}
+
+//---------------------------------------------------------
+//   allocate
+//---------------------------------------------------------
+
+bool GlyphAtlas::allocate(const QSize& size, int* pageIdx, QPoint* pos)
+{
+    QSize padded = size + QSize(GLYPH_PADDING, GLYPH_PADDING);
+
+    // a huge glyph (extreme zoom) gets a page of its own
+    if (padded.width() > PAGE_SIZE || padded.height() > PAGE_SIZE) {
+        addPage(padded);
+        Page& page = _pages.back();
+        page.shelfY = page.image.height();
+        *pageIdx = int(_pages.size()) - 1;
+        *pos = QPoint(0, 0);
+        return true;
+    }
+
+    if (!_pages.empty()) {
+        Page& page = _pages.back();
+        if (page.image.width() == PAGE_SIZE) {
+            if (page.cursorX + padded.width() > PAGE_SIZE) {
+                page.shelfY += page.shelfHeight;
+                page.shelfHeight = 0;
+                page.cursorX = 0;
+            }
+            if (page.shelfY + padded.height() <= PAGE_SIZE) {
+                *pageIdx = int(_pages.size()) - 1;
+                *pos = QPoint(page.cursorX, page.shelfY);
+                page.cursorX += padded.width();
+                page.shelfHeight = qMax(page.shelfHeight, padded.height());
+                return true;
+            }
+        }
+    }
+
+    addPage(QSize(PAGE_SIZE, PAGE_SIZE));
+    Page& page = _pages.back();
+    *pageIdx = int(_pages.size()) - 1;
+    *pos = QPoint(0, 0);
+    page.cursorX = padded.width();
+    page.shelfHeight = padded.height();
+    return true;
+}
+
+//---------------------------------------------------------
+//   addPage
+//---------------------------------------------------------
+
+void GlyphAtlas::addPage(const QSize& size)
+{
+    if (!_pages.empty() && _stats.bytes + qint64(size.width()) * size.height() > _maxBytes) {
+        clear();
+        ++_stats.evictions;
+    }
+
+    Page page;
+    page.image = QImage(size, QImage::Format_Alpha8);
+    page.image.fill(0);
+    _pages.push_back(page);
+
+    _stats.pages = int(_pages.size());
+    _stats.bytes += page.image.sizeInBytes();
+}
+
+//---------------------------------------------------------
+//   colorize
+//---------------------------------------------------------
+
+QImage GlyphAtlas::colorize(const Glyph& glyph, const QColor& color) const
+{
+    if (glyph.rect.isEmpty() || glyph.page < 0) {
+        return QImage();
+    }
+
+    const QImage& coverage = _pages[glyph.page].image;
+    QImage img(glyph.rect.size(), QImage::Format_ARGB32_Premultiplied);
+    QRgb c = qPremultiply(color.rgba());
+
+    for (int y = 0; y < glyph.rect.height(); ++y) {
+        const uchar* src = coverage.constScanLine(glyph.rect.y() + y) + glyph.rect.x();
+        QRgb* dst = reinterpret_cast<QRgb*>(img.scanLine(y));
+        for (int x = 0; x < glyph.rect.width(); ++x) {
+            dst[x] = byteMul(c, src[x]);
+        }
+    }
+    return img;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void GlyphAtlas::clear()
+{
+    _glyphs.clear();
+    _pages.clear();
+    _stats.glyphs = 0;
+    _stats.pages = 0;
+    _stats.bytes = 0;
+}
+}
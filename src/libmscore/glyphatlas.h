@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GLYPHATLAS_H__
+#define __GLYPHATLAS_H__
+
+#include <vector>
+
+#include <QHash>
+#include <QImage>
+#include <QColor>
+
+#include "ft2build.h"
+#include FT_FREETYPE_H
+
+namespace Ms {
+//---------------------------------------------------------
+//   GlyphAtlas
+///   Coverage (alpha only) bitmaps of the rendered glyphs,
+///   packed in large pages. The key has no color, glyphs are
+///   colorized when drawn, so a new color doesn't need
+///   FreeType. Shared by all score fonts.
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+class GlyphAtlas
+{
+public:
+    struct Key {
+        FT_Face face;
+        uint glyphIndex;
+        int scale16X;           // FreeType 16.16 scale, the size bucket
+        int scale16Y;
+
+        bool operator==(const Key& k) const
+        {
+            return face == k.face && glyphIndex == k.glyphIndex && scale16X == k.scale16X && scale16Y == k.scale16Y;
+        }
+    };
+
+    struct Glyph {
+        int page = -1;
+        QRect rect;             // in the page, empty for glyphs without pixels
+        QPoint offset;          // bitmap left, -top in device pixels
+    };
+
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;  // the atlas is cleared when it exceeds maxBytes
+        int glyphs = 0;
+        int pages = 0;
+        qint64 bytes = 0;
+    };
+
+    GlyphAtlas() = default;
+
+    static GlyphAtlas* instance();
+
+    const Glyph* glyph(const Key& key);
+    const Glyph* insert(const Key& key, const FT_Bitmap* bitmap, const QPoint& offset);
+    QImage colorize(const Glyph& glyph, const QColor& color) const;
+
+    void clear();
+    void setMaxBytes(qint64 bytes) { _maxBytes = bytes; }
+    const Stats& stats() const { return _stats; }
+
+private:
+    struct Page {
+        QImage image;           // Format_Alpha8
+        int shelfY = 0;         // shelf packing, the glyphs are placed left to right in rows
+        int shelfHeight = 0;
+        int cursorX = 0;
+    };
+
+    bool allocate(const QSize& size, int* pageIdx, QPoint* pos);
+    void addPage(const QSize& size);
+
+    std::vector<Page> _pages;
+    QHash<Key, Glyph> _glyphs;
+    qint64 _maxBytes { 32 * 1024 * 1024 };
+    Stats _stats;
+};
+
+inline uint qHash(const GlyphAtlas::Key& k)
+{
+    return ::qHash(quintptr(k.face)) ^ (k.glyphIndex << 8) ^ ::qHash(k.scale16X) ^ (uint(k.scale16Y) << 16);
+}
+}     // namespace Ms
+#endif
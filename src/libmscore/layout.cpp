@@ -37,6 +37,7 @@
 #include "keysig.h"
 #include "layoutbreak.h"
 #include "layout.h"
+#include "layoutprofiler.h"
 #include "lyrics.h"
 #include "marker.h"
 #include "measure.h"
@@ -3045,6 +3046,8 @@ std::pair<qreal, qreal> extendedStemLenWithTwoNoteTremolo(Tremolo* tremolo, qrea
 
 void Score::getNextMeasure(LayoutContext& lc)
 {
+    LAYOUT_PROFILE_STAGE(GetNextMeasure);
+
     lc.prevMeasure = lc.curMeasure;
     lc.curMeasure  = lc.nextMeasure;
     if (!lc.curMeasure) {
@@ -3599,6 +3602,8 @@ static void restoreBeams(Measure* m)
 
 void Score::layoutLyrics(System* system)
 {
+    LAYOUT_PROFILE_STAGE(LayoutLyrics);
+
     std::vector<int> visibleStaves;
     for (int staffIdx = system->firstVisibleStaff(); staffIdx < nstaves(); staffIdx = system->nextVisibleStaff(staffIdx)) {
         visibleStaves.push_back(staffIdx);
@@ -3993,6 +3998,8 @@ static void processLines(System* system, std::vector<Spanner*> lines, bool align
 
 System* Score::collectSystem(LayoutContext& lc)
 {
+    LAYOUT_PROFILE_STAGE(CollectSystem);
+
     if (!lc.curMeasure) {
         return 0;
     }
@@ -4361,6 +4368,8 @@ System* Score::collectSystem(LayoutContext& lc)
 
 void Score::layoutSystemElements(System* system, LayoutContext& lc)
 {
+    LAYOUT_PROFILE_STAGE(LayoutSystemElements);
+
     //-------------------------------------------------------------
     //    create cr segment list to speed up computations
     //-------------------------------------------------------------
@@ -4943,6 +4952,8 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
 
 void LayoutContext::collectPage()
 {
+    LAYOUT_PROFILE_STAGE(CollectPage);
+
     const qreal slb = score->styleP(Sid::staffLowerBorder);
     bool breakPages = score->layoutMode() != LayoutMode::SYSTEM;
     qreal ey        = page->height() - page->bm();
@@ -5208,6 +5219,11 @@ public:
 
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
+    LAYOUT_PROFILE_STAGE(DoLayoutRange);
+    if (LayoutProfiler::enabled()) {
+        LayoutProfiler::instance()->setPassInfo(title(), st.ticks(), et.ticks());
+    }
+
     CmdStateLocker cmdStateLocker(this);
     LayoutContext lc(this);
 
@@ -0,0 +1,335 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "layoutprofiler.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+namespace Ms {
+//! events kept for the trace; the stats are still updated beyond it
+static const size_t MAX_EVENTS = 1000000;
+static const size_t NO_EVENT = size_t(-1);
+//! passes kept with their details; beyond it a pass only counts in the stats
+static const size_t MAX_PASSES = 100000;
+static const int NO_PASS = -1;
+
+std::atomic<bool> LayoutProfiler::_enabled { false };
+
+//---------------------------------------------------------
+//   threadNumber
+//    small sequential ids for the trace viewers
+//---------------------------------------------------------
+
+static int threadNumber()
+{
+    static std::atomic<int> counter { 0 };
+    thread_local int number = ++counter;
+    return number;
+}
+
+//---------------------------------------------------------
+//   openPasses
+//    doLayoutRange passes open on this thread
+//---------------------------------------------------------
+
+static std::vector<int>& openPasses()
+{
+    thread_local std::vector<int> passes;
+    return passes;
+}
+
+//---------------------------------------------------------
+//   jsonEscaped
+//---------------------------------------------------------
+
+static QString jsonEscaped(const QString& str)
+{
+    QString res;
+    res.reserve(str.size());
+    for (const QChar& c : str) {
+        if (c == '"' || c == '\\') {
+            res += '\\';
+            res += c;
+        } else if (c.unicode() < 0x20) {
+            res += QString("\\u%1").arg(int(c.unicode()), 4, 16, QChar('0'));
+        } else {
+            res += c;
+        }
+    }
+    return res;
+}
+
+//---------------------------------------------------------
+//   LayoutProfiler
+//---------------------------------------------------------
+
+LayoutProfiler::LayoutProfiler()
+    : _origin(Clock::now())
+{
+}
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+LayoutProfiler* LayoutProfiler::instance()
+{
+    static LayoutProfiler profiler;
+    return &profiler;
+}
+
+//---------------------------------------------------------
+//   setEnabled
+//---------------------------------------------------------
+
+void LayoutProfiler::setEnabled(bool val)
+{
+    _enabled.store(val, std::memory_order_relaxed);
+}
+
+//---------------------------------------------------------
+//   stageName
+//---------------------------------------------------------
+
+const char* LayoutProfiler::stageName(Stage stage)
+{
+    switch (stage) {
+    case Stage::EndCmd:               return "endCmd";
+    case Stage::DoLayoutRange:        return "doLayoutRange";
+    case Stage::GetNextMeasure:       return "getNextMeasure";
+    case Stage::CollectSystem:        return "collectSystem";
+    case Stage::LayoutSystemElements: return "layoutSystemElements";
+    case Stage::LayoutLyrics:         return "layoutLyrics";
+    case Stage::CollectPage:          return "collectPage";
+    case Stage::STAGES:               break;
+    }
+    return "";
+}
+
+//---------------------------------------------------------
+//   now
+//    nanoseconds since the profiler was created
+//---------------------------------------------------------
+
+qint64 LayoutProfiler::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _origin).count();
+}
+
+//---------------------------------------------------------
+//   begin
+//---------------------------------------------------------
+
+size_t LayoutProfiler::begin(Stage stage, qint64& beginNs)
+{
+    std::vector<int>& passes = openPasses();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (stage == Stage::DoLayoutRange) {
+        if (_passes.size() < MAX_PASSES) {
+            passes.push_back(int(_passes.size()));
+            _passes.emplace_back();
+        } else {
+            passes.push_back(NO_PASS);
+            ++_droppedPasses;
+        }
+    }
+
+    if (!passes.empty() && passes.back() != NO_PASS && size_t(passes.back()) < _passes.size()) {
+        ++_passes[passes.back()].calls[size_t(stage)];
+    }
+
+    size_t index = NO_EVENT;
+    if (_events.size() < MAX_EVENTS) {
+        Event e;
+        e.stage = stage;
+        e.thread = threadNumber();
+        e.pass = stage == Stage::DoLayoutRange ? passes.back() : -1;
+        index = _events.size();
+        _events.push_back(e);
+    } else {
+        ++_droppedEvents;
+    }
+
+    beginNs = now();
+    if (index != NO_EVENT) {
+        _events[index].beginNs = beginNs;
+    }
+    return index;
+}
+
+//---------------------------------------------------------
+//   end
+//---------------------------------------------------------
+
+void LayoutProfiler::end(Stage stage, size_t index, qint64 beginNs)
+{
+    qint64 durationNs = now() - beginNs;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    StageStats& st = _stats[size_t(stage)];
+    double ms = durationNs / 1e6;
+    ++st.calls;
+    st.totalMs += ms;
+    st.maxMs = qMax(st.maxMs, ms);
+
+    // the events may have been cleared while the scope was open
+    if (index < _events.size() && _events[index].stage == stage && _events[index].beginNs == beginNs) {
+        _events[index].durationNs = durationNs;
+    }
+
+    if (stage == Stage::DoLayoutRange) {
+        std::vector<int>& passes = openPasses();
+        if (!passes.empty()) {
+            passes.pop_back();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   setPassInfo
+//    describe the doLayoutRange pass open on this thread
+//---------------------------------------------------------
+
+void LayoutProfiler::setPassInfo(const QString& scoreName, int startTick, int endTick)
+{
+    std::vector<int>& passes = openPasses();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (passes.empty() || passes.back() == NO_PASS || size_t(passes.back()) >= _passes.size()) {
+        return;
+    }
+
+    Pass& p = _passes[passes.back()];
+    p.scoreName = scoreName;
+    p.startTick = startTick;
+    p.endTick = endTick;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void LayoutProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _events.clear();
+    _passes.clear();
+    _stats = {};
+    _droppedEvents = 0;
+    _droppedPasses = 0;
+}
+
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+std::array<LayoutProfiler::StageStats, size_t(LayoutProfiler::Stage::STAGES)> LayoutProfiler::stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+//---------------------------------------------------------
+//   summary
+//---------------------------------------------------------
+
+QString LayoutProfiler::summary() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    QString res = QString("Layout profile: %1 passes\n").arg(quint64(_passes.size()) + _droppedPasses);
+    for (size_t i = 0; i < _stats.size(); ++i) {
+        const StageStats& st = _stats[i];
+        res += QString("%1 calls: %2 total: %3 ms max: %4 ms\n")
+               .arg(stageName(Stage(i)), -22)
+               .arg(st.calls, 8)
+               .arg(st.totalMs, 10, 'f', 3)
+               .arg(st.maxMs, 9, 'f', 3);
+    }
+    if (_droppedEvents) {
+        res += QString("%1 events not kept in the trace\n").arg(_droppedEvents);
+    }
+    if (_droppedPasses) {
+        res += QString("%1 passes not kept in the trace\n").arg(_droppedPasses);
+    }
+    return res;
+}
+
+//---------------------------------------------------------
+//   writeChromeTrace
+//    Trace Event Format, complete ("X") events in microseconds
+//---------------------------------------------------------
+
+bool LayoutProfiler::writeChromeTrace(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning("LayoutProfiler: cannot write <%s>: %s", qPrintable(path), qPrintable(file.errorString()));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    for (const Event& e : _events) {
+        if (e.durationNs < 0) {
+            continue;
+        }
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+
+        out << "{\"name\":\"" << stageName(e.stage) << "\",\"cat\":\"layout\",\"ph\":\"X\",\"pid\":1"
+            << ",\"tid\":" << e.thread
+            << ",\"ts\":" << QString::number(e.beginNs / 1000.0, 'f', 3)
+            << ",\"dur\":" << QString::number(e.durationNs / 1000.0, 'f', 3);
+
+        if (e.pass >= 0 && size_t(e.pass) < _passes.size()) {
+            const Pass& p = _passes[e.pass];
+            out << ",\"args\":{\"score\":\"" << jsonEscaped(p.scoreName) << "\""
+                << ",\"startTick\":" << p.startTick
+                << ",\"endTick\":" << p.endTick;
+            for (size_t i = size_t(Stage::GetNextMeasure); i < p.calls.size(); ++i) {
+                out << ",\"" << stageName(Stage(i)) << "\":" << p.calls[i];
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+
+    out << "\n]}\n";
+    out.flush();
+
+    return file.error() == QFileDevice::NoError;
+}
+}
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LAYOUTPROFILER_H__
+#define __LAYOUTPROFILER_H__
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <QString>
+
+namespace Ms {
+//---------------------------------------------------------
+//   LayoutProfiler
+///   Timings of the layout stages of every layout pass.
+///   Disabled by default; when disabled a stage scope costs
+///   one relaxed atomic load. Unlike TRACEFUNC it records
+///   every call, so a slow command can be attributed to a
+///   stage, and it can be saved as a Chrome trace
+///   (chrome://tracing, Perfetto).
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+class LayoutProfiler
+{
+public:
+    enum class Stage : unsigned char {
+        EndCmd,
+        DoLayoutRange,
+        GetNextMeasure,
+        CollectSystem,
+        LayoutSystemElements,
+        LayoutLyrics,
+        CollectPage,
+        STAGES
+    };
+
+    struct StageStats {
+        quint64 calls = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    //---------------------------------------------------------
+    //   Scope
+    //    times the enclosing block as one call of the stage
+    //---------------------------------------------------------
+
+    class Scope
+    {
+    public:
+        Scope(Stage stage)
+        {
+            if (LayoutProfiler::enabled()) {
+                _profiler = LayoutProfiler::instance();
+                _stage = stage;
+                _index = _profiler->begin(stage, _beginNs);
+            }
+        }
+
+        ~Scope()
+        {
+            if (_profiler) {
+                _profiler->end(_stage, _index, _beginNs);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        LayoutProfiler* _profiler = nullptr;
+        Stage _stage = Stage::EndCmd;
+        size_t _index = 0;
+        qint64 _beginNs = 0;
+    };
+
+    static LayoutProfiler* instance();
+
+    static bool enabled() { return _enabled.load(std::memory_order_relaxed); }
+    static void setEnabled(bool val);
+
+    void setPassInfo(const QString& scoreName, int startTick, int endTick);
+
+    void clear();
+    std::array<StageStats, size_t(Stage::STAGES)> stats() const;
+    QString summary() const;
+    bool writeChromeTrace(const QString& path) const;
+
+    static const char* stageName(Stage stage);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        Stage stage;
+        int thread = 0;
+        qint64 beginNs = 0;
+        qint64 durationNs = -1;         // -1 while the scope is open
+        int pass = -1;                  // doLayoutRange events: index in _passes, -1 if not kept
+    };
+
+    struct Pass {
+        QString scoreName;
+        int startTick = 0;
+        int endTick = 0;
+        std::array<quint64, size_t(Stage::STAGES)> calls {};
+    };
+
+    LayoutProfiler();
+
+    size_t begin(Stage stage, qint64& beginNs);
+    void end(Stage stage, size_t index, qint64 beginNs);
+    qint64 now() const;
+
+    static std::atomic<bool> _enabled;
+
+    mutable std::mutex _mutex;
+    Clock::time_point _origin;
+    std::vector<Event> _events;
+    std::vector<Pass> _passes;
+    std::array<StageStats, size_t(Stage::STAGES)> _stats {};
+    quint64 _droppedEvents = 0;
+    quint64 _droppedPasses = 0;
+};
+}     // namespace Ms
+
+#define LAYOUT_PROFILE_STAGE(stage) Ms::LayoutProfiler::Scope __layoutProfilerScope(Ms::LayoutProfiler::Stage::stage)
+
+#endif
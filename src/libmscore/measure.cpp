@@ -25,6 +25,7 @@
  Implementation of most part of class Measure.
 */
 
+#include <atomic>
 #include <cmath>
 
 #include "log.h"
@@ -173,6 +174,17 @@ void MStaff::setTrack(int track)
     }
 }
 
+//---------------------------------------------------------
+//   nextPlaybackRevision
+//    measures may be created concurrently by part layout
+//---------------------------------------------------------
+
+static quint64 nextPlaybackRevision()
+{
+    static std::atomic<quint64> revision { 0 };
+    return ++revision;
+}
+
 //---------------------------------------------------------
 //   Measure
 //---------------------------------------------------------
@@ -200,6 +212,7 @@ Measure::Measure(Score* s)
     m_breakMultiMeasureRest = false;
     m_mmRest                = nullptr;
     m_mmRestCount           = 0;
+    m_playbackRevision      = nextPlaybackRevision();
     setFlag(ElementFlag::MOVABLE, true);
 }
 
@@ -226,6 +239,17 @@ Measure::Measure(const Measure& m)
     m_mmRest                = m.m_mmRest;
     m_mmRestCount           = m.m_mmRestCount;
     m_playbackCount         = m.m_playbackCount;
+    m_playbackRevision      = nextPlaybackRevision();
+}
+
+//---------------------------------------------------------
+//   touchPlayback
+//    invalidate MIDI events cached for this measure
+//---------------------------------------------------------
+
+void Measure::touchPlayback()
+{
+    m_playbackRevision = nextPlaybackRevision();
 }
 
 //---------------------------------------------------------
@@ -2220,15 +2244,16 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
 
     while (e.readNextStartElement()) {
         const QStringRef& tag(e.name());
+        const XmlTag tagId = e.tag();
 
-        if (tag == "location") {
+        if (tagId == XmlTag::LOCATION) {
             Location loc = Location::relative();
             loc.read(e);
             e.setLocation(loc);
-        } else if (tag == "tick") {             // obsolete?
+        } else if (tagId == XmlTag::TICK) {             // obsolete?
             qDebug("read midi tick");
             e.setTick(Fraction::fromTicks(score()->fileDivision(e.readInt())));
-        } else if (tag == "BarLine") {
+        } else if (tagId == XmlTag::BAR_LINE) {
             BarLine* barLine = new BarLine(score());
             barLine->setTrack(e.track());
             barLine->read(e);
@@ -2262,7 +2287,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 segment->add(fermata);
                 fermata = nullptr;
             }
-        } else if (tag == "Chord") {
+        } else if (tagId == XmlTag::CHORD) {
             Chord* chord = new Chord(score());
             chord->setTrack(e.track());
             chord->read(e);
@@ -2292,7 +2317,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 segment->add(fermata);
                 fermata = nullptr;
             }
-        } else if (tag == "Rest") {
+        } else if (tagId == XmlTag::REST) {
             if (isMMRest()) {
                 MMRest* mmr = new MMRest(score());
                 mmr->setTrack(e.track());
@@ -2326,16 +2351,16 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 }
                 e.incTick(rest->actualTicks());
             }
-        } else if (tag == "Breath") {
+        } else if (tagId == XmlTag::BREATH) {
             Breath* breath = new Breath(score());
             breath->setTrack(e.track());
             breath->setPlacement(breath->track() & 1 ? Placement::BELOW : Placement::ABOVE);
             breath->read(e);
             segment = getSegment(SegmentType::Breath, e.tick());
             segment->add(breath);
-        } else if (tag == "Spanner") {
+        } else if (tagId == XmlTag::SPANNER) {
             Spanner::readSpanner(e, this, e.track());
-        } else if (tag == "MeasureRepeat" || tag == "RepeatMeasure") {
+        } else if (tagId == XmlTag::MEASURE_REPEAT || tagId == XmlTag::REPEAT_MEASURE) {
             //             4.x                       3.x
             MeasureRepeat* mr = new MeasureRepeat(score());
             mr->setTrack(e.track());
@@ -2349,7 +2374,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             segment = getSegment(SegmentType::ChordRest, e.tick());
             segment->add(mr);
             e.incTick(ticks());
-        } else if (tag == "Clef") {
+        } else if (tagId == XmlTag::CLEF) {
             Clef* clef = new Clef(score());
             clef->setTrack(e.track());
             clef->read(e);
@@ -2376,7 +2401,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             }
             segment = getSegment(header ? SegmentType::HeaderClef : SegmentType::Clef, e.tick());
             segment->add(clef);
-        } else if (tag == "TimeSig") {
+        } else if (tagId == XmlTag::TIME_SIG) {
             TimeSig* ts = new TimeSig(score());
             ts->setTrack(e.track());
             ts->read(e);
@@ -2403,7 +2428,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                     score()->sigmap()->add(tick().ticks(), SigEvent(m_timesig));
                 }
             }
-        } else if (tag == "KeySig") {
+        } else if (tagId == XmlTag::KEY_SIG) {
             KeySig* ks = new KeySig(score());
             ks->setTrack(e.track());
             ks->read(e);
@@ -2420,7 +2445,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                     staff->setKey(curTick, ks->keySigEvent());
                 }
             }
-        } else if (tag == "Text") {
+        } else if (tagId == XmlTag::TEXT) {
             StaffText* t = new StaffText(score());
             t->setTrack(e.track());
             t->read(e);
@@ -2434,24 +2459,24 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
         }
         //----------------------------------------------------
         // Annotation
-        else if (tag == "Dynamic") {
+        else if (tagId == XmlTag::DYNAMIC) {
             Dynamic* dyn = new Dynamic(score());
             dyn->setTrack(e.track());
             dyn->read(e);
             segment = getSegment(SegmentType::ChordRest, e.tick());
             segment->add(dyn);
-        } else if (tag == "Harmony"
-                   || tag == "FretDiagram"
-                   || tag == "TremoloBar"
-                   || tag == "Symbol"
-                   || tag == "Tempo"
-                   || tag == "StaffText"
-                   || tag == "Sticking"
-                   || tag == "SystemText"
-                   || tag == "RehearsalMark"
-                   || tag == "InstrumentChange"
-                   || tag == "StaffState"
-                   || tag == "FiguredBass"
+        } else if (tagId == XmlTag::HARMONY
+                   || tagId == XmlTag::FRET_DIAGRAM
+                   || tagId == XmlTag::TREMOLO_BAR
+                   || tagId == XmlTag::SYMBOL
+                   || tagId == XmlTag::TEMPO
+                   || tagId == XmlTag::STAFF_TEXT
+                   || tagId == XmlTag::STICKING
+                   || tagId == XmlTag::SYSTEM_TEXT
+                   || tagId == XmlTag::REHEARSAL_MARK
+                   || tagId == XmlTag::INSTRUMENT_CHANGE
+                   || tagId == XmlTag::STAFF_STATE
+                   || tagId == XmlTag::FIGURED_BASS
                    ) {
             Element* el = Element::name2Element(tag, score());
             // hack - needed because tick tags are unreliable in 1.3 scores
@@ -2460,12 +2485,12 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             el->read(e);
             segment = getSegment(SegmentType::ChordRest, e.tick());
             segment->add(el);
-        } else if (tag == "Fermata") {
+        } else if (tagId == XmlTag::FERMATA) {
             fermata = new Fermata(score());
             fermata->setTrack(e.track());
             fermata->setPlacement(fermata->track() & 1 ? Placement::BELOW : Placement::ABOVE);
             fermata->read(e);
-        } else if (tag == "Image") {
+        } else if (tagId == XmlTag::IMAGE) {
             if (MScore::noImages) {
                 e.skipCurrentElement();
             } else {
@@ -2477,7 +2502,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             }
         }
         //----------------------------------------------------
-        else if (tag == "Tuplet") {
+        else if (tagId == XmlTag::TUPLET) {
             Tuplet* oldTuplet = tuplet;
             tuplet = new Tuplet(score());
             tuplet->setTrack(e.track());
@@ -2487,7 +2512,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
             if (oldTuplet) {
                 oldTuplet->add(tuplet);
             }
-        } else if (tag == "endTuplet") {
+        } else if (tagId == XmlTag::END_TUPLET) {
             if (!tuplet) {
                 qDebug("Measure::read: encountered <endTuplet/> when no tuplet was started");
                 e.skipCurrentElement();
@@ -2504,7 +2529,7 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 delete oldTuplet;
             }
             e.readNext();
-        } else if (tag == "Beam") {
+        } else if (tagId == XmlTag::BEAM) {
             Beam* beam = new Beam(score());
             beam->setTrack(e.track());
             beam->read(e);
@@ -2514,9 +2539,9 @@ void Measure::readVoice(XmlReader& e, int staffIdx, bool irregular)
                 delete startingBeam;
             }
             startingBeam = beam;
-        } else if (tag == "Segment" && segment) {
+        } else if (tagId == XmlTag::SEGMENT && segment) {
             segment->read(e);
-        } else if (tag == "Ambitus") {
+        } else if (tagId == XmlTag::AMBITUS) {
             Ambitus* range = new Ambitus(score());
             range->read(e);
             segment = getSegment(SegmentType::Ambitus, e.tick());
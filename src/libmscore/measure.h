@@ -290,6 +290,8 @@ public:
 
     int playbackCount() const { return m_playbackCount; }
     void setPlaybackCount(int val) { m_playbackCount = val; }
+    quint64 playbackRevision() const { return m_playbackRevision; }
+    void touchPlayback();
     QRectF staffabbox(int staffIdx) const;
 
     QVariant getProperty(Pid propertyId) const override;
@@ -366,6 +368,9 @@ private:
     int m_playbackCount { 0 };  // temp. value used in RepeatList
                                 // counts how many times this measure was already played
 
+    quint64 m_playbackRevision;  // unique among all measures, renewed whenever the
+                                 // MIDI events rendered from this measure may change
+
     int m_repeatCount;          ///< end repeat marker and repeat count
 
     MeasureNumberMode m_noMode;
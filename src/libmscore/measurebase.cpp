@@ -333,6 +333,18 @@ Fraction MeasureBase::tick() const
     return mb ? mb->_tick : Fraction(-1, 1);
 }
 
+//---------------------------------------------------------
+//   setTick
+//---------------------------------------------------------
+
+void MeasureBase::setTick(const Fraction& f)
+{
+    _tick = f;
+    if (score()) {
+        score()->measures()->invalidateTickIndex();
+    }
+}
+
 //---------------------------------------------------------
 //   triggerLayout
 //---------------------------------------------------------
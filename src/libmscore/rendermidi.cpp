@@ -1120,30 +1120,210 @@ void Score::updateVelo()
 }
 
 //---------------------------------------------------------
-//   renderStaffChunk
+//   touchPlayback
+//    Renew the playback revision of all measures whose MIDI
+//    events may have changed by an edit in the range
+//    stick - etick, so that MidiRenderer renders only those
+//    again. Besides the range itself this covers spanners
+//    crossing it, ties into and out of it, the previous chord
+//    symbol and the measures up to the next dynamic, as the
+//    velocity set by a dynamic lasts until then.
 //---------------------------------------------------------
 
-void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const StaffContext& sctx)
+void MasterScore::touchPlayback(const Fraction& stick, const Fraction& etick)
+{
+    Measure* lm = lastMeasure();
+    if (!lm) {
+        return;
+    }
+    const Fraction end = lm->endTick();
+    Fraction tick1 = std::max(stick, Fraction(0, 1));
+    Fraction tick2 = (etick < Fraction(0, 1) || etick > end) ? end : etick;
+
+    // channel switches, swing and capo settings last until changed again
+    const CmdState& cs = cmdState();
+    bool toEnd = cs._instrumentsChanged
+                 || (cs.layoutFlags & LayoutFlag::PLAY_EVENTS)
+                 || (cs.layoutFlags & LayoutFlag::REBUILD_MIDI_MAPPING);
+
+    Fraction rtick1 = tick1;
+    Fraction rtick2 = tick2;
+    for (const auto& interval : spannerMap().findOverlapping(tick1.ticks(), tick2.ticks())) {
+        const Spanner* sp = interval.value;
+        rtick1 = std::min(rtick1, sp->tick());
+        rtick2 = std::max(rtick2, sp->tick2());
+    }
+
+    Measure* m1 = tick2measure(tick1);
+    Segment* first = m1 ? m1->first(SegmentType::ChordRest) : nullptr;
+    Segment* s = first;
+    for (; s && s->tick() <= tick2; s = s->next1(SegmentType::ChordRest)) {
+        for (const Element* e : s->annotations()) {
+            if (e->isStaffTextBase()) {
+                toEnd = true;
+            }
+        }
+        for (const Element* e : s->elist()) {
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            for (const Note* n : toChord(e)->notes()) {
+                if (n->tieBack()) {
+                    rtick1 = std::min(rtick1, n->firstTiedNote()->tick());
+                }
+                if (n->tieFor()) {
+                    rtick2 = std::max(rtick2, n->lastTiedNote()->tick());
+                }
+            }
+        }
+    }
+
+    if (toEnd) {
+        rtick2 = end;
+    } else {
+        Fraction next = end;
+        for (; s; s = s->next1(SegmentType::ChordRest)) {
+            bool found = false;
+            for (const Element* e : s->annotations()) {
+                if (e->isDynamic()) {
+                    found = true;
+                    break;
+                }
+            }
+            if (found) {
+                next = s->tick();
+                break;
+            }
+        }
+        rtick2 = std::max(rtick2, next);
+    }
+
+    // chord symbols last until the next one
+    for (Segment* ps = first ? first->prev1(SegmentType::ChordRest) : nullptr; ps; ps = ps->prev1(SegmentType::ChordRest)) {
+        bool found = false;
+        for (const Element* e : ps->annotations()) {
+            if (e->isHarmony() || e->isFretDiagram()) {
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            rtick1 = std::min(rtick1, ps->tick());
+            break;
+        }
+    }
+
+    for (Score* score : scoreList()) {
+        for (Measure* m = score->tick2measure(rtick1); m && m->tick() <= rtick2; m = m->nextMeasure()) {
+            m->touchPlayback();
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   forEachPlayedMeasure
+//    calls f(m, playMeasure, offset) for every measure of the chunk,
+//    playMeasure being the measure whose notes are heard in m
+//    (a previous one for measure repeats) shifted by offset ticks
+//---------------------------------------------------------
+
+template<typename F>
+static void forEachPlayedMeasure(const MidiRenderer::Chunk& chunk, int staffIdx, F f)
 {
     Measure const* const start = chunk.startMeasure();
     Measure const* const end = chunk.endMeasure();
-    const int tickOffset = chunk.tickOffset();
 
     Measure const* lastMeasure = start->prevMeasure();
 
     for (Measure const* m = start; m != end; m = m->nextMeasure()) {
-        int staffIdx = sctx.staff->idx();
         if (m->isMeasureRepeatGroup(staffIdx)) {
             MeasureRepeat* mr = m->measureRepeatElement(staffIdx);
             Measure const* playMeasure = lastMeasure;
             for (int i = m->measureRepeatCount(staffIdx); i < mr->numMeasures() && playMeasure->prevMeasure(); ++i) {
                 playMeasure = playMeasure->prevMeasure();
             }
-            int offset = (m->tick() - playMeasure->tick()).ticks();
-            collectMeasureEvents(events, playMeasure, sctx, tickOffset + offset);
+            f(m, playMeasure, (m->tick() - playMeasure->tick()).ticks());
         } else {
             lastMeasure = m;
-            collectMeasureEvents(events, lastMeasure, sctx, tickOffset);
+            f(m, m, 0);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   isCached
+///   Whether events of all measures of the chunk are
+///   in the cache and up to date.
+//---------------------------------------------------------
+
+bool MidiRenderer::isCached(const Chunk& chunk) const
+{
+    const int tickOffset = chunk.tickOffset();
+    bool cached = true;
+    for (int staffIdx = 0; cached && staffIdx < score->nstaves(); ++staffIdx) {
+        forEachPlayedMeasure(chunk, staffIdx, [&](Measure const* m, Measure const* playMeasure, int) {
+            if (!cached) {
+                return;
+            }
+            auto i = eventsCache.find(MeasureEventsKey(m, staffIdx, tickOffset));
+            cached = i != eventsCache.end()
+                     && i->second.revision == m->playbackRevision()
+                     && i->second.sourceRevision == playMeasure->playbackRevision()
+                     && i->second.tick == m->tick().ticks();
+        });
+    }
+    return cached;
+}
+
+//---------------------------------------------------------
+//   renderStaffChunk
+///   Renders the measures which changed since they were
+///   rendered last time and takes the other ones from the
+///   cache.
+//---------------------------------------------------------
+
+void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const StaffContext& sctx)
+{
+    const int tickOffset = chunk.tickOffset();
+    const int staffIdx = sctx.staff->idx();
+
+    forEachPlayedMeasure(chunk, staffIdx, [&](Measure const* m, Measure const* playMeasure, int offset) {
+        MeasureEvents& me = eventsCache[MeasureEventsKey(m, staffIdx, tickOffset)];
+        if (me.revision != m->playbackRevision()
+            || me.sourceRevision != playMeasure->playbackRevision()
+            || me.tick != m->tick().ticks()) {
+            me.events.clear();
+            collectMeasureEvents(&me.events, playMeasure, sctx, tickOffset + offset);
+            me.revision = m->playbackRevision();
+            me.sourceRevision = playMeasure->playbackRevision();
+            me.tick = m->tick().ticks();
+        }
+        events->registerChannel(me.events.highestChannel());
+        events->insert(me.events.cbegin(), me.events.cend());
+    });
+}
+
+//---------------------------------------------------------
+//   pruneEventsCache
+///   Drops cached events of measures which are not
+///   played anymore.
+//---------------------------------------------------------
+
+void MidiRenderer::pruneEventsCache()
+{
+    std::set<MeasureEventsKey> keys;
+    for (const Chunk& chunk : chunks) {
+        for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            for (Measure const* m = chunk.startMeasure(); m != chunk.endMeasure(); m = m->nextMeasure()) {
+                keys.insert(MeasureEventsKey(m, staffIdx, chunk.tickOffset()));
+            }
+        }
+    }
+    for (auto i = eventsCache.begin(); i != eventsCache.end();) {
+        if (keys.find(i->first) == keys.end()) {
+            i = eventsCache.erase(i);
+        } else {
+            ++i;
         }
     }
 }
@@ -2471,12 +2651,6 @@ void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 
 void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
 {
-    // TODO: avoid doing it multiple times for the same measures
-    score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
-
-    score->updateChannel();
-    score->updateVelo();
-
     SynthesizerState s = score->synthesizerState();
     int method = s.method();
     int cc = s.ccToUse();
@@ -2514,6 +2688,21 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
         break;
     }
 
+    if (cacheContext.method != renderMethod || cacheContext.cc != cc || cacheContext.renderHarmony != ctx.renderHarmony) {
+        eventsCache.clear();
+        cacheContext.method = renderMethod;
+        cacheContext.cc = cc;
+        cacheContext.renderHarmony = ctx.renderHarmony;
+    }
+
+    // play events, channels and velocities are only needed
+    // to render measures which are not cached
+    if (!isCached(chunk)) {
+        score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+        score->updateChannel();
+        score->updateVelo();
+    }
+
     // create note & other events
     for (Staff* st : score->staves()) {
         StaffContext sctx;
@@ -2569,6 +2758,7 @@ void MidiRenderer::updateState()
         score->updateCapo();
 
         updateChunksPartition();
+        pruneEventsCache();
 
         needUpdate = false;
     }
@@ -23,11 +23,15 @@
 #ifndef __RENDERMIDI_H__
 #define __RENDERMIDI_H__
 
+#include <map>
+#include <tuple>
+
 #include "fraction.h"
 #include "measure.h"
 
+#include "framework/midi_old/event.h"
+
 namespace Ms {
-class EventMap;
 class MasterScore;
 class Staff;
 class SynthesizerState;
@@ -109,10 +113,27 @@ private:
         bool renderHarmony{ false };
     };
 
+    // events of one staff of a measure, as rendered at a given playback position
+    struct MeasureEvents
+    {
+        quint64 revision { 0 };           // playback revision of the measure
+        quint64 sourceRevision { 0 };     // playback revision of the played measure (differs for measure repeats)
+        int tick { -1 };
+        EventMap events;
+    };
+
+    // measure, staff index, tick offset of the repeat segment
+    typedef std::tuple<Measure const*, int, int> MeasureEventsKey;
+    std::map<MeasureEventsKey, MeasureEvents> eventsCache;
+    StaffContext cacheContext;
+
     void updateChunksPartition();
+    void pruneEventsCache();
     static bool canBreakChunk(const Measure* last);
     void updateState();
 
+    bool isCached(const Chunk&) const;
+
     void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx);
     void renderSpanners(const Chunk&, EventMap* events);
     void renderMetronome(const Chunk&, EventMap* events);
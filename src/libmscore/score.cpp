@@ -112,6 +112,7 @@ MeasureBaseList::MeasureBaseList()
 
 void MeasureBaseList::push_back(MeasureBase* e)
 {
+    invalidateTickIndex();
     ++_size;
     if (_last) {
         _last->setNext(e);
@@ -132,6 +133,7 @@ void MeasureBaseList::push_back(MeasureBase* e)
 
 void MeasureBaseList::push_front(MeasureBase* e)
 {
+    invalidateTickIndex();
     ++_size;
     if (_first) {
         _first->setPrev(e);
@@ -153,6 +155,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
 
 void MeasureBaseList::add(MeasureBase* e)
 {
+    invalidateTickIndex();
     MeasureBase* el = e->next();
     if (el == 0) {
         push_back(e);
@@ -175,6 +178,7 @@ void MeasureBaseList::add(MeasureBase* e)
 
 void MeasureBaseList::remove(MeasureBase* el)
 {
+    invalidateTickIndex();
     --_size;
     if (el->prev()) {
         el->prev()->setNext(el->next());
@@ -194,6 +198,7 @@ void MeasureBaseList::remove(MeasureBase* el)
 
 void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     ++_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         ++_size;
@@ -219,6 +224,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 {
+    invalidateTickIndex();
     --_size;
     for (MeasureBase* m = fm; m != lm; m = m->next()) {
         --_size;
@@ -243,6 +249,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
 
 void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 {
+    invalidateTickIndex();
     nb->setPrev(ob->prev());
     nb->setNext(ob->next());
     if (ob->prev()) {
@@ -267,6 +274,34 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
     fixupSystems();
 }
 
+//---------------------------------------------------------
+//   tickIndex
+///   Measures in list order, for the binary search by tick.
+///   Returns nullptr if the measure ticks are not in order
+///   (in the middle of an edit), a linear search must be used then.
+//---------------------------------------------------------
+
+const std::vector<Measure*>* MeasureBaseList::tickIndex() const
+{
+    if (!_tickIndexValid) {
+        _tickIndex.clear();
+        _tickIndex.reserve(_size);
+        _tickIndexSorted = true;
+        for (MeasureBase* mb = _first; mb; mb = mb->next()) {
+            if (!mb->isMeasure()) {
+                continue;
+            }
+            Measure* m = toMeasure(mb);
+            if (!_tickIndex.empty() && m->tick() < _tickIndex.back()->tick()) {
+                _tickIndexSorted = false;
+            }
+            _tickIndex.push_back(m);
+        }
+        _tickIndexValid = true;
+    }
+    return _tickIndexSorted ? &_tickIndex : nullptr;
+}
+
 //---------------------------------------------------------
 //   fixupSystems
 ///   After modifying measures, make sure each measure
@@ -1517,6 +1552,11 @@ void Score::addElement(Element* element)
     case ElementType::HARMONY:
         element->part()->updateHarmonyChannels(true);
         break;
+    case ElementType::STAFF_TEXT:
+    case ElementType::SYSTEM_TEXT:
+        // may switch channels or change swing and capo up to the end of the score
+        addLayoutFlags(LayoutFlag::PLAY_EVENTS);
+        break;
 
     default:
         break;
@@ -1689,6 +1729,10 @@ void Score::removeElement(Element* element)
     case ElementType::HARMONY:
         element->part()->updateHarmonyChannels(true, true);
         break;
+    case ElementType::STAFF_TEXT:
+    case ElementType::SYSTEM_TEXT:
+        addLayoutFlags(LayoutFlag::PLAY_EVENTS);
+        break;
 
     default:
         break;
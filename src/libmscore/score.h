@@ -29,6 +29,7 @@
 */
 
 #include <set>
+#include <vector>
 #include <QFileInfo>
 #include <QQueue>
 #include <QSet>
@@ -166,6 +167,11 @@ class MeasureBaseList
     MeasureBase* _first;
     MeasureBase* _last;
 
+    // measures in tick order, rebuilt on demand after the list or a measure tick is changed
+    mutable std::vector<Measure*> _tickIndex;
+    mutable bool _tickIndexValid { false };
+    mutable bool _tickIndexSorted { false };
+
     void push_back(MeasureBase* e);
     void push_front(MeasureBase* e);
 
@@ -173,7 +179,7 @@ public:
     MeasureBaseList();
     MeasureBase* first() const { return _first; }
     MeasureBase* last()  const { return _last; }
-    void clear() { _first = _last = 0; _size = 0; }
+    void clear() { _first = _last = 0; _size = 0; invalidateTickIndex(); }
     void add(MeasureBase*);
     void remove(MeasureBase*);
     void insert(MeasureBase*, MeasureBase*);
@@ -182,6 +188,9 @@ public:
     int size() const { return _size; }
     bool empty() const { return _size == 0; }
     void fixupSystems();
+
+    void invalidateTickIndex() { _tickIndexValid = false; }
+    const std::vector<Measure*>* tickIndex() const;
 };
 
 //---------------------------------------------------------
@@ -1414,6 +1423,7 @@ public:
     void setLayoutAll(int staff = -1, const Element* e = nullptr);
     void setLayout(const Fraction& tick, int staff, const Element* e = nullptr);
     void setLayout(const Fraction& tick1, const Fraction& tick2, int staff1, int staff2, const Element* e = nullptr);
+    void touchPlayback(const Fraction& stick, const Fraction& etick);
 
     virtual CmdState& cmdState() override { return _cmdState; }
     const CmdState& cmdState() const override { return _cmdState; }
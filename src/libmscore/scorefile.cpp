@@ -21,6 +21,8 @@
  */
 
 #include <cmath>
+#include <limits>
+#include <memory>
 #include <QDir>
 #include <QBuffer>
 
@@ -842,18 +844,23 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
-    if (dbuf.isEmpty()) {
+    // the score is parsed while it is inflated, without an intermediate buffer
+    std::unique_ptr<QIODevice> scoreDevice(uz.fileDevice(rootfile));
+    if (!scoreDevice || scoreDevice->size() == 0) {
         QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
         foreach (const MQZipReader::FileInfo& fi, fil) {
             if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+                scoreDevice.reset(uz.fileDevice(fi.filePath));
                 break;
             }
         }
     }
+    if (!scoreDevice) {
+        scoreDevice = std::make_unique<QBuffer>();
+        scoreDevice->open(QIODevice::ReadOnly);
+    }
 
-    XmlReader e(dbuf);
+    XmlReader e(scoreDevice.get());
     e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
     FileError retval = read1(e, ignoreVersionError);
@@ -920,6 +927,23 @@ Score::FileError MasterScore::loadMsc(QString name, bool ignoreVersionError)
         MScore::lastError = f.errorString();
         return FileError::FILE_OPEN_ERROR;
     }
+
+    //! NOTE Read the file through a memory mapping if possible: .mscx is parsed
+    //! from the mapped pages and .mscz entries are read from them without
+    //! loading the whole archive into memory first
+    const qint64 size = f.size();
+    if (size > 0 && size < std::numeric_limits<int>::max()) {
+        if (uchar* data = f.map(0, size)) {
+            QByteArray mapped = QByteArray::fromRawData(reinterpret_cast<const char*>(data), int(size));
+            QBuffer buffer(&mapped);
+            buffer.open(QIODevice::ReadOnly);
+            FileError rv = loadMsc(name, &buffer, ignoreVersionError);
+            buffer.close();
+            f.unmap(data);
+            return rv;
+        }
+    }
+
     return loadMsc(name, &f, ignoreVersionError);
 }
 
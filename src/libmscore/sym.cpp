@@ -34,6 +34,7 @@
 #include "score.h"
 #include "xml.h"
 #include "mscore.h"
+#include "glyphatlas.h"
 
 #include FT_GLYPH_H
 #include FT_IMAGE_H
@@ -49,6 +50,9 @@ namespace Ms {
 
 static const int FALLBACK_FONT = 1;       // Bravura
 
+// colorized pixmaps, ready to draw; the coverage of the glyphs is kept by GlyphAtlas
+static const int COLORED_GLYPHS_CACHE_BYTES = 8 * 1024 * 1024;
+
 QVector<ScoreFont> ScoreFont::_scoreFonts {
     ScoreFont("Leland",     "Leland",      ":/fonts/leland/",    "Leland.otf"),
     ScoreFont("Bravura",    "Bravura",     ":/fonts/bravura/",   "Bravura.otf"),
@@ -182,11 +186,6 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
         }
         return;
     }
-    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-    if (rv) {
-        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-        return;
-    }
 
     if (MScore::pdfPrinting) {
         if (font == 0) {
@@ -226,47 +225,58 @@ void ScoreFont::draw(SymId id, mu::draw::Painter* painter, const QSizeF& mag, co
     GlyphPixmap* pm = cache->object(gk);
 
     if (!pm) {
-        FT_Matrix matrix {
-            scale16X, 0,
-            0,       scale16Y
-        };
-
-        FT_Glyph glyph;
-        FT_Get_Glyph(face->glyph, &glyph);
-        FT_Glyph_Transform(glyph, &matrix, 0);
-        rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
-        if (rv) {
-            qDebug("glyph to bitmap failed: 0x%x", rv);
-            return;
-        }
+        // the colorized pixmap is not cached, the coverage may be in the atlas
+        GlyphAtlas* atlas = GlyphAtlas::instance();
+        GlyphAtlas::Key ak { face, sym(id).index(), scale16X, scale16Y };
+        const GlyphAtlas::Glyph* g = atlas->glyph(ak);
+
+        if (!g) {
+            int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+            if (rv) {
+                qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+                return;
+            }
+
+            FT_Matrix matrix {
+                scale16X, 0,
+                0,       scale16Y
+            };
+
+            FT_Glyph glyph;
+            FT_Get_Glyph(face->glyph, &glyph);
+            FT_Glyph_Transform(glyph, &matrix, 0);
+            rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
+            if (rv) {
+                qDebug("glyph to bitmap failed: 0x%x", rv);
+                return;
+            }
 
-        FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
-        FT_Bitmap* bm     = &gb->bitmap;
+            FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
+            g = atlas->insert(ak, &gb->bitmap, QPoint(gb->left, -gb->top));
+            FT_Done_Glyph(glyph);
+            if (!g) {
+                qDebug("cannot add glyph to atlas, id %d", int(id));
+                return;
+            }
+        }
 
-        if (bm->width == 0 || bm->rows == 0) {
-            qDebug("zero glyph, id %d", int(id));
+        QImage img = atlas->colorize(*g, color);
+        if (img.isNull()) {         // no pixels, e.g. a space
             return;
         }
-        QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-        img.fill(Qt::transparent);
-
-        for (unsigned y = 0; y < bm->rows; ++y) {
-            unsigned* dst      = (unsigned*)img.scanLine(y);
-            unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
-            for (unsigned x = 0; x < bm->width; ++x) {
-                unsigned val = *src++;
-                color.setAlpha(std::min(int(val), painter->pen().color().alpha()));
-                *dst++ = color.rgba();
-            }
-        }
+
+        QPixmap pixmap = QPixmap::fromImage(img, Qt::NoFormatConversion);
+        pixmap.setDevicePixelRatio(worldScale);
+        QPointF offset = QPointF(g->offset) / worldScale;
+
         pm = new GlyphPixmap;
-        pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-        pm->pm.setDevicePixelRatio(worldScale);
-        pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
+        pm->pm = pixmap;
+        pm->offset = offset;
+        if (!cache->insert(gk, pm, img.sizeInBytes())) {
+            // bigger than the whole cache, QCache deleted it
+            painter->drawPixmap(pos + offset, pixmap);
+            return;
         }
-        FT_Done_Glyph(glyph);
     }
     painter->drawPixmap(pos + pm->offset, pm->pm);
 }
@@ -429,7 +439,7 @@ void ScoreFont::load()
         qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
         return;
     }
-    cache = new QCache<GlyphKey, GlyphPixmap>(100);
+    cache = new QCache<GlyphKey, GlyphPixmap>(COLORED_GLYPHS_CACHE_BYTES);
 
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(face, 0, int(pixelSize + .5));
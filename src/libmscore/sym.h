@@ -143,7 +143,7 @@ struct GlyphPixmap {
 
 inline uint qHash(const GlyphKey& k)
 {
-    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100;
+    return (int(k.id) << 16) + (int(k.magX * 100) << 8) + k.magY * 100 + int(k.worldScale * 1000) * 31 + k.color.rgba();
 }
 
 //---------------------------------------------------------
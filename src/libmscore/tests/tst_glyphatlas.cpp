@@ -0,0 +1,209 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "testing/qtestsuite.h"
+#include "libmscore/glyphatlas.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestGlyphAtlas
+//---------------------------------------------------------
+
+class TestGlyphAtlas : public QObject
+{
+    Q_OBJECT
+
+    //! a FreeType gray bitmap with the same coverage in all pixels
+    struct Bitmap {
+        std::vector<unsigned char> pixels;
+        FT_Bitmap bitmap;
+
+        Bitmap(int width, int height, unsigned char coverage)
+            : pixels(size_t(width) * height, coverage), bitmap()
+        {
+            bitmap.width = width;
+            bitmap.rows = height;
+            bitmap.pitch = width;
+            bitmap.buffer = pixels.data();
+            bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+            bitmap.num_grays = 256;
+        }
+    };
+
+    static GlyphAtlas::Key key(uint glyphIndex)
+    {
+        return GlyphAtlas::Key { nullptr, glyphIndex, 65536, 65536 };
+    }
+
+private slots:
+    void packShelves();
+    void hugeGlyphOwnPage();
+    void evictWhenFull();
+    void emptyGlyph();
+    void colorize();
+};
+
+//---------------------------------------------------------
+//   packShelves
+//    glyphs are placed left to right, a glyph that doesn't
+//    fit the row starts the next one below the highest glyph
+//---------------------------------------------------------
+
+void TestGlyphAtlas::packShelves()
+{
+    GlyphAtlas atlas;
+    Bitmap bitmap(300, 10, 255);
+    Bitmap tall(300, 20, 255);
+
+    QVERIFY(!atlas.glyph(key(1)));
+
+    std::vector<GlyphAtlas::Glyph> glyphs;
+    for (uint i = 1; i <= 4; ++i) {
+        const GlyphAtlas::Glyph* g = atlas.insert(key(i), i == 2 ? &tall.bitmap : &bitmap.bitmap, QPoint(1, -2));
+        QVERIFY(g);
+        glyphs.push_back(*g);
+    }
+
+    for (const GlyphAtlas::Glyph& g : glyphs) {
+        QCOMPARE(g.page, 0);
+        QCOMPARE(g.offset, QPoint(1, -2));
+    }
+    QCOMPARE(glyphs[0].rect, QRect(0, 0, 300, 10));
+    QCOMPARE(glyphs[1].rect, QRect(301, 0, 300, 20));
+    QCOMPARE(glyphs[2].rect, QRect(602, 0, 300, 10));
+    QCOMPARE(glyphs[3].rect, QRect(0, 21, 300, 10));
+
+    const GlyphAtlas::Glyph* g = atlas.glyph(key(2));
+    QVERIFY(g);
+    QCOMPARE(g->rect, glyphs[1].rect);
+
+    QCOMPARE(atlas.stats().glyphs, 4);
+    QCOMPARE(atlas.stats().pages, 1);
+    QCOMPARE(atlas.stats().hits, quint64(1));
+    QCOMPARE(atlas.stats().misses, quint64(1));
+}
+
+//---------------------------------------------------------
+//   hugeGlyphOwnPage
+//---------------------------------------------------------
+
+void TestGlyphAtlas::hugeGlyphOwnPage()
+{
+    GlyphAtlas atlas;
+    Bitmap small(10, 10, 255);
+    Bitmap huge(1100, 20, 255);
+
+    QCOMPARE(atlas.insert(key(1), &small.bitmap, QPoint())->page, 0);
+
+    const GlyphAtlas::Glyph* g = atlas.insert(key(2), &huge.bitmap, QPoint());
+    QVERIFY(g);
+    QCOMPARE(g->page, 1);
+    QCOMPARE(g->rect, QRect(0, 0, 1100, 20));
+
+    // the page of the huge glyph is full, the next glyph gets a new page
+    QCOMPARE(atlas.insert(key(3), &small.bitmap, QPoint())->page, 2);
+    QCOMPARE(atlas.stats().pages, 3);
+}
+
+//---------------------------------------------------------
+//   evictWhenFull
+//    the atlas is cleared when a new page would exceed
+//    its memory limit
+//---------------------------------------------------------
+
+void TestGlyphAtlas::evictWhenFull()
+{
+    GlyphAtlas atlas;
+    atlas.setMaxBytes(2 * 1024 * 1024);
+    Bitmap bitmap(1000, 1000, 255);
+
+    QVERIFY(atlas.insert(key(1), &bitmap.bitmap, QPoint()));
+    QVERIFY(atlas.insert(key(2), &bitmap.bitmap, QPoint()));
+    QCOMPARE(atlas.stats().pages, 2);
+    QCOMPARE(atlas.stats().evictions, quint64(0));
+
+    const GlyphAtlas::Glyph* g = atlas.insert(key(3), &bitmap.bitmap, QPoint());
+    QVERIFY(g);
+    QCOMPARE(g->page, 0);
+    QCOMPARE(atlas.stats().evictions, quint64(1));
+    QCOMPARE(atlas.stats().pages, 1);
+    QCOMPARE(atlas.stats().glyphs, 1);
+    QCOMPARE(atlas.stats().bytes, qint64(1024 * 1024));
+
+    QVERIFY(!atlas.glyph(key(1)));
+    QVERIFY(atlas.glyph(key(3)));
+}
+
+//---------------------------------------------------------
+//   emptyGlyph
+//    glyphs without pixels are cached too
+//---------------------------------------------------------
+
+void TestGlyphAtlas::emptyGlyph()
+{
+    GlyphAtlas atlas;
+    Bitmap empty(0, 0, 0);
+
+    QVERIFY(atlas.insert(key(1), &empty.bitmap, QPoint()));
+    const GlyphAtlas::Glyph* g = atlas.glyph(key(1));
+    QVERIFY(g);
+    QVERIFY(g->rect.isEmpty());
+    QVERIFY(atlas.colorize(*g, Qt::black).isNull());
+    QCOMPARE(atlas.stats().pages, 0);
+}
+
+//---------------------------------------------------------
+//   colorize
+//    the coverage scales the premultiplied color
+//---------------------------------------------------------
+
+void TestGlyphAtlas::colorize()
+{
+    GlyphAtlas atlas;
+    Bitmap full(4, 3, 255);
+    Bitmap half(4, 3, 128);
+    Bitmap none(4, 3, 0);
+
+    const GlyphAtlas::Glyph fullGlyph = *atlas.insert(key(1), &full.bitmap, QPoint());
+    const GlyphAtlas::Glyph halfGlyph = *atlas.insert(key(2), &half.bitmap, QPoint());
+    const GlyphAtlas::Glyph noneGlyph = *atlas.insert(key(3), &none.bitmap, QPoint());
+
+    QImage img = atlas.colorize(fullGlyph, QColor(255, 0, 0));
+    QCOMPARE(img.size(), QSize(4, 3));
+    QCOMPARE(img.format(), QImage::Format_ARGB32_Premultiplied);
+    QCOMPARE(img.pixel(3, 2), qRgba(255, 0, 0, 255));
+
+    img = atlas.colorize(fullGlyph, QColor(0, 0, 255, 128));
+    QCOMPARE(img.pixel(0, 0), qPremultiply(qRgba(0, 0, 255, 128)));
+
+    img = atlas.colorize(halfGlyph, QColor(255, 0, 0));
+    QCOMPARE(img.pixel(1, 1), qRgba(128, 0, 0, 128));
+
+    img = atlas.colorize(noneGlyph, QColor(255, 0, 0));
+    QCOMPARE(img.pixel(1, 1), qRgba(0, 0, 0, 0));
+}
+
+QTEST_MAIN(TestGlyphAtlas)
+#include "tst_glyphatlas.moc"
@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/layoutprofiler.h"
+#include "libmscore/score.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestLayoutProfiler
+//---------------------------------------------------------
+
+class TestLayoutProfiler : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void disabledRecordsNothing();
+    void stagesPerPass();
+    void chromeTrace();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestLayoutProfiler::initTestCase()
+{
+    initMTest();
+}
+
+void TestLayoutProfiler::cleanup()
+{
+    LayoutProfiler::setEnabled(false);
+    LayoutProfiler::instance()->clear();
+}
+
+//---------------------------------------------------------
+//   disabledRecordsNothing
+//---------------------------------------------------------
+
+void TestLayoutProfiler::disabledRecordsNothing()
+{
+    MasterScore* score = readScore("test.mscx");
+    QVERIFY(score);
+
+    LayoutProfiler::instance()->clear();
+    score->doLayout();
+
+    for (const LayoutProfiler::StageStats& st : LayoutProfiler::instance()->stats()) {
+        QCOMPARE(st.calls, quint64(0));
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   stagesPerPass
+//    one command is one endCmd with its doLayoutRange
+//---------------------------------------------------------
+
+void TestLayoutProfiler::stagesPerPass()
+{
+    MasterScore* score = readScore("test.mscx");
+    QVERIFY(score);
+
+    LayoutProfiler::setEnabled(true);
+
+    score->startCmd();
+    score->appendMeasures(20);
+    score->endCmd();
+
+    auto stats = LayoutProfiler::instance()->stats();
+    QCOMPARE(stats[size_t(LayoutProfiler::Stage::EndCmd)].calls, quint64(1));
+    QCOMPARE(stats[size_t(LayoutProfiler::Stage::DoLayoutRange)].calls, quint64(1));
+    QVERIFY(stats[size_t(LayoutProfiler::Stage::GetNextMeasure)].calls >= 20);
+    QVERIFY(stats[size_t(LayoutProfiler::Stage::CollectSystem)].calls > 0);
+    QVERIFY(stats[size_t(LayoutProfiler::Stage::LayoutSystemElements)].calls > 0);
+    QVERIFY(stats[size_t(LayoutProfiler::Stage::CollectPage)].calls > 0);
+
+    const LayoutProfiler::StageStats& endCmd = stats[size_t(LayoutProfiler::Stage::EndCmd)];
+    const LayoutProfiler::StageStats& range = stats[size_t(LayoutProfiler::Stage::DoLayoutRange)];
+    QVERIFY(endCmd.totalMs >= range.totalMs);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   chromeTrace
+//---------------------------------------------------------
+
+void TestLayoutProfiler::chromeTrace()
+{
+    MasterScore* score = readScore("test.mscx");
+    QVERIFY(score);
+
+    LayoutProfiler::setEnabled(true);
+    score->doLayout();
+    LayoutProfiler::setEnabled(false);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("layout.json");
+    QVERIFY(LayoutProfiler::instance()->writeChromeTrace(path));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    QCOMPARE(err.error, QJsonParseError::NoError);
+
+    QJsonArray events = doc.object().value("traceEvents").toArray();
+    QVERIFY(!events.isEmpty());
+
+    int passes = 0;
+    for (const QJsonValue& v : events) {
+        QJsonObject e = v.toObject();
+        QCOMPARE(e.value("ph").toString(), QString("X"));
+        QVERIFY(e.value("dur").toDouble() >= 0.0);
+        if (e.value("name").toString() == "doLayoutRange") {
+            ++passes;
+            QJsonObject args = e.value("args").toObject();
+            QCOMPARE(args.value("startTick").toInt(), 0);
+            QVERIFY(args.value("getNextMeasure").toInt() > 0);
+        }
+    }
+    QCOMPARE(passes, 1);
+
+    delete score;
+}
+
+QTEST_MAIN(TestLayoutProfiler)
+#include "tst_layoutprofiler.moc"
@@ -39,6 +39,8 @@
 #include "libmscore/note.h"
 #include "libmscore/keysig.h"
 #include "libmscore/mcursor.h"
+#include "libmscore/rendermidi.h"
+#include "libmscore/synthesizerstate.h"
 
 //#include "audio/exports/exportmidi.h"
 
@@ -95,6 +97,8 @@ private slots:
     void midiTimeStretchFermataTempoEdit();
     void midiTimeStretchFermataTempoEditContinuousView();
     void midiSingleNoteDynamics();
+    void incrementalRendering_data();
+    void incrementalRendering();
 };
 
 //---------------------------------------------------------
@@ -547,6 +551,90 @@ void TestMidi::midiSingleNoteDynamics()
     delete score;
 }
 
+//---------------------------------------------------------
+//   renderChunks
+//    render the score chunk by chunk like playback does
+//---------------------------------------------------------
+
+static QStringList renderChunks(MidiRenderer& renderer, const SynthesizerState& ss)
+{
+    MidiRenderer::Context ctx(ss);
+    ctx.metronome = false;
+    ctx.renderHarmony = true;
+
+    EventMap events;
+    renderer.setScoreChanged();
+    for (MidiRenderer::Chunk chunk = renderer.chunkAt(0); chunk; chunk = renderer.chunkAt(chunk.utick2())) {
+        renderer.renderChunk(chunk, &events, ctx);
+    }
+
+    QStringList list;
+    for (const auto& e : events) {
+        list << QString("%1 %2 %3 %4 %5").arg(e.first).arg(e.second.type()).arg(e.second.dataA())
+            .arg(e.second.dataB()).arg(e.second.channel());
+    }
+    return list;
+}
+
+//---------------------------------------------------------
+//   incrementalRendering
+//    a renderer reused after an edit renders only the changed
+//    measures again, the result must not differ from a
+//    rendering from scratch
+//---------------------------------------------------------
+
+void TestMidi::incrementalRendering_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::newRow("testKantataBWV140Excerpts") << "testKantataBWV140Excerpts";
+    QTest::newRow("testChannelsDynamics") << "testChannelsDynamics";
+}
+
+void TestMidi::incrementalRendering()
+{
+    QFETCH(QString, file);
+
+    MasterScore* score = readScore(MIDI_DATA_DIR + file + ".mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    SynthesizerState ss;
+    MidiRenderer renderer(score);
+    renderer.setMinChunkSize(2);
+
+    const QStringList before = renderChunks(renderer, ss);
+    QVERIFY(!before.isEmpty());
+    QCOMPARE(renderChunks(renderer, ss), before);
+
+    Note* note = nullptr;
+    Measure* m = score->firstMeasure()->nextMeasure();
+    QVERIFY(m);
+    for (Segment* s = m->first(SegmentType::ChordRest); s && !note; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (e && e->isChord() && !toChord(e)->upNote()->tieBack()) {
+                note = toChord(e)->upNote();
+                break;
+            }
+        }
+    }
+    QVERIFY(note);
+
+    score->startCmd();
+    note->undoChangeProperty(Pid::VELO_OFFSET, 40);
+    score->endCmd();
+
+    const QStringList edited = renderChunks(renderer, ss);
+    QVERIFY(edited != before);
+    MidiRenderer fresh(score);
+    fresh.setMinChunkSize(2);
+    QCOMPARE(edited, renderChunks(fresh, ss));
+
+    score->undoRedo(true, nullptr);
+    QCOMPARE(renderChunks(renderer, ss), before);
+
+    delete score;
+}
+
 //---------------------------------------------------------
 //   events
 //---------------------------------------------------------
@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <QBuffer>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
+
+#include <memory>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+
+#include "libmscore/score.h"
+
+#include "runtime.h"
+
+#include "thirdparty/qzip/qzipreader_p.h"
+#include "thirdparty/qzip/qzipwriter_p.h"
+
+//! NOTE Directory with the scores to measure, the benchmark is skipped when not set
+static const char* CORPUS_ENV("SCORE_LOAD_BENCHMARK_CORPUS");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreLoad
+//---------------------------------------------------------
+
+class TestScoreLoad : public QObject, public MTest
+{
+    Q_OBJECT
+
+    static QByteArray testData();
+    static QByteArray readInChunks(QIODevice* device, int chunkSize);
+    void checkZipEntries(QIODevice* zipDevice, const QByteArray& data);
+
+private slots:
+    void initTestCase();
+    void zipEntryDevice_data();
+    void zipEntryDevice();
+    void benchmarkLoad();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreLoad::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   testData
+//    compressible, but not trivially
+//---------------------------------------------------------
+
+QByteArray TestScoreLoad::testData()
+{
+    QByteArray data;
+    for (int i = 0; i < 20000; ++i) {
+        data += QByteArray("<Note><pitch>") + QByteArray::number(i % 127)
+                + "</pitch><tpc>" + QByteArray::number((i * 7) % 35) + "</tpc></Note>\n";
+    }
+    return data;
+}
+
+//---------------------------------------------------------
+//   readInChunks
+//---------------------------------------------------------
+
+QByteArray TestScoreLoad::readInChunks(QIODevice* device, int chunkSize)
+{
+    QByteArray result;
+    QByteArray chunk(chunkSize, 0);
+    qint64 n = 0;
+    while ((n = device->read(chunk.data(), chunkSize)) > 0) {
+        result.append(chunk.constData(), int(n));
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//   checkZipEntries
+//---------------------------------------------------------
+
+void TestScoreLoad::checkZipEntries(QIODevice* zipDevice, const QByteArray& data)
+{
+    MQZipReader uz(zipDevice);
+
+    QCOMPARE(uz.fileData("score.mscx"), data);
+
+    std::unique_ptr<QIODevice> entry(uz.fileDevice("score.mscx"));
+    QVERIFY(entry);
+    QCOMPARE(entry->size(), qint64(data.size()));
+    QCOMPARE(readInChunks(entry.get(), 1000), data);
+    QVERIFY(entry->atEnd());
+
+    // reading other entries in between must not disturb the stream
+    entry.reset(uz.fileDevice("score.mscx"));
+    QByteArray firstPart = entry->read(4096);
+    QCOMPARE(uz.fileData("META-INF/container.xml"), QByteArray("container"));
+    QCOMPARE(firstPart + entry->readAll(), data);
+
+    QVERIFY(!uz.fileDevice("missing.mscx"));
+}
+
+//---------------------------------------------------------
+//   zipEntryDevice
+//    entries read from the device match fileData()
+//---------------------------------------------------------
+
+void TestScoreLoad::zipEntryDevice_data()
+{
+    QTest::addColumn<bool>("compress");
+    QTest::newRow("stored") << false;
+    QTest::newRow("deflated") << true;
+}
+
+void TestScoreLoad::zipEntryDevice()
+{
+    QFETCH(bool, compress);
+
+    const QByteArray data = testData();
+
+    QBuffer zipBuffer;
+    zipBuffer.open(QIODevice::WriteOnly);
+    {
+        MQZipWriter uz(&zipBuffer);
+        uz.setCompressionPolicy(compress ? MQZipWriter::AlwaysCompress : MQZipWriter::NeverCompress);
+        uz.addFile("META-INF/container.xml", QByteArray("container"));
+        uz.addFile("score.mscx", data);
+        uz.close();
+    }
+    zipBuffer.close();
+
+    // in memory, as with a mapped file
+    QBuffer memoryDevice(&zipBuffer.buffer());
+    QVERIFY(memoryDevice.open(QIODevice::ReadOnly));
+    checkZipEntries(&memoryDevice, data);
+
+    // on disk, read in chunks from the file
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(zipBuffer.buffer());
+    file.flush();
+    QVERIFY(file.seek(0));
+    checkZipEntries(&file, data);
+}
+
+//---------------------------------------------------------
+//   benchmarkLoad
+//    load throughput and peak memory, not a regression test.
+//    Opt-in, runs only with CORPUS_ENV set
+//---------------------------------------------------------
+
+void TestScoreLoad::benchmarkLoad()
+{
+    QString dir = qEnvironmentVariable(CORPUS_ENV);
+    if (dir.isEmpty()) {
+        QSKIP("set SCORE_LOAD_BENCHMARK_CORPUS to the directory of the scores to measure");
+    }
+
+    QStringList files;
+    QDirIterator it(dir, { "*.mscx", "*.mscz" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files << it.next();
+    }
+    files.sort();
+    if (files.isEmpty()) {
+        QSKIP("no scores to load");
+    }
+
+    qint64 bytes = 0;
+    qint64 elapsedNs = 0;
+    int failed = 0;
+
+    QBENCHMARK {
+        failed = 0;
+        for (const QString& path : files) {
+            MasterScore* score = new MasterScore(mscore->baseStyle());
+            score->setName(QFileInfo(path).completeBaseName());
+
+            QElapsedTimer timer;
+            timer.start();
+
+            ScoreLoad sl;
+            if (score->loadMsc(path, false) != Score::FileError::FILE_NO_ERROR) {
+                ++failed;
+            }
+
+            elapsedNs += timer.nsecsElapsed();
+            bytes += QFileInfo(path).size();
+            delete score;
+        }
+    }
+
+    qDebug("Score load: %d files (%d failed), %s",
+           int(files.size()), failed, mu::runtime::throughputInfo(bytes, elapsedNs / 1e9).c_str());
+
+    QCOMPARE(failed, 0);
+}
+
+QTEST_MAIN(TestScoreLoad)
+#include "tst_scoreload.moc"
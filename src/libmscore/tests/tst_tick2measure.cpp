@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/undo.h"
+
+static const int MEASURES_COUNT = 2000;
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestTick2Measure
+//---------------------------------------------------------
+
+class TestTick2Measure : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore * score = nullptr;
+
+    Measure* linearTick2measure(const Fraction& tick) const;
+    void checkAllMeasures() const;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void tick2measure();
+    void tick2measureAfterEdit();
+    void benchmarkIndexed();
+    void benchmarkLinear();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestTick2Measure::initTestCase()
+{
+    initMTest();
+    score = readScore("test.mscx");
+    QVERIFY(score);
+
+    score->startCmd();
+    score->appendMeasures(MEASURES_COUNT);
+    score->endCmd();
+}
+
+void TestTick2Measure::cleanupTestCase()
+{
+    delete score;
+}
+
+//---------------------------------------------------------
+//   linearTick2measure
+//    reference, the walk which was used before the tick index
+//---------------------------------------------------------
+
+Measure* TestTick2Measure::linearTick2measure(const Fraction& tick) const
+{
+    Measure* lm = nullptr;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        if (tick < m->tick()) {
+            return lm;
+        }
+        lm = m;
+    }
+    if (lm && tick >= lm->tick() && tick <= lm->endTick()) {
+        return lm;
+    }
+    return nullptr;
+}
+
+void TestTick2Measure::checkAllMeasures() const
+{
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        QCOMPARE(score->tick2measure(m->tick()), m);
+        Fraction middle = m->tick() + m->ticks() / 2;
+        QCOMPARE(score->tick2measure(middle), linearTick2measure(middle));
+    }
+
+    Measure* last = score->lastMeasure();
+    QCOMPARE(score->tick2measure(last->endTick()), last);
+    QVERIFY(!score->tick2measure(last->endTick() + Fraction(1, 4)));
+    QCOMPARE(score->tick2measure(Fraction(-1, 1)), last);
+}
+
+//---------------------------------------------------------
+//   tick2measure
+//---------------------------------------------------------
+
+void TestTick2Measure::tick2measure()
+{
+    QVERIFY(score->nmeasures() > MEASURES_COUNT);
+    checkAllMeasures();
+}
+
+//---------------------------------------------------------
+//   tick2measureAfterEdit
+//    the index must follow insert, remove and undo of measures
+//---------------------------------------------------------
+
+void TestTick2Measure::tick2measureAfterEdit()
+{
+    Measure* m = score->tick2measure(score->lastMeasure()->tick() / 2);
+    QVERIFY(m);
+
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, m);
+    score->endCmd();
+    checkAllMeasures();
+
+    score->startCmd();
+    score->deleteMeasures(m, m);
+    score->endCmd();
+    checkAllMeasures();
+
+    score->undoRedo(true, 0);
+    checkAllMeasures();
+
+    score->undoRedo(true, 0);
+    checkAllMeasures();
+}
+
+//---------------------------------------------------------
+//   benchmarkIndexed
+//---------------------------------------------------------
+
+void TestTick2Measure::benchmarkIndexed()
+{
+    Fraction endTick = score->lastMeasure()->endTick();
+    Fraction step(1, 4);
+    QBENCHMARK {
+        for (Fraction tick = step; tick < endTick; tick += step) {
+            score->tick2measure(tick);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   benchmarkLinear
+//---------------------------------------------------------
+
+void TestTick2Measure::benchmarkLinear()
+{
+    Fraction endTick = score->lastMeasure()->endTick();
+    Fraction step(1, 4);
+    QBENCHMARK {
+        for (Fraction tick = step; tick < endTick; tick += step) {
+            linearTick2measure(tick);
+        }
+    }
+}
+
+QTEST_MAIN(TestTick2Measure)
+#include "tst_tick2measure.moc"
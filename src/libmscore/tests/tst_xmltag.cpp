@@ -0,0 +1,238 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+
+#include "libmscore/xml.h"
+#include "libmscore/xmltag.h"
+
+static const QString DEMOS_DIR("../../../demos/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestXmlTag
+//---------------------------------------------------------
+
+class TestXmlTag : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QStringList readTagNames(const QString& path) const;
+
+private slots:
+    void initTestCase();
+    void lookup();
+    void readerTag();
+    void benchmarkStringDispatch_data();
+    void benchmarkStringDispatch();
+    void benchmarkTagDispatch_data();
+    void benchmarkTagDispatch();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestXmlTag::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   lookup
+//    every name maps back to its tag, anything else is unknown
+//---------------------------------------------------------
+
+void TestXmlTag::lookup()
+{
+    for (int i = int(XmlTag::UNKNOWN) + 1; i < int(XmlTag::TAGS); ++i) {
+        const XmlTag tag = XmlTag(i);
+        const QString name(xmlTagName(tag));
+        QVERIFY(!name.isEmpty());
+        QCOMPARE(xmlTag(QStringRef(&name)), tag);
+    }
+
+    const QStringList unknownNames = { "", "note", "NOTE", "Notes", "Not", "Chordd", "été", "noteheadScheme" };
+    for (const QString& name : unknownNames) {
+        QCOMPARE(xmlTag(QStringRef(&name)), XmlTag::UNKNOWN);
+    }
+
+    // a substring of a longer string
+    const QString text("<Chord>");
+    QCOMPARE(xmlTag(text.midRef(1, 5)), XmlTag::CHORD);
+}
+
+//---------------------------------------------------------
+//   readerTag
+//    XmlReader::tag() follows the current token
+//---------------------------------------------------------
+
+void TestXmlTag::readerTag()
+{
+    XmlReader e(QByteArray("<Chord><durationType>quarter</durationType><Note><pitch>60</pitch></Note>"
+                           "<Note><pitch>64</pitch></Note><unknownTag/></Chord>"));
+
+    QVERIFY(e.readNextStartElement());
+    QCOMPARE(e.tag(), XmlTag::CHORD);
+
+    QList<XmlTag> tags;
+    while (e.readNextStartElement()) {
+        tags.append(e.tag());
+        QCOMPARE(e.tag(), tags.last());     // cached
+        if (e.tag() == XmlTag::NOTE) {
+            while (e.readNextStartElement()) {
+                tags.append(e.tag());
+                e.skipCurrentElement();
+            }
+        } else {
+            e.skipCurrentElement();
+        }
+    }
+    const QList<XmlTag> expected = { XmlTag::DURATION_TYPE, XmlTag::NOTE, XmlTag::PITCH,
+                                     XmlTag::NOTE, XmlTag::PITCH, XmlTag::UNKNOWN };
+    QCOMPARE(tags, expected);
+}
+
+//---------------------------------------------------------
+//   readTagNames
+//    names of all start elements of a score, in file order
+//---------------------------------------------------------
+
+QStringList TestXmlTag::readTagNames(const QString& path) const
+{
+    QFile f(root + "/" + path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return QStringList();
+    }
+    QStringList names;
+    XmlReader e(&f);
+    while (!e.atEnd()) {
+        if (e.readNext() == QXmlStreamReader::StartElement) {
+            names.append(e.name().toString());
+        }
+    }
+    return names;
+}
+
+//---------------------------------------------------------
+//   benchmarkStringDispatch
+//    the if/else chain of Chord/ChordRest/Note reading
+//    as it was before the tag ids, on the tags of a score
+//---------------------------------------------------------
+
+void TestXmlTag::benchmarkStringDispatch_data()
+{
+    QTest::addColumn<QStringList>("names");
+    QTest::newRow("Fugue_1") << readTagNames(DEMOS_DIR + "Fugue_1.mscx");
+    QTest::newRow("Dawn") << readTagNames(DEMOS_DIR + "Dawn.mscx");
+}
+
+void TestXmlTag::benchmarkStringDispatch()
+{
+    QFETCH(QStringList, names);
+    QVERIFY(!names.isEmpty());
+
+    static const char* chain[] = {
+        "Note", "durationType", "BeamMode", "Articulation", "leadingSpace", "trailingSpace", "small",
+        "duration", "ticklen", "dots", "staffMove", "Spanner", "Lyrics", "pos", "Stem", "Hook",
+        "appoggiatura", "acciaccatura", "grace4", "grace16", "grace32", "grace8after", "grace16after",
+        "grace32after", "StemSlash", "noStem", "Arpeggio", "Tremolo", "tickOffset", "ChordLine"
+    };
+
+    int matched = 0;
+    QBENCHMARK {
+        matched = 0;
+        for (const QString& name : names) {
+            const QStringRef tag(&name);
+            for (const char* s : chain) {
+                if (tag == s) {
+                    ++matched;
+                    break;
+                }
+            }
+        }
+    }
+    QVERIFY(matched > 0);
+}
+
+//---------------------------------------------------------
+//   benchmarkTagDispatch
+//---------------------------------------------------------
+
+void TestXmlTag::benchmarkTagDispatch_data()
+{
+    benchmarkStringDispatch_data();
+}
+
+void TestXmlTag::benchmarkTagDispatch()
+{
+    QFETCH(QStringList, names);
+    QVERIFY(!names.isEmpty());
+
+    int matched = 0;
+    QBENCHMARK {
+        matched = 0;
+        for (const QString& name : names) {
+            switch (xmlTag(QStringRef(&name))) {
+            case XmlTag::NOTE:
+            case XmlTag::DURATION_TYPE:
+            case XmlTag::BEAM_MODE:
+            case XmlTag::ARTICULATION:
+            case XmlTag::LEADING_SPACE:
+            case XmlTag::TRAILING_SPACE:
+            case XmlTag::SMALL:
+            case XmlTag::DURATION:
+            case XmlTag::TICKLEN:
+            case XmlTag::DOTS:
+            case XmlTag::STAFF_MOVE:
+            case XmlTag::SPANNER:
+            case XmlTag::LYRICS:
+            case XmlTag::POS:
+            case XmlTag::STEM:
+            case XmlTag::HOOK:
+            case XmlTag::APPOGGIATURA:
+            case XmlTag::ACCIACCATURA:
+            case XmlTag::GRACE4:
+            case XmlTag::GRACE16:
+            case XmlTag::GRACE32:
+            case XmlTag::GRACE8AFTER:
+            case XmlTag::GRACE16AFTER:
+            case XmlTag::GRACE32AFTER:
+            case XmlTag::STEM_SLASH:
+            case XmlTag::NO_STEM:
+            case XmlTag::ARPEGGIO:
+            case XmlTag::TREMOLO:
+            case XmlTag::TICK_OFFSET:
+            case XmlTag::CHORD_LINE:
+                ++matched;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    QVERIFY(matched > 0);
+}
+
+QTEST_MAIN(TestXmlTag)
+#include "tst_xmltag.moc"
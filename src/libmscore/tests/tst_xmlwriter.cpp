@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <QBuffer>
+#include <QElapsedTimer>
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+
+#include "libmscore/score.h"
+#include "libmscore/xml.h"
+
+static const QString DEMOS_DIR("../../../demos/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestXmlWriter
+//---------------------------------------------------------
+
+class TestXmlWriter : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void typedTags();
+    void escape();
+    void flushTopLevel();
+    void benchmarkWrite_data();
+    void benchmarkWrite();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestXmlWriter::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   typedTags
+//    typed values are written like their QVariant
+//---------------------------------------------------------
+
+void TestXmlWriter::typedTags()
+{
+    QBuffer typed;
+    typed.open(QIODevice::WriteOnly);
+    QBuffer variant;
+    variant.open(QIODevice::WriteOnly);
+    {
+        XmlWriter xml(nullptr, &typed);
+        xml.stag("Chord");
+        xml.tag("int", 42);
+        xml.tag("negative", -7);
+        xml.tag("bool", true);
+        xml.tag("long", qint64(1) << 40);
+        xml.tag("real", 0.125);
+        xml.tag("large", 1234567.0);
+        xml.tag("default", 3, 3);
+        xml.tag("text", "a<b");
+        xml.tag("attr foo=\"bar\"", 5);
+        xml.tag("ticks", Fraction(3, 8));
+        xml.etag();
+    }
+    {
+        XmlWriter xml(nullptr, &variant);
+        xml.stag("Chord");
+        xml.tag(QString("int"), QVariant(42));
+        xml.tag(QString("negative"), QVariant(-7));
+        xml.tag(QString("bool"), QVariant(true));
+        xml.tag(QString("long"), QVariant(qint64(1) << 40));
+        xml.tag(QString("real"), QVariant(0.125));
+        xml.tag(QString("large"), QVariant(1234567.0));
+        xml.tag("default", QVariant(3), QVariant(3));
+        xml.tag(QString("text"), QVariant("a<b"));
+        xml.tag(QString("attr foo=\"bar\""), QVariant(5));
+        xml.tag(QString("ticks"), Fraction(3, 8));
+        xml.etag();
+    }
+    QCOMPARE(typed.data(), variant.data());
+    QVERIFY(typed.data().contains("  <attr foo=\"bar\">5</attr>\n"));
+    QVERIFY(typed.data().contains("  <ticks>3/8</ticks>\n"));
+    QVERIFY(!typed.data().contains("default"));
+}
+
+//---------------------------------------------------------
+//   escape
+//---------------------------------------------------------
+
+void TestXmlWriter::escape()
+{
+    QCOMPARE(XmlWriter::xmlString("plain text"), QString("plain text"));
+    QCOMPARE(XmlWriter::xmlString("a<b>&\"c\""), QString("a&lt;b&gt;&amp;&quot;c&quot;"));
+    QCOMPARE(XmlWriter::xmlString(QString("x") + QChar(0x01) + "y\tz"), QString("xy\tz"));
+    QCOMPARE(XmlWriter::xmlString(QString::fromUtf8("Dvořák")), QString::fromUtf8("Dvořák"));
+}
+
+//---------------------------------------------------------
+//   flushTopLevel
+//    the device is complete once the top level element
+//    is closed, without flushing the writer
+//---------------------------------------------------------
+
+void TestXmlWriter::flushTopLevel()
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    XmlWriter xml(nullptr, &buffer);
+    xml.header();
+    xml.stag("museScore version=\"3.02\"");
+    xml.tag("name", QString::fromUtf8("Dvořák"));
+    xml.etag();
+
+    QCOMPARE(buffer.data(), QByteArray("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                                       "<museScore version=\"3.02\">\n"
+                                       "  <name>Dvo\xc5\x99\xc3\xa1k</name>\n"
+                                       "</museScore>\n"));
+}
+
+//---------------------------------------------------------
+//   benchmarkWrite
+//    bytes/s of Score::saveFile() into memory
+//---------------------------------------------------------
+
+void TestXmlWriter::benchmarkWrite_data()
+{
+    QTest::addColumn<QString>("file");
+
+    QTest::newRow("Fugue_1") << "Fugue_1.mscx";
+    QTest::newRow("Dawn") << "Dawn.mscx";
+}
+
+void TestXmlWriter::benchmarkWrite()
+{
+    QFETCH(QString, file);
+
+    MasterScore* score = readScore(DEMOS_DIR + file);
+    QVERIFY(score);
+
+    qint64 bytes = 0;
+    qint64 elapsedNs = 0;
+    QElapsedTimer timer;
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        timer.start();
+        QVERIFY(score->Score::saveFile(&buffer, false));
+        elapsedNs += timer.nsecsElapsed();
+        bytes += buffer.size();
+    }
+
+    double seconds = elapsedNs / 1e9;
+    qDebug("%s: %.2f MB/s", qPrintable(file), seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0);
+
+    delete score;
+}
+
+QTEST_MAIN(TestXmlWriter)
+#include "tst_xmlwriter.moc"
@@ -20,6 +20,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <QtMath>
 
@@ -65,6 +66,23 @@ Measure* Score::tick2measure(const Fraction& tick) const
         return firstMeasure();
     }
 
+    const std::vector<Measure*>* index = _measures.tickIndex();
+    if (index) {
+        auto it = std::upper_bound(index->begin(), index->end(), tick, [](const Fraction& t, const Measure* m) {
+            return t < m->tick();
+        });
+        if (it == index->begin()) {
+            qDebug("tick2measure %d (min %d) not found", tick.ticks(), index->empty() ? -1 : index->front()->tick().ticks());
+            return 0;
+        }
+        Measure* m = *(it - 1);
+        if (it != index->end() || tick <= m->endTick()) {
+            return m;
+        }
+        qDebug("tick2measure %d (max %d) not found", tick.ticks(), m->tick().ticks());
+        return 0;
+    }
+
     Measure* lm = 0;
     for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
         if (tick < m->tick()) {
@@ -94,6 +112,10 @@ Measure* Score::tick2measureMM(const Fraction& t) const
     if (tick < Fraction(0, 1)) {
         tick = Fraction(0, 1);
     }
+    // without mm rests it is the same walk, use the index
+    if (!styleB(Sid::createMultiMeasureRests)) {
+        return tick2measure(tick);
+    }
 
     Measure* lm = 0;
 
@@ -23,6 +23,8 @@
 #ifndef __XML_H__
 #define __XML_H__
 
+#include <type_traits>
+
 #include <QMultiMap>
 #include <QXmlStreamReader>
 #include <QTextStream>
@@ -32,6 +34,7 @@
 #include "interval.h"
 #include "element.h"
 #include "select.h"
+#include "xmltag.h"
 
 namespace Ms {
 enum class PlaceText : char;
@@ -117,6 +120,9 @@ class XmlReader : public QXmlStreamReader
 
     qint64 _offsetLines { 0 };
 
+    mutable qint64 _tagOffset { -1 };       // character offset of the token _tag belongs to
+    mutable XmlTag _tag { XmlTag::UNKNOWN };
+
 public:
     XmlReader(QFile* f)
         : QXmlStreamReader(f), docName(f->fileName()) {}
@@ -133,6 +139,17 @@ public:
     bool hasAccidental { false };                       // used for userAccidental backward compatibility
     void unknown();
 
+    // id of the current element name, looked up once per token
+    XmlTag tag() const
+    {
+        const qint64 offset = characterOffset();
+        if (offset != _tagOffset) {
+            _tagOffset = offset;
+            _tag = xmlTag(name());
+        }
+        return _tag;
+    }
+
     // attribute helper routines:
     QString attribute(const char* s) const { return attributes().value(s).toString(); }
     QString attribute(const char* s, const QString&) const;
@@ -259,6 +276,18 @@ class XmlWriter : public QTextStream
     bool _recordElements = false;
 
     void putLevel();
+    void putName(const char* name, int len);
+    void putStartTag(const char* name);
+    void putEndTag(const char* name);
+    void endLine();
+    void intTag(const char* name, qint64 val);
+    void realTag(const char* name, double val);
+
+    template<typename T>
+    using IsIntegral = std::enable_if_t<std::is_integral<T>::value
+                                        || (std::is_enum<T>::value && std::is_convertible<T, int>::value), int>;
+    template<typename T>
+    using IsReal = std::enable_if_t<std::is_floating_point<T>::value, int>;
 
 public:
     XmlWriter(Score*);
@@ -316,10 +345,31 @@ public:
     void tag(Pid id, QVariant data, QVariant defaultData = QVariant());
     void tag(const char* name, QVariant data, QVariant defaultData = QVariant());
     void tag(const QString&, QVariant data);
-    void tag(const char* name, const char* s) { tag(name, QVariant(s)); }
-    void tag(const char* name, const QString& s) { tag(name, QVariant(s)); }
+    void tag(const char* name, const char* s) { tag(name, QString(s)); }
+    void tag(const char* name, const QString& s);
+    void tag(const char* name, const Fraction& f);
     void tag(const char* name, const QWidget*);
 
+    // typed values are written without going through QVariant
+    template<typename T, IsIntegral<T> = 0>
+    void tag(const char* name, T val) { intTag(name, static_cast<qint64>(val)); }
+    template<typename T, IsIntegral<T> = 0>
+    void tag(const char* name, T val, T defaultVal)
+    {
+        if (val != defaultVal) {
+            intTag(name, static_cast<qint64>(val));
+        }
+    }
+    template<typename T, IsReal<T> = 0>
+    void tag(const char* name, T val) { realTag(name, val); }
+    template<typename T, IsReal<T> = 0>
+    void tag(const char* name, T val, T defaultVal)
+    {
+        if (val != defaultVal) {
+            realTag(name, val);
+        }
+    }
+
     void comment(const QString&);
 
     void writeXml(const QString&, QString s);
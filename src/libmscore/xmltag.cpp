@@ -0,0 +1,236 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "xmltag.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Ms {
+namespace {
+struct XmlTagName {
+    XmlTag tag;
+    const char* name;
+};
+
+//---------------------------------------------------------
+//   xmlTagNames
+//    in the order of XmlTag
+//---------------------------------------------------------
+
+constexpr XmlTagName xmlTagNames[] = {
+    { XmlTag::UNKNOWN, "" },
+    { XmlTag::ACCIACCATURA, "acciaccatura" },
+    { XmlTag::ACCIDENTAL, "Accidental" },
+    { XmlTag::AMBITUS, "Ambitus" },
+    { XmlTag::APPOGGIATURA, "appoggiatura" },
+    { XmlTag::ARPEGGIO, "Arpeggio" },
+    { XmlTag::ARTICULATION, "Articulation" },
+    { XmlTag::BAR_LINE, "BarLine" },
+    { XmlTag::BEAM, "Beam" },
+    { XmlTag::BEAM_MODE, "BeamMode" },
+    { XmlTag::BEND, "Bend" },
+    { XmlTag::BREATH, "Breath" },
+    { XmlTag::CHORD, "Chord" },
+    { XmlTag::CHORD_LINE, "ChordLine" },
+    { XmlTag::CLEF, "Clef" },
+    { XmlTag::DOT_POSITION, "dotPosition" },
+    { XmlTag::DOTS, "dots" },
+    { XmlTag::DURATION, "duration" },
+    { XmlTag::DURATION_TYPE, "durationType" },
+    { XmlTag::DYNAMIC, "Dynamic" },
+    { XmlTag::END_TUPLET, "endTuplet" },
+    { XmlTag::EVENTS, "Events" },
+    { XmlTag::FERMATA, "Fermata" },
+    { XmlTag::FIGURED_BASS, "FiguredBass" },
+    { XmlTag::FINGERING, "Fingering" },
+    { XmlTag::FIXED, "fixed" },
+    { XmlTag::FIXED_LINE, "fixedLine" },
+    { XmlTag::FRET, "fret" },
+    { XmlTag::FRET_DIAGRAM, "FretDiagram" },
+    { XmlTag::GHOST, "ghost" },
+    { XmlTag::GRACE16, "grace16" },
+    { XmlTag::GRACE16AFTER, "grace16after" },
+    { XmlTag::GRACE32, "grace32" },
+    { XmlTag::GRACE32AFTER, "grace32after" },
+    { XmlTag::GRACE4, "grace4" },
+    { XmlTag::GRACE8AFTER, "grace8after" },
+    { XmlTag::HARMONY, "Harmony" },
+    { XmlTag::HEAD, "head" },
+    { XmlTag::HEAD_SCHEME, "headScheme" },
+    { XmlTag::HEAD_TYPE, "headType" },
+    { XmlTag::HOOK, "Hook" },
+    { XmlTag::IMAGE, "Image" },
+    { XmlTag::INSTRUMENT_CHANGE, "InstrumentChange" },
+    { XmlTag::KEY_SIG, "KeySig" },
+    { XmlTag::LEADING_SPACE, "leadingSpace" },
+    { XmlTag::LINE, "line" },
+    { XmlTag::LOCATION, "location" },
+    { XmlTag::LYRICS, "Lyrics" },
+    { XmlTag::MEASURE_REPEAT, "MeasureRepeat" },
+    { XmlTag::MIRROR, "mirror" },
+    { XmlTag::NO_STEM, "noStem" },
+    { XmlTag::NOTE, "Note" },
+    { XmlTag::NOTE_DOT, "NoteDot" },
+    { XmlTag::OFFSET, "offset" },
+    { XmlTag::PITCH, "pitch" },
+    { XmlTag::PLAY, "play" },
+    { XmlTag::POS, "pos" },
+    { XmlTag::REHEARSAL_MARK, "RehearsalMark" },
+    { XmlTag::REPEAT_MEASURE, "RepeatMeasure" },
+    { XmlTag::REST, "Rest" },
+    { XmlTag::SEGMENT, "Segment" },
+    { XmlTag::SMALL, "small" },
+    { XmlTag::SPANNER, "Spanner" },
+    { XmlTag::STAFF_MOVE, "staffMove" },
+    { XmlTag::STAFF_STATE, "StaffState" },
+    { XmlTag::STAFF_TEXT, "StaffText" },
+    { XmlTag::STEM, "Stem" },
+    { XmlTag::STEM_SLASH, "StemSlash" },
+    { XmlTag::STICKING, "Sticking" },
+    { XmlTag::STRING, "string" },
+    { XmlTag::SYMBOL, "Symbol" },
+    { XmlTag::SYSTEM_TEXT, "SystemText" },
+    { XmlTag::TEMPO, "Tempo" },
+    { XmlTag::TEXT, "Text" },
+    { XmlTag::TICK, "tick" },
+    { XmlTag::TICKLEN, "ticklen" },
+    { XmlTag::TICK_OFFSET, "tickOffset" },
+    { XmlTag::TIME_SIG, "TimeSig" },
+    { XmlTag::TPC, "tpc" },
+    { XmlTag::TPC2, "tpc2" },
+    { XmlTag::TRACK, "track" },
+    { XmlTag::TRAILING_SPACE, "trailingSpace" },
+    { XmlTag::TREMOLO, "Tremolo" },
+    { XmlTag::TREMOLO_BAR, "TremoloBar" },
+    { XmlTag::TUNING, "tuning" },
+    { XmlTag::TUPLET, "Tuplet" },
+    { XmlTag::VELOCITY, "velocity" },
+    { XmlTag::VELO_TYPE, "veloType" },
+};
+
+constexpr size_t TAG_COUNT = sizeof(xmlTagNames) / sizeof(xmlTagNames[0]);
+static_assert(TAG_COUNT == size_t(XmlTag::TAGS), "xmlTagNames does not match XmlTag");
+static_assert(TAG_COUNT < 256, "tag index does not fit into the hash table slots");
+
+constexpr bool isTableInEnumOrder()
+{
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        if (size_t(xmlTagNames[i].tag) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(isTableInEnumOrder(), "xmlTagNames must be in the order of XmlTag");
+
+//---------------------------------------------------------
+//   hashChar
+//    FNV-1a step on UTF-16 code units, so the compile time
+//    hash of the ASCII names matches the run time hash of
+//    the QString data
+//---------------------------------------------------------
+
+constexpr uint32_t hashChar(uint32_t hash, uint32_t c)
+{
+    return (hash ^ c) * 16777619u;
+}
+
+constexpr uint32_t hashName(const char* name, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    for (const char* c = name; *c; ++c) {
+        hash = hashChar(hash, uint32_t(static_cast<unsigned char>(*c)));
+    }
+    return hash;
+}
+
+//---------------------------------------------------------
+//   PerfectHash
+//    slot -> index into xmlTagNames, 0 for empty slots;
+//    the seed is searched at compile time so that no two
+//    tag names share a slot
+//---------------------------------------------------------
+
+constexpr uint32_t HASH_TABLE_SIZE = 4096;
+
+struct PerfectHash {
+    uint32_t seed;
+    std::array<unsigned char, HASH_TABLE_SIZE> slots;
+};
+
+constexpr PerfectHash makePerfectHash()
+{
+    for (uint32_t seed = 1; seed < 1000; ++seed) {
+        PerfectHash hash { seed, {} };
+        bool collision = false;
+        for (size_t i = 1; i < TAG_COUNT && !collision; ++i) {
+            const uint32_t slot = hashName(xmlTagNames[i].name, seed) % HASH_TABLE_SIZE;
+            if (hash.slots[slot]) {
+                collision = true;
+            } else {
+                hash.slots[slot] = static_cast<unsigned char>(i);
+            }
+        }
+        if (!collision) {
+            return hash;
+        }
+    }
+    return PerfectHash { 0, {} };
+}
+
+constexpr PerfectHash perfectHash = makePerfectHash();
+static_assert(perfectHash.seed != 0, "no perfect hash found for the xml tags, increase HASH_TABLE_SIZE");
+} // namespace
+
+//---------------------------------------------------------
+//   xmlTag
+//    XmlTag::UNKNOWN for the tags not in the table
+//---------------------------------------------------------
+
+XmlTag xmlTag(const QStringRef& name)
+{
+    uint32_t hash = 2166136261u ^ perfectHash.seed;
+    const QChar* data = name.constData();
+    const int size = name.size();
+    for (int i = 0; i < size; ++i) {
+        hash = hashChar(hash, data[i].unicode());
+    }
+
+    const unsigned char index = perfectHash.slots[hash % HASH_TABLE_SIZE];
+    if (!index) {
+        return XmlTag::UNKNOWN;
+    }
+    const XmlTagName& candidate = xmlTagNames[index];
+    return name == QLatin1String(candidate.name) ? candidate.tag : XmlTag::UNKNOWN;
+}
+
+//---------------------------------------------------------
+//   xmlTagName
+//---------------------------------------------------------
+
+const char* xmlTagName(XmlTag tag)
+{
+    return size_t(tag) < TAG_COUNT ? xmlTagNames[size_t(tag)].name : "";
+}
+} // namespace Ms
@@ -0,0 +1,133 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __XMLTAG_H__
+#define __XMLTAG_H__
+
+#include <QStringRef>
+
+namespace Ms {
+//---------------------------------------------------------
+//   XmlTag
+//    integer ids of the tags on the hot read paths,
+//    so element readers can switch on the tag instead
+//    of comparing strings one by one
+//---------------------------------------------------------
+
+enum class XmlTag : unsigned char {
+    UNKNOWN,
+    ACCIACCATURA,
+    ACCIDENTAL,
+    AMBITUS,
+    APPOGGIATURA,
+    ARPEGGIO,
+    ARTICULATION,
+    BAR_LINE,
+    BEAM,
+    BEAM_MODE,
+    BEND,
+    BREATH,
+    CHORD,
+    CHORD_LINE,
+    CLEF,
+    DOT_POSITION,
+    DOTS,
+    DURATION,
+    DURATION_TYPE,
+    DYNAMIC,
+    END_TUPLET,
+    EVENTS,
+    FERMATA,
+    FIGURED_BASS,
+    FINGERING,
+    FIXED,
+    FIXED_LINE,
+    FRET,
+    FRET_DIAGRAM,
+    GHOST,
+    GRACE16,
+    GRACE16AFTER,
+    GRACE32,
+    GRACE32AFTER,
+    GRACE4,
+    GRACE8AFTER,
+    HARMONY,
+    HEAD,
+    HEAD_SCHEME,
+    HEAD_TYPE,
+    HOOK,
+    IMAGE,
+    INSTRUMENT_CHANGE,
+    KEY_SIG,
+    LEADING_SPACE,
+    LINE,
+    LOCATION,
+    LYRICS,
+    MEASURE_REPEAT,
+    MIRROR,
+    NO_STEM,
+    NOTE,
+    NOTE_DOT,
+    OFFSET,
+    PITCH,
+    PLAY,
+    POS,
+    REHEARSAL_MARK,
+    REPEAT_MEASURE,
+    REST,
+    SEGMENT,
+    SMALL,
+    SPANNER,
+    STAFF_MOVE,
+    STAFF_STATE,
+    STAFF_TEXT,
+    STEM,
+    STEM_SLASH,
+    STICKING,
+    STRING,
+    SYMBOL,
+    SYSTEM_TEXT,
+    TEMPO,
+    TEXT,
+    TICK,
+    TICKLEN,
+    TICK_OFFSET,
+    TIME_SIG,
+    TPC,
+    TPC2,
+    TRACK,
+    TRAILING_SPACE,
+    TREMOLO,
+    TREMOLO_BAR,
+    TUNING,
+    TUPLET,
+    VELOCITY,
+    VELO_TYPE,
+
+    TAGS
+};
+
+extern XmlTag xmlTag(const QStringRef& name);
+extern const char* xmlTagName(XmlTag tag);
+} // namespace Ms
+
+#endif
@@ -60,9 +60,66 @@ void XmlWriter::pTag(const char* name, PlaceText place)
 
 void XmlWriter::putLevel()
 {
-    int level = stack.size();
-    for (int i = 0; i < level * 2; ++i) {
-        *this << ' ';
+    static const char spaces[] = "                                ";
+    const int chunk = int(sizeof(spaces)) - 1;
+    for (int n = stack.size() * 2; n > 0; n -= chunk) {
+        *this << QLatin1String(spaces, qMin(n, chunk));
+    }
+}
+
+//---------------------------------------------------------
+//   putName
+//    tag names are plain ascii, attribute values may not be
+//---------------------------------------------------------
+
+void XmlWriter::putName(const char* name, int len)
+{
+    for (int i = 0; i < len; ++i) {
+        if (static_cast<unsigned char>(name[i]) >= 0x80) {
+            *this << QString::fromUtf8(name, len);
+            return;
+        }
+    }
+    *this << QLatin1String(name, len);
+}
+
+//---------------------------------------------------------
+//   putStartTag
+//    <mops attribute="value"> without newline
+//---------------------------------------------------------
+
+void XmlWriter::putStartTag(const char* name)
+{
+    putLevel();
+    *this << '<';
+    putName(name, int(strlen(name)));
+    *this << '>';
+}
+
+//---------------------------------------------------------
+//   putEndTag
+//    </mops>
+//---------------------------------------------------------
+
+void XmlWriter::putEndTag(const char* name)
+{
+    const char* attributes = strchr(name, ' ');
+    *this << "</";
+    putName(name, attributes ? int(attributes - name) : int(strlen(name)));
+    *this << ">\n";
+}
+
+//---------------------------------------------------------
+//   endLine
+//    the stream is flushed only once the top level
+//    element is complete, not on every line
+//---------------------------------------------------------
+
+void XmlWriter::endLine()
+{
+    *this << '\n';
+    if (stack.isEmpty()) {
+        flush();
     }
 }
 
@@ -83,8 +140,8 @@ void XmlWriter::header()
 void XmlWriter::stag(const QString& s)
 {
     putLevel();
-    *this << '<' << s << '>' << Qt::endl;
-    stack.append(s.split(' ')[0]);
+    *this << '<' << s << ">\n";
+    stack.append(s.left(s.indexOf(' ')));
 }
 
 //---------------------------------------------------------
@@ -109,7 +166,7 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
     if (!attributes.isEmpty()) {
         *this << ' ' << attributes;
     }
-    *this << '>' << Qt::endl;
+    *this << ">\n";
     stack.append(name);
 
     if (_recordElements) {
@@ -125,7 +182,8 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
 void XmlWriter::etag()
 {
     putLevel();
-    *this << "</" << stack.takeLast() << '>' << Qt::endl;
+    *this << "</" << stack.takeLast() << '>';
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -143,7 +201,8 @@ void XmlWriter::tagE(const char* format, ...)
     vsnprintf(buffer, BS, format, args);
     *this << buffer;
     va_end(args);
-    *this << "/>" << Qt::endl;
+    *this << "/>";
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -174,7 +233,8 @@ void XmlWriter::ntag(const char* name)
 
 void XmlWriter::netag(const char* s)
 {
-    *this << "</" << s << '>' << Qt::endl;
+    *this << "</" << s << '>';
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -195,7 +255,7 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
     if (writableVal.isEmpty()) {
         tag(name, data);
     } else {
-        tag(name, QVariant(writableVal));
+        tag(name, writableVal);
     }
 }
 
@@ -206,14 +266,75 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
 
 void XmlWriter::tag(const char* name, QVariant data, QVariant defaultData)
 {
-    if (data != defaultData) {
+    if (data == defaultData) {
+        return;
+    }
+    switch (data.type()) {
+    case QVariant::Bool:
+    case QVariant::Char:
+    case QVariant::Int:
+    case QVariant::UInt:
+        intTag(name, data.toInt());
+        break;
+    case QVariant::LongLong:
+        intTag(name, data.toLongLong());
+        break;
+    case QVariant::Double:
+        realTag(name, data.value<double>());
+        break;
+    case QVariant::String:
+        tag(name, data.value<QString>());
+        break;
+    default:
         tag(QString(name), data);
+        break;
     }
 }
 
+//---------------------------------------------------------
+//   tag
+//    <mops>value</mops>
+//---------------------------------------------------------
+
+void XmlWriter::tag(const char* name, const QString& s)
+{
+    putStartTag(name);
+    *this << xmlString(s);
+    putEndTag(name);
+}
+
+void XmlWriter::tag(const char* name, const Fraction& f)
+{
+    putStartTag(name);
+    *this << f.numerator() << '/' << f.denominator();
+    putEndTag(name);
+}
+
+//---------------------------------------------------------
+//   intTag
+//---------------------------------------------------------
+
+void XmlWriter::intTag(const char* name, qint64 val)
+{
+    putStartTag(name);
+    *this << val;
+    putEndTag(name);
+}
+
+//---------------------------------------------------------
+//   realTag
+//---------------------------------------------------------
+
+void XmlWriter::realTag(const char* name, double val)
+{
+    putStartTag(name);
+    *this << val;
+    putEndTag(name);
+}
+
 void XmlWriter::tag(const QString& name, QVariant data)
 {
-    QString ename(name.split(' ')[0]);
+    QString ename(name.left(name.indexOf(' ')));
 
     putLevel();
     switch (data.type()) {
@@ -325,7 +446,8 @@ void XmlWriter::tag(const char* name, const QWidget* g)
 void XmlWriter::comment(const QString& text)
 {
     putLevel();
-    *this << "<!-- " << text << " -->" << Qt::endl;
+    *this << "<!-- " << text << " -->";
+    endLine();
 }
 
 //---------------------------------------------------------
@@ -358,9 +480,21 @@ QString XmlWriter::xmlString(ushort c)
 
 QString XmlWriter::xmlString(const QString& s)
 {
+    int i = 0;
+    for (; i < s.size(); ++i) {
+        ushort c = s.at(i).unicode();
+        if (c == '<' || c == '>' || c == '&' || c == '\"' || (c < 0x20 && c != 0x09 && c != 0x0A && c != 0x0D)) {
+            break;
+        }
+    }
+    if (i == s.size()) {
+        return s;               // nothing to escape, share the data
+    }
+
     QString escaped;
-    escaped.reserve(s.size());
-    for (int i = 0; i < s.size(); ++i) {
+    escaped.reserve(s.size() + 16);
+    escaped += s.leftRef(i);
+    for (; i < s.size(); ++i) {
         ushort c = s.at(i).unicode();
         escaped += xmlString(c);
     }
@@ -402,7 +536,7 @@ void XmlWriter::dump(int len, const unsigned char* p)
 
 void XmlWriter::writeXml(const QString& name, QString s)
 {
-    QString ename(name.split(' ')[0]);
+    QString ename(name.left(name.indexOf(' ')));
     putLevel();
     for (int i = 0; i < s.size(); ++i) {
         ushort c = s.at(i).unicode();
@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_ILAYOUTPROFILER_H
+#define MU_NOTATION_ILAYOUTPROFILER_H
+
+#include <QString>
+
+#include "modularity/imoduleexport.h"
+#include "ret.h"
+#include "io/path.h"
+
+namespace mu::notation {
+//! Timings of the layout stages of every layout pass, off by default
+class ILayoutProfiler : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(ILayoutProfiler)
+
+public:
+    virtual ~ILayoutProfiler() = default;
+
+    virtual bool isEnabled() const = 0;
+    virtual void setEnabled(bool enabled) = 0;
+
+    //! calls, total and max time per stage
+    virtual QString summary() const = 0;
+    //! the recorded calls as a Chrome trace (chrome://tracing, Perfetto)
+    virtual Ret writeTrace(const io::path& path) const = 0;
+};
+}
+
+#endif // MU_NOTATION_ILAYOUTPROFILER_H
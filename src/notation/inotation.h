@@ -56,6 +56,10 @@ public:
     virtual ViewMode viewMode() const = 0;
     virtual void paint(mu::draw::Painter* painter, const QRectF& frameRect) = 0;
 
+    //! paint() is paintPages() and then paintInteraction() (selection range, grips, shadow note...)
+    virtual void paintPages(mu::draw::Painter* painter, const QRectF& frameRect) = 0;
+    virtual void paintInteraction(mu::draw::Painter* painter) = 0;
+
     virtual ValCh<bool> opened() const = 0;
     virtual void setOpened(bool opened) = 0;
 
@@ -85,6 +89,9 @@ public:
 
     // notify
     virtual async::Notification notationChanged() const = 0;
+
+    //! area of the canvas changed by a command, an invalid rect means the whole canvas
+    virtual async::Channel<QRectF> canvasChanged() const = 0;
 };
 }
 
@@ -36,6 +36,8 @@ public:
     virtual ~INotationPlayback() = default;
 
     virtual std::shared_ptr<midi::MidiStream> midiStream() const = 0;
+    //! a new stream with all the chunks, it doesn't touch the stream of the playback
+    virtual std::shared_ptr<midi::MidiStream> exportMidiStream() const = 0;
 
     virtual QTime totalPlayTime() const = 0;
 
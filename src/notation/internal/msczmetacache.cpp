@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "msczmetacache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+static const quint32 CACHE_MAGIC = 0x4d4d4331;   // "MMC1"
+static const quint32 CACHE_VERSION = 1;
+
+static bool fileStamp(const io::path& filePath, qint64& size, qint64& lastModified)
+{
+    QFileInfo fileInfo(filePath.toQString());
+    if (!fileInfo.exists()) {
+        return false;
+    }
+
+    size = fileInfo.size();
+    lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+static QDataStream& operator<<(QDataStream& stream, const Meta& meta)
+{
+    stream << meta.fileName.toQString() << meta.title << meta.subtitle << meta.composer << meta.lyricist
+           << meta.copyright << meta.translator << meta.arranger << quint64(meta.partsCount)
+           << meta.creationDate << meta.thumbnail;
+    return stream;
+}
+
+static QDataStream& operator>>(QDataStream& stream, Meta& meta)
+{
+    QString fileName;
+    quint64 partsCount = 0;
+    stream >> fileName >> meta.title >> meta.subtitle >> meta.composer >> meta.lyricist
+    >> meta.copyright >> meta.translator >> meta.arranger >> partsCount
+    >> meta.creationDate >> meta.thumbnail;
+    meta.fileName = fileName;
+    meta.partsCount = partsCount;
+    return stream;
+}
+
+MsczMetaCache::MsczMetaCache(const io::path& cacheFilePath)
+    : m_cacheFilePath(cacheFilePath)
+{
+    load();
+}
+
+bool MsczMetaCache::find(const io::path& filePath, Meta& meta) const
+{
+    qint64 size = 0;
+    qint64 lastModified = 0;
+    if (!fileStamp(filePath, size, lastModified)) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_entries.constFind(filePath.toQString());
+    if (it == m_entries.constEnd() || it->size != size || it->lastModified != lastModified) {
+        return false;
+    }
+
+    meta = it->meta;
+    meta.filePath = filePath;
+    return true;
+}
+
+void MsczMetaCache::insert(const io::path& filePath, const Meta& meta)
+{
+    Entry entry;
+    if (!fileStamp(filePath, entry.size, entry.lastModified)) {
+        return;
+    }
+    entry.meta = meta;
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.insert(filePath.toQString(), entry);
+    m_changed = true;
+}
+
+void MsczMetaCache::load()
+{
+    QFile file(m_cacheFilePath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        LOGI() << "ignore score metadata cache of another version: " << m_cacheFilePath;
+        return;
+    }
+    stream.setVersion(QDataStream::Qt_5_9);
+
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        stream >> path >> entry.size >> entry.lastModified >> entry.meta;
+        m_entries.insert(path, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        LOGW() << "score metadata cache is corrupted: " << m_cacheFilePath;
+        m_entries.clear();
+    }
+}
+
+void MsczMetaCache::save()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_changed) {
+        return;
+    }
+
+    // entries of files that are gone are not worth keeping
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (QFileInfo::exists(it.key())) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+        }
+    }
+
+    QSaveFile file(m_cacheFilePath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed to save score metadata cache: " << m_cacheFilePath;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << CACHE_MAGIC << CACHE_VERSION;
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream << quint32(m_entries.size());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        stream << it.key() << it->size << it->lastModified << it->meta;
+    }
+
+    if (file.commit()) {
+        m_changed = false;
+    } else {
+        LOGE() << "failed to save score metadata cache: " << m_cacheFilePath;
+    }
+}
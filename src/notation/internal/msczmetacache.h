@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_MSCZMETACACHE_H
+#define MU_NOTATION_MSCZMETACACHE_H
+
+#include <QHash>
+#include <QMutex>
+
+#include "io/path.h"
+#include "notationtypes.h"
+
+namespace mu::notation {
+//! NOTE Score metadata read from the files, kept between sessions.
+//! An entry is valid as long as the size and the modification time of its file are unchanged.
+class MsczMetaCache
+{
+public:
+    explicit MsczMetaCache(const io::path& cacheFilePath);
+
+    bool find(const io::path& filePath, Meta& meta) const;
+    void insert(const io::path& filePath, const Meta& meta);
+
+    void save();
+
+private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 lastModified = 0;
+        Meta meta;
+    };
+
+    void load();
+
+    io::path m_cacheFilePath;
+    QHash<QString, Entry> m_entries;
+    bool m_changed = false;
+    mutable QMutex m_mutex;
+};
+}
+
+#endif // MU_NOTATION_MSCZMETACACHE_H
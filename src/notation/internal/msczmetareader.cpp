@@ -24,10 +24,12 @@
 #include <sstream>
 
 #include <QBuffer>
+#include <QtConcurrent>
 
 #include "log.h"
 #include "stringutils.h"
 #include "notationerrors.h"
+#include "msczmetacache.h"
 
 #include "thirdparty/qzip/qzipreader_p.h"
 
@@ -37,13 +39,57 @@ using namespace mu::notation;
 using namespace mu::framework;
 using namespace mu::system;
 
+static const std::string META_CACHE_FILE("/scoremetacache.dat");
+
+MsczMetaReader::MsczMetaReader() = default;
+
+MsczMetaReader::~MsczMetaReader() = default;
+
+MsczMetaCache* MsczMetaReader::cache() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+
+    if (!m_cache) {
+        //! NOTE Resolve the dependencies here, not concurrently from the readers
+        fileSystem();
+        m_cache = std::make_unique<MsczMetaCache>(globalConfiguration()->dataPath() + META_CACHE_FILE);
+    }
+
+    return m_cache.get();
+}
+
 MetaList MsczMetaReader::readMetaList(const io::paths& filePaths) const
 {
-    MetaList result;
+    MsczMetaCache* metaCache = cache();
+
+    std::vector<RetVal<Meta> > metas(filePaths.size());
+    std::vector<size_t> missing;
 
-    for (const io::path& path: filePaths) {
-        RetVal<Meta> meta = readMeta(path);
+    for (size_t i = 0; i < filePaths.size(); ++i) {
+        if (metaCache->find(filePaths[i], metas[i].val)) {
+            metas[i].ret = make_ret(Err::NoError);
+        } else {
+            missing.push_back(i);
+        }
+    }
+
+    QtConcurrent::blockingMap(missing, [this, &metas, &filePaths](size_t i) {
+        metas[i] = readMeta(filePaths[i]);
+    });
+
+    for (size_t i : missing) {
+        if (metas[i].ret) {
+            metaCache->insert(filePaths[i], metas[i].val);
+        }
+    }
+
+    if (!missing.empty()) {
+        metaCache->save();
+    }
+
+    MetaList result;
 
+    for (const RetVal<Meta>& meta : metas) {
         if (!meta.ret) {
             LOGE() << meta.ret.toString();
             continue;
@@ -358,16 +404,16 @@ io::path MsczMetaReader::readRootFile(MQZipReader* zipReader) const
     return rootFile;
 }
 
-QPixmap MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
+QImage MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
 {
     QByteArray thumbnailBuffer = zipReader->fileData("Thumbnails/thumbnail.png");
 
     if (thumbnailBuffer.isEmpty()) {
         LOGD() << "Can't find thumbnail";
-        return QPixmap();
+        return QImage();
     }
 
-    QPixmap thumbnail;
+    QImage thumbnail;
     thumbnail.loadFromData(thumbnailBuffer, "PNG");
 
     return thumbnail;
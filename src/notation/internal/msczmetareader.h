@@ -22,9 +22,14 @@
 #ifndef MU_NOTATION_MSCZMETAREADER_H
 #define MU_NOTATION_MSCZMETAREADER_H
 
+#include <memory>
+
+#include <QMutex>
+
 #include "imsczmetareader.h"
 
 #include "system/ifilesystem.h"
+#include "iglobalconfiguration.h"
 #include "modularity/ioc.h"
 
 namespace mu::framework {
@@ -34,14 +39,21 @@ class XmlReader;
 class MQZipReader;
 
 namespace mu::notation {
+class MsczMetaCache;
 class MsczMetaReader : public IMsczMetaReader
 {
     INJECT(notation, system::IFileSystem, fileSystem)
+    INJECT(notation, framework::IGlobalConfiguration, globalConfiguration)
 
 public:
+    MsczMetaReader();
+    ~MsczMetaReader() override;
+
+    //! NOTE Thread safe: the files missing from the cache are read on the global thread pool
     MetaList readMetaList(const io::paths& filePaths) const override;
 
 private:
+    MsczMetaCache* cache() const;
     RetVal<Meta> readMeta(const io::path& filePath) const;
 
     struct RawMeta {
@@ -74,7 +86,7 @@ private:
     RawMeta doReadBox(framework::XmlReader& xmlReader) const;
     RetVal<Meta> loadCompressedMsc(const io::path& filePath) const;
     io::path readRootFile(MQZipReader* zipReader) const;
-    QPixmap loadThumbnail(MQZipReader* zipReader) const;
+    QImage loadThumbnail(MQZipReader* zipReader) const;
     RawMeta doReadRawMeta(framework::XmlReader& xmlReader) const;
     QString formatFromXml(const std::string& xml) const;
 
@@ -85,6 +97,9 @@ private:
 
     QString readText(framework::XmlReader& xmlReader) const;
     QString readMetaTagText(framework::XmlReader& xmlReader) const;
+
+    mutable std::unique_ptr<MsczMetaCache> m_cache;
+    mutable QMutex m_cacheMutex;
 };
 }
 
@@ -38,6 +38,7 @@
 #include "notationaccessibility.h"
 #include "notationmidiinput.h"
 #include "notationparts.h"
+#include "scorecallbacks.h"
 
 using namespace mu::notation;
 
@@ -82,6 +83,7 @@ Notation::Notation(Ms::Score* score)
 {
     m_scoreGlobal = new Ms::MScore(); //! TODO May be static?
     m_opened.val = false;
+    m_scoreCallbacks = std::make_unique<ScoreCallbacks>();
 
     m_undoStack = std::make_shared<NotationUndoStack>(this, m_notationChanged);
     m_interaction = std::make_shared<NotationInteraction>(this, m_undoStack);
@@ -175,9 +177,15 @@ void Notation::init()
 
 void Notation::setScore(Ms::Score* score)
 {
+    if (m_score) {
+        m_score->removeViewer(m_scoreCallbacks.get());
+    }
+
     m_score = score;
 
     if (score) {
+        score->addViewer(m_scoreCallbacks.get());
+
         static_cast<NotationInteraction*>(m_interaction.get())->init();
         static_cast<NotationPlayback*>(m_playback.get())->init();
     }
@@ -270,6 +278,12 @@ ViewMode Notation::viewMode() const
 }
 
 void Notation::paint(mu::draw::Painter* painter, const QRectF& frameRect)
+{
+    paintPages(painter, frameRect);
+    paintInteraction(painter);
+}
+
+void Notation::paintPages(mu::draw::Painter* painter, const QRectF& frameRect)
 {
     const QList<Ms::Page*>& pages = score()->pages();
     if (pages.empty()) {
@@ -280,20 +294,23 @@ void Notation::paint(mu::draw::Painter* painter, const QRectF& frameRect)
     case Ms::LayoutMode::LINE:
     case Ms::LayoutMode::SYSTEM: {
         bool paintBorders = false;
-        paintPages(painter, frameRect, { pages.first() }, paintBorders);
+        paintPageList(painter, frameRect, { pages.first() }, paintBorders);
         break;
     }
     case Ms::LayoutMode::FLOAT:
     case Ms::LayoutMode::PAGE: {
         bool paintBorders = !score()->printing();
-        paintPages(painter, frameRect, pages, paintBorders);
+        paintPageList(painter, frameRect, pages, paintBorders);
     }
     }
+}
 
+void Notation::paintInteraction(mu::draw::Painter* painter)
+{
     static_cast<NotationInteraction*>(m_interaction.get())->paint(painter);
 }
 
-void Notation::paintPages(draw::Painter* painter, const QRectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const
+void Notation::paintPageList(draw::Painter* painter, const QRectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const
 {
     for (Ms::Page* page : pages) {
         QRectF pageRect(page->abbox().translated(page->pos()));
@@ -414,6 +431,11 @@ mu::async::Notification Notation::notationChanged() const
     return m_notationChanged;
 }
 
+mu::async::Channel<QRectF> Notation::canvasChanged() const
+{
+    return m_scoreCallbacks->canvasChanged();
+}
+
 INotationAccessibilityPtr Notation::accessibility() const
 {
     return m_accessibility;
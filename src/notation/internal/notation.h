@@ -35,6 +35,7 @@ class Score;
 }
 
 namespace mu::notation {
+class ScoreCallbacks;
 class NotationInteraction;
 class NotationPlayback;
 class Notation : virtual public INotation, public IGetScore, public async::Asyncable
@@ -56,6 +57,8 @@ public:
     void setViewMode(const ViewMode& viewMode) override;
     ViewMode viewMode() const override;
     void paint(draw::Painter* painter, const QRectF& frameRect) override;
+    void paintPages(draw::Painter* painter, const QRectF& frameRect) override;
+    void paintInteraction(draw::Painter* painter) override;
 
     ValCh<bool> opened() const override;
     void setOpened(bool opened) override;
@@ -70,6 +73,7 @@ public:
     INotationPartsPtr parts() const override;
 
     async::Notification notationChanged() const override;
+    async::Channel<QRectF> canvasChanged() const override;
 
 protected:
     Ms::Score* score() const override;
@@ -80,7 +84,7 @@ protected:
 private:
     friend class NotationInteraction;
 
-    void paintPages(mu::draw::Painter* painter, const QRectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const;
+    void paintPageList(mu::draw::Painter* painter, const QRectF& frameRect, const QList<Ms::Page*>& pages, bool paintBorders) const;
     void paintPageBorder(mu::draw::Painter* painter, const Ms::Page* page) const;
     void paintForeground(mu::draw::Painter* painter, const QRectF& pageRect) const;
 
@@ -101,6 +105,9 @@ private:
     INotationPartsPtr m_parts;
 
     async::Notification m_notationChanged;
+
+    //! NOTE Registered as the viewer of the score, reports the areas to repaint after each command
+    std::unique_ptr<ScoreCallbacks> m_scoreCallbacks;
 };
 }
 
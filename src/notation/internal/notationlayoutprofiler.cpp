@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationlayoutprofiler.h"
+
+#include "libmscore/layoutprofiler.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+bool NotationLayoutProfiler::isEnabled() const
+{
+    return Ms::LayoutProfiler::enabled();
+}
+
+void NotationLayoutProfiler::setEnabled(bool enabled)
+{
+    Ms::LayoutProfiler::setEnabled(enabled);
+}
+
+QString NotationLayoutProfiler::summary() const
+{
+    return Ms::LayoutProfiler::instance()->summary();
+}
+
+Ret NotationLayoutProfiler::writeTrace(const io::path& path) const
+{
+    if (!Ms::LayoutProfiler::instance()->writeChromeTrace(path.toQString())) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+    return make_ret(Ret::Code::Ok);
+}
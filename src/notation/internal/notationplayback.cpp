@@ -123,12 +123,47 @@ std::shared_ptr<MidiStream> NotationPlayback::midiStream() const
     midi::Chunk firstChunk;
     makeChunk(firstChunk, 0 /*fromTick*/);
     m_midiStream->initData.chunks.insert({ firstChunk.beginTick, std::move(firstChunk) });
+    m_midiStream->timeline.reset(m_midiStream->initData.chunks);
 
     m_midiStream->lastTick = score()->lastMeasure()->endTick().ticks();
 
     return m_midiStream;
 }
 
+std::shared_ptr<MidiStream> NotationPlayback::exportMidiStream() const
+{
+    if (!score()) {
+        return nullptr;
+    }
+
+    IF_ASSERT_FAILED(m_midiRenderer) {
+        return nullptr;
+    }
+
+    std::shared_ptr<MidiStream> stream = std::make_shared<MidiStream>();
+    m_midiRenderer->setScoreChanged();
+
+    makeInitData(stream->initData, score());
+    stream->lastTick = score()->lastMeasure()->endTick().ticks();
+
+    //! NOTE Nothing is requested during the export, all the chunks are made here
+    tick_t fromTick = 0;
+    while (fromTick < stream->lastTick) {
+        midi::Chunk chunk;
+        makeChunk(chunk, fromTick);
+        if (chunk.endTick <= fromTick) {
+            break;
+        }
+
+        fromTick = chunk.endTick;
+        stream->initData.chunks.insert({ chunk.beginTick, std::move(chunk) });
+    }
+
+    stream->timeline.reset(stream->initData.chunks);
+
+    return stream;
+}
+
 void NotationPlayback::makeInitData(MidiData& data, Ms::Score* score) const
 {
     data.division = Ms::MScore::division;
@@ -229,7 +264,7 @@ void NotationPlayback::onChunkRequest(tick_t tick)
 
     midi::Chunk chunk;
     makeChunk(chunk, tick);
-    m_midiStream->stream.send(chunk);
+    m_midiStream->sendChunk(chunk);
 }
 
 void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick) const
@@ -48,6 +48,7 @@ public:
     void init();
 
     std::shared_ptr<midi::MidiStream> midiStream() const override;
+    std::shared_ptr<midi::MidiStream> exportMidiStream() const override;
 
     QTime totalPlayTime() const override;
 
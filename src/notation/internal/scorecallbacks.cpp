@@ -25,14 +25,14 @@
 
 using namespace mu::notation;
 
-void ScoreCallbacks::dataChanged(const QRectF&)
+void ScoreCallbacks::dataChanged(const QRectF& rect)
 {
-    NOT_IMPLEMENTED;
+    m_canvasChanged.send(rect);
 }
 
 void ScoreCallbacks::updateAll()
 {
-    NOT_IMPLEMENTED;
+    m_canvasChanged.send(QRectF());
 }
 
 void ScoreCallbacks::drawBackground(draw::Painter*, const QRectF&) const
@@ -40,6 +40,11 @@ void ScoreCallbacks::drawBackground(draw::Painter*, const QRectF&) const
     NOT_IMPLEMENTED;
 }
 
+mu::async::Channel<QRectF> ScoreCallbacks::canvasChanged() const
+{
+    return m_canvasChanged;
+}
+
 const QRect ScoreCallbacks::geometry() const
 {
     NOT_IMPLEMENTED;
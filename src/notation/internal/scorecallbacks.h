@@ -22,10 +22,13 @@
 #ifndef MU_NOTATION_SCORECALLBACKS_H
 #define MU_NOTATION_SCORECALLBACKS_H
 
+#include <QRectF>
+
 #include "libmscore/mscoreview.h"
 #include "libmscore/musescoreCore.h"
 
-class QRectF;
+#include "async/channel.h"
+
 class QRect;
 
 namespace mu::notation {
@@ -34,10 +37,15 @@ class ScoreCallbacks : public Ms::MuseScoreView, public Ms::MuseScoreCore
 public:
     ScoreCallbacks() = default;
 
-    void dataChanged(const QRectF&) override;
+    void dataChanged(const QRectF& rect) override;
     void updateAll() override;
     void drawBackground(mu::draw::Painter*, const QRectF&) const override;
     const QRect geometry() const override;
+
+    async::Channel<QRectF> canvasChanged() const;
+
+private:
+    async::Channel<QRectF> m_canvasChanged;
 };
 }
 
@@ -28,6 +28,7 @@
 #include "ui/iuiactionsregister.h"
 
 #include "internal/notationcreator.h"
+#include "internal/notationlayoutprofiler.h"
 #include "internal/notation.h"
 #include "internal/notationactioncontroller.h"
 #include "internal/notationconfiguration.h"
@@ -91,6 +92,7 @@ std::string NotationModule::moduleName() const
 void NotationModule::registerExports()
 {
     ioc()->registerExport<INotationCreator>(moduleName(), new NotationCreator());
+    ioc()->registerExport<ILayoutProfiler>(moduleName(), new NotationLayoutProfiler());
     ioc()->registerExport<INotationConfiguration>(moduleName(), s_configuration);
     ioc()->registerExport<IMsczMetaReader>(moduleName(), new MsczMetaReader());
     ioc()->registerExport<INotationContextMenu>(moduleName(), new NotationContextMenu());
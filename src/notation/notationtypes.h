@@ -23,6 +23,7 @@
 #define MU_NOTATION_NOTATIONTYPES_H
 
 #include <QPixmap>
+#include <QImage>
 #include <QDate>
 
 #include "io/path.h"
@@ -236,7 +237,7 @@ struct Meta
     QString translator;
     QString arranger;
     size_t partsCount = 0;
-    QPixmap thumbnail;
+    QImage thumbnail;
     QDate creationDate;
 
     QString source;
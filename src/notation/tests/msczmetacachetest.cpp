@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "notation/internal/msczmetacache.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+class MsczMetaCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        m_cacheFile = m_dir.filePath("metacache.dat");
+        m_scoreFile = m_dir.filePath("score.mscz");
+        writeScore("score");
+    }
+
+    void writeScore(const QByteArray& data)
+    {
+        QFile file(m_scoreFile.toQString());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(data);
+    }
+
+    Meta createMeta() const
+    {
+        Meta meta;
+        meta.fileName = "score";
+        meta.title = "Title";
+        meta.composer = "Composer";
+        meta.partsCount = 3;
+        meta.creationDate = QDate(2020, 1, 2);
+        meta.thumbnail = QImage(4, 4, QImage::Format_ARGB32);
+        meta.thumbnail.fill(Qt::red);
+        return meta;
+    }
+
+    QTemporaryDir m_dir;
+    io::path m_cacheFile;
+    io::path m_scoreFile;
+};
+
+TEST_F(MsczMetaCacheTests, FindInserted)
+{
+    MsczMetaCache cache(m_cacheFile);
+
+    Meta meta;
+    EXPECT_FALSE(cache.find(m_scoreFile, meta));
+
+    cache.insert(m_scoreFile, createMeta());
+    ASSERT_TRUE(cache.find(m_scoreFile, meta));
+
+    EXPECT_EQ(meta.title, "Title");
+    EXPECT_EQ(meta.filePath, m_scoreFile);
+}
+
+TEST_F(MsczMetaCacheTests, Persistent)
+{
+    {
+        MsczMetaCache cache(m_cacheFile);
+        cache.insert(m_scoreFile, createMeta());
+        cache.save();
+    }
+
+    MsczMetaCache cache(m_cacheFile);
+    Meta meta;
+    ASSERT_TRUE(cache.find(m_scoreFile, meta));
+
+    Meta expected = createMeta();
+    EXPECT_EQ(meta.fileName, expected.fileName);
+    EXPECT_EQ(meta.title, expected.title);
+    EXPECT_EQ(meta.composer, expected.composer);
+    EXPECT_EQ(meta.partsCount, expected.partsCount);
+    EXPECT_EQ(meta.creationDate, expected.creationDate);
+    EXPECT_EQ(meta.thumbnail.size(), expected.thumbnail.size());
+    EXPECT_EQ(meta.thumbnail.pixel(0, 0), expected.thumbnail.pixel(0, 0));
+}
+
+TEST_F(MsczMetaCacheTests, ChangedFileIsMissing)
+{
+    MsczMetaCache cache(m_cacheFile);
+    cache.insert(m_scoreFile, createMeta());
+
+    // [WHEN] The size of the score changes
+    writeScore("changed score");
+
+    // [THEN] The cached metadata is out of date
+    Meta meta;
+    EXPECT_FALSE(cache.find(m_scoreFile, meta));
+}
+
+TEST_F(MsczMetaCacheTests, CorruptedCacheIsIgnored)
+{
+    QFile file(m_cacheFile.toQString());
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("garbage");
+    file.close();
+
+    MsczMetaCache cache(m_cacheFile);
+    Meta meta;
+    EXPECT_FALSE(cache.find(m_scoreFile, meta));
+}
@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QImage>
+#include <QPainter>
+
+#include "notation/view/notationtilecache.h"
+#include "libmscore/draw/painter.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+static constexpr int TILE_SIZE = NotationTileCache::TILE_SIZE;
+
+class NotationTileCacheTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_image = QImage(VIEW_SIZE, VIEW_SIZE, QImage::Format_ARGB32_Premultiplied);
+    }
+
+    //! NOTE Paints the view and returns the logical rects of the tiles rendered for it
+    QList<QRectF> paint(const QTransform& matrix)
+    {
+        QList<QRectF> rendered;
+
+        QPainter qp(&m_image);
+        draw::Painter painter(&qp, "notationtilecache_test");
+
+        m_cache.paint(&painter, matrix, QRectF(0, 0, VIEW_SIZE, VIEW_SIZE), [&rendered](draw::Painter*, const QRectF& logicRect) {
+            rendered << logicRect;
+        });
+
+        return rendered;
+    }
+
+    static constexpr int VIEW_SIZE = 2 * TILE_SIZE;
+    static constexpr int VIEW_TILE_COUNT = 4;
+
+    NotationTileCache m_cache;
+    QImage m_image;
+};
+
+TEST_F(NotationTileCacheTests, Paint_RendersOnlyVisibleTilesOnce)
+{
+    //! WHEN The view is painted twice with the same transform
+    QList<QRectF> first = paint(QTransform());
+    QList<QRectF> second = paint(QTransform());
+
+    //! THEN Only the visible tiles are rendered, and only the first time
+    EXPECT_EQ(first.size(), VIEW_TILE_COUNT);
+    EXPECT_TRUE(second.isEmpty());
+    EXPECT_EQ(m_cache.tileCount(), VIEW_TILE_COUNT);
+}
+
+TEST_F(NotationTileCacheTests, Paint_Scroll_RendersOnlyUncoveredTiles)
+{
+    //! GIVEN The view was painted
+    paint(QTransform());
+
+    //! WHEN The view is scrolled by half a tile to the left
+    QList<QRectF> scrolled = paint(QTransform::fromTranslate(-TILE_SIZE / 2, 0));
+
+    //! THEN Only the newly uncovered column is rendered
+    ASSERT_EQ(scrolled.size(), 2);
+    for (const QRectF& rect : scrolled) {
+        EXPECT_EQ(rect.left(), 2 * TILE_SIZE);
+    }
+
+    //! WHEN The view is scrolled back
+    QList<QRectF> back = paint(QTransform());
+
+    //! THEN Nothing is rendered
+    EXPECT_TRUE(back.isEmpty());
+}
+
+TEST_F(NotationTileCacheTests, Paint_ZoomBack_ReusesTiles)
+{
+    //! GIVEN The view was painted at 100% and then at 200%
+    paint(QTransform());
+    QList<QRectF> zoomed = paint(QTransform::fromScale(2, 2));
+    EXPECT_EQ(zoomed.size(), VIEW_TILE_COUNT);
+
+    //! WHEN Zooming back to 100% and to 200% again
+    QList<QRectF> unzoomed = paint(QTransform());
+    QList<QRectF> rezoomed = paint(QTransform::fromScale(2, 2));
+
+    //! THEN The tiles of both zoom levels are reused
+    EXPECT_TRUE(unzoomed.isEmpty());
+    EXPECT_TRUE(rezoomed.isEmpty());
+}
+
+TEST_F(NotationTileCacheTests, Invalidate_RendersOnlyTilesInChangedRect)
+{
+    //! GIVEN The view was painted at 200%
+    QTransform matrix = QTransform::fromScale(2, 2);
+    paint(matrix);
+
+    //! WHEN A rect inside the bottom right tile changes (as sent by canvasChanged)
+    QRectF changed(TILE_SIZE / 2 + 10, TILE_SIZE / 2 + 10, 20, 20);
+    m_cache.invalidate(changed);
+
+    QList<QRectF> rendered = paint(matrix);
+
+    //! THEN Only that tile is rendered again
+    ASSERT_EQ(rendered.size(), 1);
+    EXPECT_TRUE(rendered.first().contains(changed));
+}
+
+TEST_F(NotationTileCacheTests, Invalidate_InvalidRect_DropsAllTiles)
+{
+    //! GIVEN The view was painted
+    paint(QTransform());
+
+    //! WHEN An invalid rect is sent
+    m_cache.invalidate(QRectF());
+
+    //! THEN All tiles are dropped
+    EXPECT_EQ(m_cache.tileCount(), 0);
+    EXPECT_EQ(m_cache.cacheBytes(), 0);
+    EXPECT_EQ(paint(QTransform()).size(), VIEW_TILE_COUNT);
+}
+
+TEST_F(NotationTileCacheTests, ByteBudget_EvictsLeastRecentlyUsedTiles)
+{
+    //! GIVEN The cache fits the visible tiles plus two more
+    paint(QTransform());
+    qint64 tileBytes = m_cache.cacheBytes() / VIEW_TILE_COUNT;
+    m_cache.setByteBudget((VIEW_TILE_COUNT + 2) * tileBytes);
+
+    //! WHEN Scrolling one tile down and then one more
+    paint(QTransform::fromTranslate(0, -TILE_SIZE));
+    paint(QTransform::fromTranslate(0, -2 * TILE_SIZE));
+
+    //! THEN The budget holds, and the first row, used least recently, was dropped
+    EXPECT_LE(m_cache.cacheBytes(), m_cache.byteBudget());
+    EXPECT_EQ(m_cache.tileCount(), VIEW_TILE_COUNT + 2);
+
+    EXPECT_TRUE(paint(QTransform::fromTranslate(0, -2 * TILE_SIZE)).isEmpty());
+    EXPECT_TRUE(paint(QTransform::fromTranslate(0, -TILE_SIZE)).isEmpty());
+    EXPECT_EQ(paint(QTransform()).size(), 2);
+}
+
+TEST_F(NotationTileCacheTests, ByteBudget_KeepsVisibleTiles)
+{
+    //! GIVEN The budget is smaller than the visible area
+    m_cache.setByteBudget(1);
+
+    //! WHEN The view is painted twice
+    paint(QTransform());
+    QList<QRectF> second = paint(QTransform());
+
+    //! THEN The visible tiles are still served from the cache
+    EXPECT_TRUE(second.isEmpty());
+    EXPECT_EQ(m_cache.tileCount(), VIEW_TILE_COUNT);
+}
+
+TEST_F(NotationTileCacheTests, DeviceAlignedTransform_SnapsTranslationToDevicePixels)
+{
+    QTransform matrix(1.5, 0, 0, 1.5, 10.3, -4.6);
+
+    QTransform aligned = NotationTileCache::deviceAlignedTransform(matrix, 2.0);
+
+    EXPECT_DOUBLE_EQ(aligned.m11(), 1.5);
+    EXPECT_DOUBLE_EQ(aligned.m22(), 1.5);
+    EXPECT_DOUBLE_EQ(aligned.m31(), 10.5);
+    EXPECT_DOUBLE_EQ(aligned.m32(), -4.5);
+}
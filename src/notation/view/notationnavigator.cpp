@@ -37,7 +37,7 @@ void NotationNavigator::load()
     initVisible();
 
     uiConfiguration()->currentThemeChanged().onNotify(this, [this]() {
-        update();
+        redraw();
     });
 
     NotationPaintView::load();
@@ -68,7 +68,7 @@ NotationPaintView::NotationPaintView(QQuickItem* parent)
 
     //! NOTE For Autobot tests tool
     dispatcher()->reg(this, "dev-notationview-redraw", [this]() {
-        update();
+        redraw();
     });
 }
 
@@ -91,7 +91,7 @@ void NotationPaintView::load()
     });
 
     configuration()->foregroundChanged().onNotify(this, [this]() {
-        update();
+        redraw();
     });
 
     initBackground();
@@ -106,7 +106,7 @@ void NotationPaintView::initBackground()
 
     configuration()->backgroundChanged().onNotify(this, [this]() {
         emit backgroundColorChanged(configuration()->backgroundColor());
-        update();
+        redraw();
     });
 }
 
@@ -180,19 +180,35 @@ void NotationPaintView::onCurrentNotationChanged()
 
     if (m_notation) {
         m_notation->notationChanged().resetOnNotify(this);
+        m_notation->canvasChanged().resetOnReceive(this);
         INotationInteractionPtr interaction = m_notation->interaction();
         interaction->noteInput()->stateChanged().resetOnNotify(this);
         interaction->selectionChanged().resetOnNotify(this);
     }
 
     m_notation = globalContext()->currentNotation();
+    m_tileCache.invalidateAll();
+    m_canvasChangedReceived = false;
+
     if (!m_notation) {
         return;
     }
 
     onViewSizeChanged(); //! NOTE Set view size to notation
 
+    m_notation->canvasChanged().onReceive(this, [this](const QRectF& rect) {
+        m_tileCache.invalidate(rect);
+        m_canvasChangedReceived = true;
+    });
+
     m_notation->notationChanged().onNotify(this, [this]() {
+        //! NOTE Not every change goes through the score update,
+        //! in that case we don't know what has changed
+        if (!m_canvasChangedReceived) {
+            m_tileCache.invalidateAll();
+        }
+
+        m_canvasChangedReceived = false;
         update();
     });
 
@@ -306,6 +322,9 @@ void NotationPaintView::onNoteInputChanged()
 
 void NotationPaintView::onSelectionChanged()
 {
+    //! NOTE Selected elements are painted in the selection color
+    redraw();
+
     if (notationSelection()->isNone()) {
         return;
     }
@@ -358,9 +377,16 @@ void NotationPaintView::paint(QPainter* qp)
     QRect rect(0, 0, width(), height());
     paintBackground(rect, painter);
 
-    painter->setWorldTransform(m_matrix);
+    m_tileCache.paint(painter, m_matrix, rect, [this](draw::Painter* tilePainter, const QRectF& logicRect) {
+        notation()->paintPages(tilePainter, logicRect);
+    });
+
+    m_canvasChangedReceived = false;
 
-    notation()->paint(painter, toLogical(rect));
+    qreal dpr = qp->device() ? qp->device()->devicePixelRatioF() : 1.0;
+    painter->setWorldTransform(NotationTileCache::deviceAlignedTransform(m_matrix, dpr));
+
+    notation()->paintInteraction(painter);
 
     m_playbackCursor->paint(painter);
     m_noteInputCursor->paint(painter);
@@ -368,6 +394,12 @@ void NotationPaintView::paint(QPainter* qp)
     m_loopOutMarker->paint(painter);
 }
 
+void NotationPaintView::redraw()
+{
+    m_tileCache.invalidateAll();
+    update();
+}
+
 void NotationPaintView::paintBackground(const QRect& rect, mu::draw::Painter* painter)
 {
     QString wallpaperPath = configuration()->backgroundWallpaperPath().toQString();
@@ -724,7 +756,7 @@ void NotationPaintView::setNotation(INotationPtr notation)
     clear();
     initBackground();
     m_notation = notation;
-    update();
+    redraw();
 }
 
 void NotationPaintView::setReadonly(bool readonly)
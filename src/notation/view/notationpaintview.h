@@ -39,6 +39,7 @@
 #include "noteinputcursor.h"
 #include "playbackcursor.h"
 #include "loopmarker.h"
+#include "notationtilecache.h"
 
 namespace mu::notation {
 class NotationPaintView : public QQuickPaintedItem, public IControlledView, public async::Asyncable, public actions::Actionable
@@ -123,6 +124,7 @@ protected:
 
     // Draw
     void paint(QPainter* painter) override;
+    void redraw();
 
 protected slots:
     virtual void onViewSizeChanged();
@@ -189,6 +191,9 @@ private:
     std::unique_ptr<LoopMarker> m_loopInMarker;
     std::unique_ptr<LoopMarker> m_loopOutMarker;
 
+    NotationTileCache m_tileCache;
+    bool m_canvasChangedReceived = false;
+
     qreal m_previousVerticalScrollPosition = 0;
     qreal m_previousHorizontalScrollPosition = 0;
 };
@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtilecache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QPainter>
+
+#include "libmscore/draw/painter.h"
+
+#include "log.h"
+
+using namespace mu::notation;
+
+QTransform NotationTileCache::deviceAlignedTransform(const QTransform& matrix, qreal devicePixelRatio)
+{
+    if (qFuzzyIsNull(devicePixelRatio)) {
+        return matrix;
+    }
+
+    qreal dx = std::round(matrix.m31() * devicePixelRatio) / devicePixelRatio;
+    qreal dy = std::round(matrix.m32() * devicePixelRatio) / devicePixelRatio;
+
+    return QTransform(matrix.m11(), matrix.m12(), matrix.m13(),
+                      matrix.m21(), matrix.m22(), matrix.m23(),
+                      dx, dy, matrix.m33());
+}
+
+QRectF NotationTileCache::tileLogicRect(const TileKey& key)
+{
+    qreal size = TILE_SIZE / key.scale;
+    return QRectF(key.column * size, key.row * size, size, size);
+}
+
+void NotationTileCache::paint(draw::Painter* painter, const QTransform& matrix, const QRectF& viewRect, const RenderFunc& render)
+{
+    TRACEFUNC;
+
+    IF_ASSERT_FAILED(painter && render) {
+        return;
+    }
+
+    qreal scale = matrix.m11();
+    qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+
+    if (qFuzzyIsNull(scale)) {
+        return;
+    }
+
+    ++m_paintCounter;
+
+    //! NOTE Tiles live in "zoomed canvas" coordinates, i.e. logical * scale,
+    //! which differ from the view coordinates only by the scroll offset
+    QTransform aligned = deviceAlignedTransform(matrix, dpr);
+    QPointF offset(aligned.m31(), aligned.m32());
+    QRectF canvasRect = viewRect.translated(-offset);
+
+    //! NOTE The right and bottom edges are exclusive
+    int firstColumn = static_cast<int>(std::floor(canvasRect.left() / TILE_SIZE));
+    int lastColumn = std::max(firstColumn, static_cast<int>(std::ceil(canvasRect.right() / TILE_SIZE)) - 1);
+    int firstRow = static_cast<int>(std::floor(canvasRect.top() / TILE_SIZE));
+    int lastRow = std::max(firstRow, static_cast<int>(std::ceil(canvasRect.bottom() / TILE_SIZE)) - 1);
+
+    painter->save();
+    painter->setWorldTransform(QTransform());
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            TileKey key { column, row, scale, dpr };
+
+            auto it = m_tiles.find(key);
+            if (it == m_tiles.end()) {
+                Tile tile = renderTile(key, render);
+                m_cacheBytes += tile.bytes;
+                it = m_tiles.insert(key, tile);
+            }
+
+            it->lastUsed = m_paintCounter;
+            painter->drawPixmap(QPointF(column * TILE_SIZE, row * TILE_SIZE) + offset, it->pixmap);
+        }
+    }
+
+    painter->restore();
+
+    evictTiles();
+}
+
+NotationTileCache::Tile NotationTileCache::renderTile(const TileKey& key, const RenderFunc& render) const
+{
+    Tile tile;
+    tile.pixmap = QPixmap(std::ceil(TILE_SIZE * key.devicePixelRatio), std::ceil(TILE_SIZE * key.devicePixelRatio));
+    tile.pixmap.setDevicePixelRatio(key.devicePixelRatio);
+    tile.pixmap.fill(Qt::transparent);
+    tile.bytes = static_cast<qint64>(tile.pixmap.width()) * tile.pixmap.height() * tile.pixmap.depth() / 8;
+
+    QPainter qp(&tile.pixmap);
+    qp.setRenderHint(QPainter::Antialiasing, true);
+    qp.setRenderHint(QPainter::TextAntialiasing, true);
+
+    draw::Painter painter(&qp, "notationview_tile");
+    painter.setWorldTransform(QTransform(key.scale, 0, 0, key.scale, -key.column * TILE_SIZE, -key.row * TILE_SIZE));
+
+    render(&painter, tileLogicRect(key));
+
+    return tile;
+}
+
+void NotationTileCache::evictTiles()
+{
+    if (m_cacheBytes <= m_byteBudget) {
+        return;
+    }
+
+    //! NOTE Tiles drawn by the current paint are never dropped,
+    //! so the visible area is always served from the cache
+    std::vector<std::pair<quint64, TileKey> > candidates;
+    for (auto it = m_tiles.cbegin(); it != m_tiles.cend(); ++it) {
+        if (it->lastUsed != m_paintCounter) {
+            candidates.emplace_back(it->lastUsed, it.key());
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    for (const auto& candidate : candidates) {
+        if (m_cacheBytes <= m_byteBudget) {
+            break;
+        }
+
+        auto it = m_tiles.find(candidate.second);
+        m_cacheBytes -= it->bytes;
+        m_tiles.erase(it);
+    }
+}
+
+void NotationTileCache::invalidate(const QRectF& logicRect)
+{
+    if (!logicRect.isValid()) {
+        invalidateAll();
+        return;
+    }
+
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        //! NOTE Antialiasing may touch one pixel around the changed area
+        qreal margin = 1.0 / it.key().scale;
+        QRectF rect = logicRect.adjusted(-margin, -margin, margin, margin);
+
+        if (tileLogicRect(it.key()).intersects(rect)) {
+            m_cacheBytes -= it->bytes;
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NotationTileCache::invalidateAll()
+{
+    m_tiles.clear();
+    m_cacheBytes = 0;
+}
+
+qint64 NotationTileCache::byteBudget() const
+{
+    return m_byteBudget;
+}
+
+void NotationTileCache::setByteBudget(qint64 bytes)
+{
+    m_byteBudget = bytes;
+    evictTiles();
+}
+
+int NotationTileCache::tileCount() const
+{
+    return m_tiles.size();
+}
+
+qint64 NotationTileCache::cacheBytes() const
+{
+    return m_cacheBytes;
+}
@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONTILECACHE_H
+#define MU_NOTATION_NOTATIONTILECACHE_H
+
+#include <functional>
+
+#include <QHash>
+#include <QPixmap>
+#include <QRectF>
+#include <QTransform>
+
+namespace mu::draw {
+class Painter;
+}
+
+namespace mu::notation {
+//! NOTE Keeps the rendered score in fixed size pixmap tiles anchored to the canvas,
+//! so scrolling and overlay updates (cursors, loop markers) only blit the tiles.
+//! Tiles are kept per zoom and device pixel ratio, so zooming back reuses them too;
+//! the least recently used tiles are dropped once the cache exceeds its byte budget.
+class NotationTileCache
+{
+public:
+    using RenderFunc = std::function<void (draw::Painter* painter, const QRectF& logicRect)>;
+
+    static constexpr int TILE_SIZE = 256;
+
+    //! NOTE The view transform with the translation snapped to device pixels.
+    //! Tiles are drawn at this offset, so overlays have to be drawn with it too
+    static QTransform deviceAlignedTransform(const QTransform& matrix, qreal devicePixelRatio);
+
+    void paint(draw::Painter* painter, const QTransform& matrix, const QRectF& viewRect, const RenderFunc& render);
+
+    void invalidate(const QRectF& logicRect);
+    void invalidateAll();
+
+    qint64 byteBudget() const;
+    void setByteBudget(qint64 bytes);
+
+    int tileCount() const;
+    qint64 cacheBytes() const;
+
+private:
+    struct TileKey {
+        int column = 0;
+        int row = 0;
+        qreal scale = 0;
+        qreal devicePixelRatio = 0;
+
+        bool operator==(const TileKey& other) const
+        {
+            return column == other.column && row == other.row
+                   && scale == other.scale && devicePixelRatio == other.devicePixelRatio;
+        }
+
+        friend uint qHash(const TileKey& key, uint seed = 0)
+        {
+            return ::qHash(key.column, seed) ^ ::qHash(key.row, seed * 31 + 1)
+                   ^ ::qHash(key.scale, seed) ^ ::qHash(key.devicePixelRatio, seed);
+        }
+    };
+
+    struct Tile {
+        QPixmap pixmap;
+        qint64 bytes = 0;
+        quint64 lastUsed = 0;
+    };
+
+    static QRectF tileLogicRect(const TileKey& key);
+
+    Tile renderTile(const TileKey& key, const RenderFunc& render) const;
+    void evictTiles();
+
+    QHash<TileKey, Tile> m_tiles;
+    qint64 m_cacheBytes = 0;
+    qint64 m_byteBudget = 64 * 1024 * 1024;
+    quint64 m_paintCounter = 0;
+};
+}
+
+#endif // MU_NOTATION_NOTATIONTILECACHE_H
@@ -29,6 +29,16 @@ unsigned int AudioConfigurationStub::driverBufferSize() const
     return 0;
 }
 
+unsigned int AudioConfigurationStub::mixerRenderThreadCount() const
+{
+    return 0;
+}
+
+unsigned int AudioConfigurationStub::zerberusSamplePreload() const
+{
+    return 0;
+}
+
 std::vector<io::path> AudioConfigurationStub::soundFontPaths() const
 {
     return {};
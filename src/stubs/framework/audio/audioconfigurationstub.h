@@ -29,6 +29,8 @@ class AudioConfigurationStub : public IAudioConfiguration
 {
 public:
     unsigned int driverBufferSize() const override;
+    unsigned int mixerRenderThreadCount() const override;
+    unsigned int zerberusSamplePreload() const override;
 
     std::vector<io::path> soundFontPaths() const override;
     const synth::SynthesizerState& synthesizerState() const override;
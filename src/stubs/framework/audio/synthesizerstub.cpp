@@ -102,6 +102,14 @@ bool SynthesizerStub::handleEvent(const midi::Event&)
     return false;
 }
 
+void SynthesizerStub::scheduleEvent(const midi::Event&, unsigned int)
+{
+}
+
+void SynthesizerStub::clearScheduledEvents()
+{
+}
+
 void SynthesizerStub::writeBuf(float*, unsigned int)
 {
 }
@@ -56,6 +56,8 @@ public:
 
     Ret setupChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    void scheduleEvent(const midi::Event& e, unsigned int sampleOffset) override;
+    void clearScheduledEvents() override;
     void writeBuf(float* stream, unsigned int samples) override;
 
     void allSoundsOff() override;
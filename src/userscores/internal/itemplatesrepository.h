@@ -28,6 +28,7 @@
 #include "notation/notationtypes.h"
 
 #include "retval.h"
+#include "async/channel.h"
 
 namespace mu::userscores {
 class ITemplatesRepository : MODULE_EXPORT_INTERFACE
@@ -38,6 +39,9 @@ public:
     virtual ~ITemplatesRepository() = default;
 
     virtual RetVal<Templates> templates() const = 0;
+
+    //! NOTE The templates are read on the global thread pool and sent to the channel when ready
+    virtual void templatesAsync(async::Channel<Templates> result) const = 0;
 };
 }
 
@@ -22,6 +22,8 @@
 
 #include "templatesrepository.h"
 
+#include <QtConcurrent>
+
 #include "log.h"
 
 #include "io/path.h"
@@ -32,10 +34,28 @@ using namespace mu::userscores;
 using namespace mu::framework;
 
 RetVal<Templates> TemplatesRepository::templates() const
+{
+    return RetVal<Templates>::make_ok(scanTemplates(configuration()->availableTemplatesPaths()));
+}
+
+void TemplatesRepository::templatesAsync(async::Channel<Templates> result) const
+{
+    io::paths dirPaths = configuration()->availableTemplatesPaths();
+
+    //! NOTE Resolve the dependencies here, not from the thread pool
+    fileSystem();
+    msczReader();
+
+    QtConcurrent::run([this, dirPaths, result]() mutable {
+        result.send(scanTemplates(dirPaths));
+    });
+}
+
+Templates TemplatesRepository::scanTemplates(const io::paths& dirPaths) const
 {
     Templates result;
 
-    for (const io::path& dirPath: configuration()->availableTemplatesPaths()) {
+    for (const io::path& dirPath: dirPaths) {
         QStringList filters { "*.mscz", "*.mscx" };
         RetVal<io::paths> files = fileSystem()->scanFiles(dirPath, filters);
 
@@ -47,7 +67,7 @@ RetVal<Templates> TemplatesRepository::templates() const
         result << loadTemplates(files.val);
     }
 
-    return RetVal<Templates>::make_ok(result);
+    return result;
 }
 
 Templates TemplatesRepository::loadTemplates(const io::paths& filePaths) const
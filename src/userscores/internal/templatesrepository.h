@@ -39,8 +39,10 @@ class TemplatesRepository : public ITemplatesRepository
 
 public:
     RetVal<Templates> templates() const override;
+    void templatesAsync(async::Channel<Templates> result) const override;
 
 private:
+    Templates scanTemplates(const io::paths& dirPaths) const;
     Templates loadTemplates(const io::paths& filePaths) const;
     QString correctedTitle(const QString& title) const;
 };
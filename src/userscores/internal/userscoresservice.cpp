@@ -21,6 +21,8 @@
  */
 #include "userscoresservice.h"
 
+#include <QtConcurrent>
+
 #include "log.h"
 #include "settings.h"
 
@@ -29,6 +31,12 @@ using namespace mu::notation;
 
 void UserScoresService::init()
 {
+    m_recentScoreListLoaded.onReceive(this, [this](const LoadedMetaList& loaded) {
+        if (loaded.generation == m_recentScoreListGeneration->load()) {
+            m_recentScoreList.set(loaded.metaList);
+        }
+    }, Asyncable::AsyncMode::AsyncSetRepeat);
+
     updateRecentScoreList();
 
     configuration()->recentScorePaths().ch.onReceive(this, [this](const io::paths&) {
@@ -39,8 +47,23 @@ void UserScoresService::init()
 void UserScoresService::updateRecentScoreList()
 {
     io::paths paths = configuration()->recentScorePaths().val;
-    MetaList metaList = msczMetaReader()->readMetaList(paths);
-    m_recentScoreList.set(metaList);
+    std::shared_ptr<IMsczMetaReader> reader = msczMetaReader();
+    async::Channel<LoadedMetaList> loaded = m_recentScoreListLoaded;
+    std::shared_ptr<std::atomic<uint64_t> > latestGeneration = m_recentScoreListGeneration;
+    uint64_t generation = ++(*latestGeneration);
+
+    //! NOTE The files are read in the background, the list is set when they are ready.
+    //! A newer update supersedes this one, then its files aren't read
+    QtConcurrent::run([paths, reader, loaded, latestGeneration, generation]() mutable {
+        if (generation != latestGeneration->load()) {
+            return;
+        }
+
+        MetaList metaList = reader->readMetaList(paths);
+        if (generation == latestGeneration->load()) {
+            loaded.send({ generation, std::move(metaList) });
+        }
+    });
 }
 
 mu::ValCh<MetaList> UserScoresService::recentScoreList() const
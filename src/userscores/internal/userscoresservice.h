@@ -22,6 +22,9 @@
 #ifndef MU_USERSCORES_USERSCORESSERVICE_H
 #define MU_USERSCORES_USERSCORESSERVICE_H
 
+#include <atomic>
+#include <memory>
+
 #include "iuserscoresservice.h"
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -42,7 +45,16 @@ public:
 private:
     void updateRecentScoreList();
 
+    struct LoadedMetaList {
+        uint64_t generation = 0;
+        notation::MetaList metaList;
+    };
+
     ValCh<notation::MetaList> m_recentScoreList;
+    async::Channel<LoadedMetaList> m_recentScoreListLoaded;
+
+    //! NOTE Updates may finish out of order, only the list of the latest one is set
+    std::shared_ptr<std::atomic<uint64_t> > m_recentScoreListGeneration = std::make_shared<std::atomic<uint64_t> >(0);
 };
 }
 
@@ -30,17 +30,17 @@ ScoreThumbnail::ScoreThumbnail(QQuickItem* parent)
 {
 }
 
-void ScoreThumbnail::setThumbnail(QVariant pixmap)
+void ScoreThumbnail::setThumbnail(QVariant image)
 {
-    if (pixmap.isNull()) {
+    if (image.isNull()) {
         return;
     }
 
-    m_thumbnail = pixmap.value<QPixmap>();
+    m_thumbnail = image.value<QImage>();
     update();
 }
 
 void ScoreThumbnail::paint(QPainter* painter)
 {
-    painter->drawPixmap(0, 0, width(), height(), m_thumbnail);
+    painter->drawImage(QRectF(0, 0, width(), height()), m_thumbnail);
 }
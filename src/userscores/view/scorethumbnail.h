@@ -33,13 +33,13 @@ class ScoreThumbnail : public QQuickPaintedItem
 public:
     ScoreThumbnail(QQuickItem* parent = nullptr);
 
-    Q_INVOKABLE void setThumbnail(QVariant pixmap);
+    Q_INVOKABLE void setThumbnail(QVariant image);
 
 protected:
     virtual void paint(QPainter* painter) override;
 
 private:
-    QPixmap m_thumbnail;
+    QImage m_thumbnail;
 };
 }
 
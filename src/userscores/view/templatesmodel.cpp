@@ -33,12 +33,26 @@ TemplatesModel::TemplatesModel(QObject* parent)
 
 void TemplatesModel::load()
 {
-    RetVal<Templates> templates = repository()->templates();
-    if (!templates.ret) {
-        LOGE() << templates.ret.toString();
-    }
+    uint64_t generation = ++m_loadGeneration;
+
+    //! NOTE Overlapping loads may finish out of order, only the latest one sets the templates
+    async::Channel<Templates> loaded;
+    loaded.onReceive(this, [this, generation](const Templates& templates) {
+        if (generation == m_loadGeneration) {
+            setTemplates(templates);
+        }
+    });
+
+    repository()->templatesAsync(loaded);
+}
+
+void TemplatesModel::setTemplates(const Templates& templates)
+{
+    m_allTemplates.clear();
+    m_visibleCategoriesTitles.clear();
+    m_currentCategoryIndex = 0;
 
-    for (const Template& templ : templates.val) {
+    for (const Template& templ : templates) {
         if (!templ.title.isEmpty()) {
             m_allTemplates << templ;
         }
@@ -94,6 +108,12 @@ void TemplatesModel::updateTemplatesByCategory()
     m_visibleTemplates.clear();
     m_currentTemplateIndex = 0;
 
+    if (m_visibleCategoriesTitles.isEmpty()) {
+        emit templatesChanged();
+        emit currentTemplateChanged();
+        return;
+    }
+
     QString currentCategoryTitle = categoriesTitles()[m_currentCategoryIndex];
 
     for (const Template& templ: m_allTemplates) {
@@ -23,10 +23,11 @@
 #define MU_USERSCORES_TEMPLATESMODEL_H
 
 #include "modularity/ioc.h"
+#include "async/asyncable.h"
 #include "internal/itemplatesrepository.h"
 
 namespace mu::userscores {
-class TemplatesModel : public QObject
+class TemplatesModel : public QObject, public async::Asyncable
 {
     Q_OBJECT
 
@@ -57,6 +58,7 @@ signals:
     void currentTemplateChanged();
 
 private:
+    void setTemplates(const Templates& templates);
     void updateTemplatesByCategory();
     void updateTemplatesAndCategoriesBySearch();
 
@@ -70,6 +72,8 @@ private:
 
     int m_currentCategoryIndex = 0;
     int m_currentTemplateIndex = 0;
+
+    uint64_t m_loadGeneration = 0;
 };
 }
 
@@ -39,10 +39,13 @@
 
 #ifndef QT_NO_TEXTODFWRITER
 
+#include <QBuffer>
 #include <QDir>
 #include <QDebug>
 #include <QFileInfo>
 
+#include <limits>
+
 #include "qzipreader_p.h"
 #include "qzipwriter_p.h"
 
@@ -965,6 +968,224 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
     return MQZipReader::FileInfo();
 }
 
+/*
+    Sequential read-only access to one entry of a zip archive.
+    Deflated data is inflated in chunks while it is read, so the
+    whole entry is never held in memory. When \a mappedData is
+    given, the compressed data is read from it directly instead
+    of the source device.
+*/
+class MQZipEntryDevice : public QIODevice
+{
+public:
+    MQZipEntryDevice(QIODevice* source, const char* mappedData, qint64 dataStart,
+                     qint64 compressedSize, qint64 uncompressedSize, bool deflated)
+        : m_source(source), m_mappedData(mappedData), m_dataStart(dataStart),
+        m_compressedSize(compressedSize), m_uncompressedSize(uncompressedSize), m_deflated(deflated)
+    {
+        if (m_deflated) {
+            m_stream.zalloc = (alloc_func)0;
+            m_stream.zfree = (free_func)0;
+            m_stream.opaque = (voidpf)0;
+            m_stream.next_in = Z_NULL;
+            m_stream.avail_in = 0;
+            if (inflateInit2(&m_stream, -MAX_WBITS) != Z_OK) {
+                qWarning("QZip: cannot initialize inflate");
+                return;
+            }
+            m_streamInitialized = true;
+        }
+        open(QIODevice::ReadOnly);
+    }
+
+    ~MQZipEntryDevice() override
+    {
+        if (m_streamInitialized) {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    bool isSequential() const override { return true; }
+    qint64 size() const override { return m_uncompressedSize; }
+    qint64 bytesAvailable() const override
+    {
+        return QIODevice::bytesAvailable() + qMax(qint64(0), m_uncompressedSize - m_produced);
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+        qint64 n = m_deflated ? readDeflated(data, maxSize) : readStored(data, maxSize);
+        if (n > 0) {
+            m_produced += n;
+        }
+        return n;
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    static constexpr qint64 CHUNK_SIZE = 64 * 1024;
+
+    qint64 readCompressed(char* data, qint64 maxSize)
+    {
+        qint64 n = qMin(maxSize, m_compressedSize - m_inPos);
+        if (n <= 0) {
+            return 0;
+        }
+        if (m_mappedData) {
+            memcpy(data, m_mappedData + m_inPos, size_t(n));
+        } else {
+            if (!m_source->seek(m_dataStart + m_inPos)) {
+                return -1;
+            }
+            n = m_source->read(data, n);
+            if (n < 0) {
+                return -1;
+            }
+        }
+        m_inPos += n;
+        return n;
+    }
+
+    qint64 readStored(char* data, qint64 maxSize)
+    {
+        return readCompressed(data, qMin(maxSize, m_uncompressedSize - m_produced));
+    }
+
+    qint64 readDeflated(char* data, qint64 maxSize)
+    {
+        if (!m_streamInitialized || m_streamEnd) {
+            return m_streamInitialized ? 0 : -1;
+        }
+
+        m_stream.next_out = reinterpret_cast<Bytef*>(data);
+        m_stream.avail_out = uInt(qMin(maxSize, qint64(std::numeric_limits<uInt>::max())));
+        const uInt requested = m_stream.avail_out;
+
+        while (m_stream.avail_out > 0) {
+            if (m_stream.avail_in == 0) {
+                if (m_mappedData) {
+                    // the whole compressed entry is already in memory
+                    qint64 n = m_compressedSize - m_inPos;
+                    m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(m_mappedData + m_inPos));
+                    m_stream.avail_in = uInt(qMin(n, qint64(std::numeric_limits<uInt>::max())));
+                    m_inPos += m_stream.avail_in;
+                } else {
+                    m_inBuffer.resize(int(CHUNK_SIZE));
+                    qint64 n = readCompressed(m_inBuffer.data(), CHUNK_SIZE);
+                    if (n < 0) {
+                        setErrorString(QStringLiteral("QZip: cannot read compressed data"));
+                        return -1;
+                    }
+                    m_stream.next_in = reinterpret_cast<Bytef*>(m_inBuffer.data());
+                    m_stream.avail_in = uInt(n);
+                }
+                if (m_stream.avail_in == 0) {
+                    break;             // truncated entry
+                }
+            }
+
+            int res = ::inflate(&m_stream, Z_NO_FLUSH);
+            if (res == Z_STREAM_END) {
+                m_streamEnd = true;
+                break;
+            }
+            if (res != Z_OK) {
+                qWarning("QZip: inflate error %d: Input data is corrupted", res);
+                setErrorString(QStringLiteral("QZip: Input data is corrupted"));
+                m_streamEnd = true;
+                const qint64 produced = requested - m_stream.avail_out;
+                return produced > 0 ? produced : -1;
+            }
+        }
+        return requested - m_stream.avail_out;
+    }
+
+    QIODevice* m_source = nullptr;
+    const char* m_mappedData = nullptr;
+    qint64 m_dataStart = 0;
+    qint64 m_compressedSize = 0;
+    qint64 m_uncompressedSize = 0;
+    bool m_deflated = false;
+
+    qint64 m_inPos = 0;
+    qint64 m_produced = 0;
+    QByteArray m_inBuffer;
+    z_stream m_stream;
+    bool m_streamInitialized = false;
+    bool m_streamEnd = false;
+};
+
+/*!
+    Returns a sequential read-only device with the uncompressed contents of
+    \a fileName, or nullptr if there is no such file or its compression
+    method is not supported. Deflated data is inflated while it is read.
+
+    If the archive device is a QBuffer, e.g. over a memory mapped file, the
+    entry is read straight from the buffer data without copying it.
+
+    The caller takes ownership of the returned device, which must not
+    outlive this reader and its device.
+*/
+QIODevice* MQZipReader::fileDevice(const QString& fileName) const
+{
+    d->scanFiles();
+    int i;
+    for (i = 0; i < d->fileHeaders.size(); ++i) {
+        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName) {
+            break;
+        }
+    }
+    if (i == d->fileHeaders.size()) {
+        return nullptr;
+    }
+
+    const FileHeader& header = d->fileHeaders.at(i);
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return nullptr;
+    }
+
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return nullptr;
+    }
+
+    qint64 compressed_size = readUInt(header.h.compressed_size);
+    qint64 uncompressed_size = readUInt(header.h.uncompressed_size);
+    qint64 start = readUInt(header.h.offset_local_header);
+
+    d->device->seek(start);
+    LocalFileHeader lh;
+    if (d->device->read((char*)&lh, sizeof(LocalFileHeader)) != qint64(sizeof(LocalFileHeader))) {
+        return nullptr;
+    }
+    qint64 dataStart = start + sizeof(LocalFileHeader)
+                       + readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+
+    int compression_method = readUShort(lh.compression_method);
+    if (compression_method != CompressionMethodStored && compression_method != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return nullptr;
+    }
+
+    const char* mappedData = nullptr;
+    if (QBuffer* buffer = qobject_cast<QBuffer*>(d->device)) {
+        const QByteArray& data = buffer->data();
+        if (dataStart + compressed_size > data.size()) {
+            return nullptr;
+        }
+        mappedData = data.constData() + dataStart;
+    }
+
+    return new MQZipEntryDevice(d->device, mappedData, dataStart, compressed_size, uncompressed_size,
+                                compression_method == CompressionMethodDeflated);
+}
+
 /*!
     Fetch the file contents from the zip archive and return the uncompressed bytes.
 */